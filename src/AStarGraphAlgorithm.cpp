@@ -0,0 +1,134 @@
+#include "AStarGraphAlgorithm.hpp"
+#include "PathGraph.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+static constexpr std::uint64_t infinite_distance = std::numeric_limits<std::uint64_t>::max();
+
+bool AStarGraphAlgorithm::OpenEntry::operator>(const OpenEntry& other) const {
+    if (estimate != other.estimate) {
+        return estimate > other.estimate;
+    }
+    if (heuristic != other.heuristic) {
+        return heuristic > other.heuristic;
+    }
+    return node > other.node;
+}
+
+AStarGraphAlgorithm::AStarGraphAlgorithm(PathGraph&& graph)
+    :   m_graph(std::move(graph)),
+        m_heuristic(m_graph.getTopology(), m_graph.end_node),
+        m_distance(m_graph.node_count, infinite_distance),
+        m_entered_by(m_graph.node_count),
+        m_first_step(true),
+        m_found_end(false) {}
+
+void AStarGraphAlgorithm::setNodeState(std::size_t node, PathNodeState state) {
+    m_graph.node_states[node] = state;
+    if (m_event_sink) {
+        m_event_sink->onStepEvent(StepEvent::nodeState(node, state));
+    }
+}
+
+void AStarGraphAlgorithm::setEdgeState(std::size_t edge, PathEdgeState state) {
+    m_graph.edge_states[edge] = state;
+    if (m_event_sink) {
+        m_event_sink->onStepEvent(StepEvent::edgeState(edge, state));
+    }
+}
+
+void AStarGraphAlgorithm::markShortestPath() {
+    auto& topology = m_graph.getTopology();
+    auto node_index = m_graph.end_node;
+
+    while (node_index != m_graph.start_node) {
+        auto edge_index = m_entered_by[node_index];
+        setEdgeState(edge_index, PathEdgeState::OnShortestPath);
+        node_index = topology.edges[edge_index].from_node_index;
+        if (node_index != m_graph.start_node) {
+            setNodeState(node_index, PathNodeState::OnShortestPath);
+        }
+    }
+}
+
+bool AStarGraphAlgorithm::nextStep() {
+    // Lets the renderer draw the initial state of graph
+    if (m_first_step) {
+        auto heuristic = m_heuristic(m_graph.start_node);
+        m_distance[m_graph.start_node] = 0;
+        m_open_list.push_back({heuristic, heuristic, m_graph.start_node});
+        m_first_step = false;
+        return true;
+    }
+
+    if (m_found_end) {
+        return false;
+    }
+
+    // Skip entries of nodes which were closed or pushed again with a shorter distance
+    OpenEntry entry;
+    do {
+        // We are finished
+        if (m_open_list.empty()) {
+            return false;
+        }
+        std::pop_heap(m_open_list.begin(), m_open_list.end(), std::greater<OpenEntry>());
+        entry = m_open_list.back();
+        m_open_list.pop_back();
+    } while (m_graph.node_states[entry.node] == PathNodeState::Visited
+        || entry.estimate - entry.heuristic != m_distance[entry.node]);
+
+    auto& topology = m_graph.getTopology();
+    auto node_index = entry.node;
+    auto distance = m_distance[node_index];
+    setNodeState(node_index, PathNodeState::Visited);
+    if (node_index != m_graph.start_node) {
+        setEdgeState(m_entered_by[node_index], PathEdgeState::Used);
+    }
+
+    // We found the end node
+    if (node_index == m_graph.end_node) {
+        if (node_index == m_graph.start_node) {
+            setNodeState(node_index, PathNodeState::OnShortestPath);
+        }
+        markShortestPath();
+        m_found_end = true;
+        return true;
+    }
+
+    // Else we relax the edges to the neighbours which are not closed yet
+    for (auto edge_index : topology.getOutgoingEdges(node_index)) {
+        auto neighbour_index = topology.edges[edge_index].to_node_index;
+        auto new_distance = distance + topology.edge_weights[edge_index];
+
+        if (m_graph.node_states[neighbour_index] == PathNodeState::Visited || new_distance >= m_distance[neighbour_index]) {
+            continue;
+        }
+
+        // The neighbour was opened before over a longer path
+        if (m_graph.node_states[neighbour_index] == PathNodeState::Found) {
+            setEdgeState(m_entered_by[neighbour_index], PathEdgeState::Default);
+        }
+        setEdgeState(edge_index, PathEdgeState::Peeked);
+        setNodeState(neighbour_index, PathNodeState::Found);
+        m_distance[neighbour_index] = new_distance;
+        m_entered_by[neighbour_index] = edge_index;
+
+        auto heuristic = m_heuristic(neighbour_index);
+        m_open_list.push_back({new_distance + heuristic, heuristic, neighbour_index});
+        std::push_heap(m_open_list.begin(), m_open_list.end(), std::greater<OpenEntry>());
+    }
+
+    return true;
+}
+
+bool AStarGraphAlgorithm::setEventSink(StepEventSink* sink) {
+    m_event_sink = sink;
+    return true;
+}
+
+const Graph& AStarGraphAlgorithm::getState() const {
+    return m_graph;
+}
@@ -0,0 +1,85 @@
+#ifndef AStarGraphAlgorithm_hpp
+#define AStarGraphAlgorithm_hpp
+
+#include "GraphAlgorithm.hpp"
+#include "GridDistanceHeuristic.hpp"
+#include "PathGraph.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Class for the A* algorithm finding the shortest path in a graph with weighted edges.
+ *
+ * The heuristic is the consistent grid distance to the end node (GridDistanceHeuristic),
+ * so no node has to be expanded twice. Among nodes with the same estimate
+ * the one closest to the end node is expanded first, then the one with the lowest index.
+ */
+class AStarGraphAlgorithm : public GraphAlgorithm {
+    // Entry of the open list, outdated entries are skipped when popped
+    struct OpenEntry {
+        std::uint64_t estimate; // Distance from the start node plus the heuristic
+        std::uint64_t heuristic;
+        std::size_t node;
+
+        bool operator>(const OpenEntry& other) const;
+    };
+
+    PathGraph m_graph;
+    StepEventSink* m_event_sink = nullptr; // Receives the changes of the graph, if set
+    GridDistanceHeuristic m_heuristic; // Lower bound of the distance to the end node
+    std::vector<OpenEntry> m_open_list; // Binary min-heap of open (found) nodes
+    std::vector<std::uint64_t> m_distance; // Tentative distance of each node from the start node
+    std::vector<std::size_t> m_entered_by; // Index of the edge each node was entered by
+    bool m_first_step;
+    bool m_found_end;
+
+    /**
+     * Backtracks from the end node and marks the nodes and edges on the shortest path.
+     */
+    void markShortestPath();
+
+    /**
+     * Changes the state of the node and reports it to the event sink.
+     */
+    void setNodeState(std::size_t node, PathNodeState state);
+
+    /**
+     * Changes the state of the edge and reports it to the event sink.
+     */
+    void setEdgeState(std::size_t edge, PathEdgeState state);
+
+public:
+    /**
+     * Constructor for AStarGraphAlgorithm.
+     *
+     * @param graph The graph in which the shortest path is found.
+     */
+    AStarGraphAlgorithm(PathGraph&& graph);
+
+    /**
+     * Executes the next step of the A* algorithm.
+     *
+     * Every step expands the open node with the lowest estimate. Open nodes are shown as found
+     * and closed nodes as visited.
+     *
+     * @return True if there are more steps to be taken, false otherwise.
+     */
+    virtual bool nextStep() override;
+
+    /**
+     * Sets the sink receiving the changes of the states of the nodes and edges.
+     *
+     * @return Always true.
+     */
+    virtual bool setEventSink(StepEventSink* sink) override;
+
+    /**
+     * Returns the current state of the graph.
+     *
+     * @return A constant reference to the current state of the graph.
+     */
+    virtual const Graph& getState() const override;
+};
+
+#endif
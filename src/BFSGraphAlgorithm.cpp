@@ -1,69 +1,95 @@
-
 #include "BFSGraphAlgorithm.hpp"
 #include "PathGraph.hpp"
 
+#include <queue>
+#include <vector>
+
 BFSGraphAlgorithm::BFSGraphAlgorithm(PathGraph&& graph) 
-    : m_graph(std::move(graph)), m_unvisited_node_queue(), m_first_step(true), m_found_end(false) {}
+    :   m_graph(std::move(graph)) {}
 
-bool BFSGraphAlgorithm::nextStep() {
-    // Lets the renderer draw the initial state of graph
-    if (m_first_step) {
-        m_unvisited_node_queue.push(m_graph.start_node);
-        m_first_step = false;
-        return true;
+void BFSGraphAlgorithm::setNodeState(std::size_t node, PathNodeState state) {
+    m_graph.node_states[node] = state;
+    if (m_event_sink) {
+        m_event_sink->onStepEvent(StepEvent::nodeState(node, state));
     }
+}
 
-    // We are finished
-    if (m_unvisited_node_queue.empty() || m_found_end) {
-        return false;
+void BFSGraphAlgorithm::setEdgeState(std::size_t edge, PathEdgeState state) {
+    m_graph.edge_states[edge] = state;
+    if (m_event_sink) {
+        m_event_sink->onStepEvent(StepEvent::edgeState(edge, state));
     }
+}
 
-    auto node_index = m_unvisited_node_queue.front();
-    m_unvisited_node_queue.pop();
+Generator<Graph> BFSGraphAlgorithm::steps() {
+    auto& topology = m_graph.getTopology();
+    std::queue<std::size_t> unvisited_node_queue;
+    std::vector<std::size_t> entered_by(m_graph.node_count); // Index of the edge each node was entered by
+    std::size_t level_left = 1; // Number of nodes of the current level still in the queue
 
-    auto& node = m_graph.nodes[node_index];
-    node.state = PathNodeState::Visited;
-    if (!node.is_start_node) {
-        m_graph.edges[node.entered_by].state = PathEdgeState::Used;
-    }
+    // Lets the renderer draw the initial state of graph
+    unvisited_node_queue.push(m_graph.start_node);
+    m_ends_phase = true;
+    co_yield m_graph;
+
+    while (!unvisited_node_queue.empty()) {
+        auto node_index = unvisited_node_queue.front();
+        unvisited_node_queue.pop();
 
-    // We found the end node
-    if (node.is_end_node) {
-        if (node.is_start_node) {
-            node.state = PathNodeState::OnShortestPath;
-            m_found_end = true;
-            return true;
-        } 
-
-        // Backtrack and mark the nodes and edges on the shortest path
-        auto i = node.entered_by;
-        while(m_graph.nodes[m_graph.edges[i].from_node_index].is_start_node != true) {
-            m_graph.edges[i].state = PathEdgeState::OnShortestPath;
-            auto& node = m_graph.nodes[m_graph.edges[i].from_node_index];
-            node.state = PathNodeState::OnShortestPath;
-            i = node.entered_by;
+        // The queue holds just the next level after the last node of this one
+        m_ends_phase = --level_left == 0;
+
+        setNodeState(node_index, PathNodeState::Visited);
+        if (node_index != m_graph.start_node) {
+            setEdgeState(entered_by[node_index], PathEdgeState::Used);
         }
-        m_graph.edges[i].state = PathEdgeState::OnShortestPath;
-        m_found_end = true;
-        return true;
-    }
 
-    // Else we go throgh the neighbours and add them to queue
-    for (auto edge_index : node.edges) {
-        auto& edge = m_graph.edges[edge_index];
+        // We found the end node
+        if (node_index == m_graph.end_node) {
+            if (node_index == m_graph.start_node) {
+                setNodeState(node_index, PathNodeState::OnShortestPath);
+                co_yield m_graph;
+                co_return;
+            }
+
+            // Backtrack and mark the nodes and edges on the shortest path
+            auto i = entered_by[node_index];
+            while(topology.edges[i].from_node_index != m_graph.start_node) {
+                setEdgeState(i, PathEdgeState::OnShortestPath);
+                auto from_index = topology.edges[i].from_node_index;
+                setNodeState(from_index, PathNodeState::OnShortestPath);
+                i = entered_by[from_index];
+            }
+            setEdgeState(i, PathEdgeState::OnShortestPath);
+            co_yield m_graph;
+            co_return;
+        }
 
-        auto neighbour_index = edge.to_node_index;
-        auto& neighbour = m_graph.nodes[neighbour_index];
+        // Else we go throgh the neighbours and add them to queue
+        for (auto edge_index : topology.getOutgoingEdges(node_index)) {
+            auto neighbour_index = topology.edges[edge_index].to_node_index;
 
-        if (neighbour.state == PathNodeState::NotFound) {
-            edge.state = PathEdgeState::Peeked;
+            if (m_graph.node_states[neighbour_index] == PathNodeState::NotFound) {
+                setEdgeState(edge_index, PathEdgeState::Peeked);
 
-            m_unvisited_node_queue.push(neighbour_index);
-            neighbour.state = PathNodeState::Found;
-            neighbour.entered_by = edge_index;
+                unvisited_node_queue.push(neighbour_index);
+                setNodeState(neighbour_index, PathNodeState::Found);
+                entered_by[neighbour_index] = edge_index;
+            }
         }
+        if (m_ends_phase) {
+            level_left = unvisited_node_queue.size();
+        }
+        co_yield m_graph;
     }
+}
+
+bool BFSGraphAlgorithm::endsPhase() const {
+    return m_ends_phase;
+}
 
+bool BFSGraphAlgorithm::setEventSink(StepEventSink* sink) {
+    m_event_sink = sink;
     return true;
 }
 
@@ -1,16 +1,24 @@
 #ifndef BFSGraphAlgorithm_hpp
 #define BFSGraphAlgorithm_hpp
 
-#include "GraphAlgorithm.hpp"
+#include "CoroutineGraphAlgorithm.hpp"
 #include "PathGraph.hpp"
-#include <queue>
 
 // Class for Breadth-First Search (BFS) algorithm in a graph
-class BFSGraphAlgorithm : public GraphAlgorithm {
+class BFSGraphAlgorithm : public CoroutineGraphAlgorithm {
     PathGraph m_graph;
-    std::queue<std::size_t> m_unvisited_node_queue; 
-    bool m_first_step;
-    bool m_found_end;
+    StepEventSink* m_event_sink = nullptr; // Receives the changes of the graph, if set
+    bool m_ends_phase = true; // True if the last step visited the last node of a level
+
+    /**
+     * Changes the state of the node and reports it to the event sink.
+     */
+    void setNodeState(std::size_t node, PathNodeState state);
+
+    /**
+     * Changes the state of the edge and reports it to the event sink.
+     */
+    void setEdgeState(std::size_t edge, PathEdgeState state);
 
 public:
     /**
@@ -21,11 +29,23 @@ public:
     BFSGraphAlgorithm(PathGraph&& graph);
 
     /**
-     * Executes the next step of the BFS algorithm.
+     * Runs the BFS algorithm, every visit of a node is one step.
+     *
+     * @return Generator of the graph after every step, starting with the initial state.
+     */
+    virtual Generator<Graph> steps() override;
+
+    /**
+     * Returns true if the last step visited the last node of a level, or it is the initial state.
+     */
+    virtual bool endsPhase() const override;
+
+    /**
+     * Sets the sink receiving the changes of the states of the nodes and edges.
      *
-     * @return True if there are more steps to be taken, false otherwise.
+     * @return Always true.
      */
-    virtual bool nextStep() override;
+    virtual bool setEventSink(StepEventSink* sink) override;
 
     /**
      * Returns the current state of the graph.
@@ -35,4 +55,4 @@ public:
     virtual const Graph& getState() const override;
 };
 
-#endif
\ No newline at end of file
+#endif
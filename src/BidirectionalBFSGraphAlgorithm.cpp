@@ -0,0 +1,137 @@
+#include "BidirectionalBFSGraphAlgorithm.hpp"
+#include "PathGraph.hpp"
+
+#include <limits>
+
+static constexpr std::size_t unreached = std::numeric_limits<std::size_t>::max();
+
+BidirectionalBFSGraphAlgorithm::BidirectionalBFSGraphAlgorithm(PathGraph&& graph)
+    :   m_graph(std::move(graph)),
+        m_expanding_forward(true),
+        m_best_length(unreached),
+        m_meeting_edge(0),
+        m_first_step(true),
+        m_finished(false) {
+
+    for (auto search : {&m_forward, &m_backward}) {
+        search->distance.assign(m_graph.node_count, unreached);
+        search->entered_by.assign(m_graph.node_count, 0);
+        search->level_remaining = 0;
+    }
+}
+
+void BidirectionalBFSGraphAlgorithm::expand(std::size_t node, bool forward) {
+    auto& topology = m_graph.getTopology();
+    auto& search = forward ? m_forward : m_backward;
+    auto& other_search = forward ? m_backward : m_forward;
+
+    if (node != m_graph.start_node && node != m_graph.end_node) {
+        m_graph.node_states[node] = forward ? PathNodeState::Visited : PathNodeState::VisitedBackward;
+        m_graph.edge_states[search.entered_by[node]] = PathEdgeState::Used;
+    }
+
+    auto edge_indices = forward ? topology.getOutgoingEdges(node) : topology.getIncomingEdges(node);
+    for (auto edge_index : edge_indices) {
+        auto& edge = topology.edges[edge_index];
+        auto neighbour_index = forward ? edge.to_node_index : edge.from_node_index;
+
+        // The frontiers meet, remember the shortest connection
+        if (other_search.distance[neighbour_index] != unreached) {
+            auto length = search.distance[node] + 1 + other_search.distance[neighbour_index];
+            if (length < m_best_length) {
+                m_best_length = length;
+                m_meeting_edge = edge_index;
+            }
+            continue;
+        }
+
+        if (search.distance[neighbour_index] == unreached) {
+            m_graph.edge_states[edge_index] = PathEdgeState::Peeked;
+            m_graph.node_states[neighbour_index] = forward ? PathNodeState::Found : PathNodeState::FoundBackward;
+
+            search.queue.push(neighbour_index);
+            search.distance[neighbour_index] = search.distance[node] + 1;
+            search.entered_by[neighbour_index] = edge_index;
+        }
+    }
+}
+
+bool BidirectionalBFSGraphAlgorithm::startNextLevel() {
+    if (m_forward.queue.empty() || m_backward.queue.empty()) {
+        return false;
+    }
+    m_expanding_forward = m_forward.queue.size() <= m_backward.queue.size();
+    auto& search = m_expanding_forward ? m_forward : m_backward;
+    search.level_remaining = search.queue.size();
+    return true;
+}
+
+void BidirectionalBFSGraphAlgorithm::markShortestPath() {
+    auto& topology = m_graph.getTopology();
+    m_graph.edge_states[m_meeting_edge] = PathEdgeState::OnShortestPath;
+
+    // Half from the meeting edge back to the start node
+    auto node_index = topology.edges[m_meeting_edge].from_node_index;
+    while (node_index != m_graph.start_node) {
+        m_graph.node_states[node_index] = PathNodeState::OnShortestPath;
+        auto edge_index = m_forward.entered_by[node_index];
+        m_graph.edge_states[edge_index] = PathEdgeState::OnShortestPath;
+        node_index = topology.edges[edge_index].from_node_index;
+    }
+
+    // Half from the meeting edge to the end node
+    node_index = topology.edges[m_meeting_edge].to_node_index;
+    while (node_index != m_graph.end_node) {
+        m_graph.node_states[node_index] = PathNodeState::OnShortestPath;
+        auto edge_index = m_backward.entered_by[node_index];
+        m_graph.edge_states[edge_index] = PathEdgeState::OnShortestPath;
+        node_index = topology.edges[edge_index].to_node_index;
+    }
+}
+
+bool BidirectionalBFSGraphAlgorithm::nextStep() {
+    // Lets the renderer draw the initial state of graph
+    if (m_first_step) {
+        m_first_step = false;
+        if (m_graph.start_node == m_graph.end_node) {
+            m_graph.node_states[m_graph.start_node] = PathNodeState::OnShortestPath;
+            m_finished = true;
+            return true;
+        }
+
+        m_forward.queue.push(m_graph.start_node);
+        m_forward.distance[m_graph.start_node] = 0;
+        m_backward.queue.push(m_graph.end_node);
+        m_backward.distance[m_graph.end_node] = 0;
+        startNextLevel();
+        return true;
+    }
+
+    // We are finished
+    if (m_finished) {
+        return false;
+    }
+
+    auto& search = m_expanding_forward ? m_forward : m_backward;
+    auto node_index = search.queue.front();
+    search.queue.pop();
+    search.level_remaining--;
+    expand(node_index, m_expanding_forward);
+
+    if (search.level_remaining == 0) {
+        // The whole level is expanded, so the best connection found in it is the shortest path
+        if (m_best_length != unreached) {
+            markShortestPath();
+            m_finished = true;
+            return true;
+        }
+        if (!startNextLevel()) {
+            m_finished = true;
+        }
+    }
+    return true;
+}
+
+const Graph& BidirectionalBFSGraphAlgorithm::getState() const {
+    return m_graph;
+}
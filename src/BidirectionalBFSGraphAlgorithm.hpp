@@ -0,0 +1,81 @@
+#ifndef BidirectionalBFSGraphAlgorithm_hpp
+#define BidirectionalBFSGraphAlgorithm_hpp
+
+#include "GraphAlgorithm.hpp"
+#include "PathGraph.hpp"
+#include <cstddef>
+#include <queue>
+#include <vector>
+
+/**
+ * Class for bidirectional Breadth-First Search (BFS) in a graph.
+ *
+ * One search runs from the start node over outgoing edges and one from the end node over incoming edges.
+ * Always a whole level of the side with the smaller frontier is expanded. Once the frontiers meet, the level
+ * is finished to pick the shortest connection and both halves of the path are backtracked.
+ */
+class BidirectionalBFSGraphAlgorithm : public GraphAlgorithm {
+    // Structure holding the state of the search from one side
+    struct Search {
+        std::queue<std::size_t> queue; // Found but not yet visited nodes
+        std::vector<std::size_t> distance; // Number of edges from the root of the search
+        std::vector<std::size_t> entered_by; // Index of the edge each node was entered by
+        std::size_t level_remaining; // Number of nodes of the current level left in the queue
+    };
+
+    PathGraph m_graph;
+    Search m_forward; // Search from the start node
+    Search m_backward; // Search from the end node
+    bool m_expanding_forward; // True if the current level belongs to the search from the start node
+    std::size_t m_best_length; // Length of the shortest connection of the frontiers found so far
+    std::size_t m_meeting_edge; // Index of the edge connecting the two halves of the best path
+    bool m_first_step;
+    bool m_finished;
+
+    /**
+     * Visits the node and finds its neighbours in the direction of the search.
+     *
+     * @param node Index of the node.
+     * @param forward True for the search from the start node, false for the search from the end node.
+     */
+    void expand(std::size_t node, bool forward);
+
+    /**
+     * Chooses the side whose next level is expanded, the one with the smaller frontier.
+     *
+     * @return False if one of the frontiers is empty, so there is no path.
+     */
+    bool startNextLevel();
+
+    /**
+     * Backtracks both halves of the best path and marks the nodes and edges on it.
+     */
+    void markShortestPath();
+
+public:
+    /**
+     * Constructor for BidirectionalBFSGraphAlgorithm.
+     *
+     * @param graph The graph to be traversed.
+     */
+    BidirectionalBFSGraphAlgorithm(PathGraph&& graph);
+
+    /**
+     * Executes the next step of the bidirectional BFS algorithm.
+     *
+     * Every step visits one node of the current level of one side. Nodes of the search from the end node
+     * are shown in the backward states.
+     *
+     * @return True if there are more steps to be taken, false otherwise.
+     */
+    virtual bool nextStep() override;
+
+    /**
+     * Returns the current state of the graph.
+     *
+     * @return A constant reference to the current state of the graph.
+     */
+    virtual const Graph& getState() const override;
+};
+
+#endif
@@ -0,0 +1,696 @@
+#include "ContractionHierarchy.hpp"
+#include "PathGraph.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+static constexpr std::uint64_t infinite_distance = std::numeric_limits<std::uint64_t>::max();
+
+// First bytes of every saved hierarchy
+static constexpr char index_magic[] = {'G', 'A', 'V', 'C', 'H', 'I', 'D', 'X'};
+static constexpr std::uint64_t index_version = 1;
+// Fields of the header following the magic: version, node count, fingerprint and arc count
+static constexpr std::size_t header_field_count = 4;
+// Second arc of the saved original edges
+static constexpr std::uint32_t saved_no_arc = std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * Converts the numbers between the native byte order and the little-endian order of the saved hierarchy.
+ */
+template <typename Numbers>
+static void convertLittleEndian(Numbers& numbers) {
+    if constexpr (std::endian::native == std::endian::big) {
+        for (auto& number : numbers) {
+            number = std::byteswap(number);
+        }
+    }
+}
+
+// Witness searches give up after settling this many nodes, a missed witness only adds a needless shortcut
+static constexpr std::size_t witness_settle_limit = 500;
+
+namespace {
+
+// Arc of the remaining graph during the contraction
+struct BuildArc {
+    std::size_t node; // The other end of the arc
+    std::uint64_t weight;
+    std::size_t arc; // Index of the arc in the hierarchy
+};
+
+// Shortcut that replaces a path over a contracted node
+struct Shortcut {
+    std::size_t from_node;
+    std::size_t to_node;
+    std::uint64_t weight;
+    std::size_t first_arc;
+    std::size_t second_arc;
+};
+
+/**
+ * Class holding the remaining graph during the contraction and the workspace of witness searches.
+ */
+class Contractor {
+    std::vector<std::vector<BuildArc>> m_outgoing; // Arcs to the remaining neighbours
+    std::vector<std::vector<BuildArc>> m_incoming; // Arcs from the remaining neighbours
+    std::vector<std::uint64_t> m_distance; // Distances of the witness search
+    std::vector<std::size_t> m_touched; // Nodes with a finite distance in m_distance
+    std::vector<std::pair<std::uint64_t, std::size_t>> m_queue; // Binary min-heap of the witness search
+    std::vector<std::uint64_t> m_target_weight; // Weight of the arc from the node being contracted to each target
+
+    /**
+     * Returns true if the path of the given length from the source of the witness search to the node
+     * is not longer than the path over the node being contracted, so no shortcut to the node is needed.
+     */
+    bool isWitness(std::size_t node, std::uint64_t distance, std::uint64_t incoming_weight) const {
+        return m_target_weight[node] != infinite_distance && distance <= incoming_weight + m_target_weight[node];
+    }
+
+    /**
+     * Runs Dijkstra's algorithm from the node avoiding the contracted node, until every target has a witness
+     * or is settled, or the given distance is reached.
+     *
+     * @param incoming_weight Weight of the arc from the node to the contracted node.
+     */
+    void findWitnesses(std::size_t from_node, std::size_t avoided_node, std::uint64_t incoming_weight,
+        std::uint64_t max_distance, std::size_t target_count) {
+        for (auto node : m_touched) {
+            m_distance[node] = infinite_distance;
+        }
+        m_touched.clear();
+        m_queue.clear();
+
+        m_distance[from_node] = 0;
+        m_touched.push_back(from_node);
+        m_queue.push_back({0, from_node});
+        std::size_t settled = 0;
+        // Targets without a witness, the search stops as soon as there are none
+        auto remaining = target_count;
+        if (isWitness(from_node, 0, incoming_weight)) {
+            --remaining;
+        }
+
+        while (remaining > 0 && !m_queue.empty() && settled < witness_settle_limit) {
+            std::pop_heap(m_queue.begin(), m_queue.end(), std::greater<>());
+            auto [distance, node] = m_queue.back();
+            m_queue.pop_back();
+            if (distance != m_distance[node]) {
+                continue;
+            }
+            if (distance > max_distance) {
+                break;
+            }
+            // A settled target without a witness won't get one
+            if (m_target_weight[node] != infinite_distance && !isWitness(node, distance, incoming_weight)) {
+                --remaining;
+            }
+            ++settled;
+
+            for (auto& arc : m_outgoing[node]) {
+                auto new_distance = distance + arc.weight;
+                if (arc.node == avoided_node || new_distance >= m_distance[arc.node]) {
+                    continue;
+                }
+                if (m_distance[arc.node] == infinite_distance) {
+                    m_touched.push_back(arc.node);
+                }
+                if (!isWitness(arc.node, m_distance[arc.node], incoming_weight)
+                    && isWitness(arc.node, new_distance, incoming_weight)) {
+                    --remaining;
+                }
+                m_distance[arc.node] = new_distance;
+                m_queue.push_back({new_distance, arc.node});
+                std::push_heap(m_queue.begin(), m_queue.end(), std::greater<>());
+            }
+        }
+    }
+
+public:
+    explicit Contractor(std::size_t node_count)
+        :   m_outgoing(node_count),
+            m_incoming(node_count),
+            m_distance(node_count, infinite_distance),
+            m_target_weight(node_count, infinite_distance) {}
+
+    /**
+     * Adds the arc to the remaining graph unless there already is one between the nodes which is not longer.
+     *
+     * @return True if the arc was added.
+     */
+    bool addArc(std::size_t from_node, std::size_t to_node, std::uint64_t weight, std::size_t arc) {
+        auto& outgoing = m_outgoing[from_node];
+        auto existing = std::find_if(outgoing.begin(), outgoing.end(), [&](const BuildArc& build_arc) {
+            return build_arc.node == to_node;
+        });
+        if (existing == outgoing.end()) {
+            outgoing.push_back({to_node, weight, arc});
+            m_incoming[to_node].push_back({from_node, weight, arc});
+            return true;
+        }
+        if (existing->weight <= weight) {
+            return false;
+        }
+
+        *existing = {to_node, weight, arc};
+        for (auto& incoming : m_incoming[to_node]) {
+            if (incoming.node == from_node) {
+                incoming = {from_node, weight, arc};
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Returns the shortcuts needed to contract the node.
+     */
+    std::vector<Shortcut> findShortcuts(std::size_t node) {
+        std::vector<Shortcut> shortcuts;
+        if (m_outgoing[node].empty()) {
+            return shortcuts;
+        }
+        std::uint64_t max_outgoing = 0;
+        for (auto& outgoing : m_outgoing[node]) {
+            max_outgoing = std::max(max_outgoing, outgoing.weight);
+            m_target_weight[outgoing.node] = outgoing.weight;
+        }
+
+        for (auto& incoming : m_incoming[node]) {
+            findWitnesses(incoming.node, node, incoming.weight, incoming.weight + max_outgoing, m_outgoing[node].size());
+            for (auto& outgoing : m_outgoing[node]) {
+                auto weight = incoming.weight + outgoing.weight;
+                if (outgoing.node != incoming.node && m_distance[outgoing.node] > weight) {
+                    shortcuts.push_back({incoming.node, outgoing.node, weight, incoming.arc, outgoing.arc});
+                }
+            }
+        }
+
+        for (auto& outgoing : m_outgoing[node]) {
+            m_target_weight[outgoing.node] = infinite_distance;
+        }
+        return shortcuts;
+    }
+
+    /**
+     * Returns the edge difference of contracting the node, the number of shortcuts minus the number of removed arcs.
+     */
+    std::int64_t getEdgeDifference(std::size_t node, const std::vector<Shortcut>& shortcuts) const {
+        auto removed = m_incoming[node].size() + m_outgoing[node].size();
+        return static_cast<std::int64_t>(shortcuts.size()) - static_cast<std::int64_t>(removed);
+    }
+
+    /**
+     * Removes the node from the remaining graph.
+     *
+     * @return The remaining neighbours of the node.
+     */
+    std::vector<std::size_t> removeNode(std::size_t node) {
+        std::vector<std::size_t> neighbours;
+        auto is_node = [node](const BuildArc& arc) {
+            return arc.node == node;
+        };
+
+        for (auto& incoming : m_incoming[node]) {
+            std::erase_if(m_outgoing[incoming.node], is_node);
+            neighbours.push_back(incoming.node);
+        }
+        for (auto& outgoing : m_outgoing[node]) {
+            std::erase_if(m_incoming[outgoing.node], is_node);
+            neighbours.push_back(outgoing.node);
+        }
+        m_incoming[node].clear();
+        m_outgoing[node].clear();
+
+        std::sort(neighbours.begin(), neighbours.end());
+        neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+        return neighbours;
+    }
+};
+
+}
+
+ContractionHierarchy::ContractionHierarchy(std::size_t node_count, std::uint64_t fingerprint)
+    :   m_node_count(node_count),
+        m_fingerprint(fingerprint),
+        m_rank(node_count, 0) {}
+
+ContractionHierarchy ContractionHierarchy::build(const PathGraphTopology& topology) {
+    ContractionHierarchy hierarchy(topology.node_count, getFingerprint(topology));
+    Contractor contractor(topology.node_count);
+
+    for (std::size_t i = 0; i < topology.edge_count; ++i) {
+        auto& edge = topology.edges[i];
+        if (edge.from_node_index == edge.to_node_index) {
+            continue;
+        }
+        auto weight = topology.edge_weights[i];
+        if (contractor.addArc(edge.from_node_index, edge.to_node_index, weight, hierarchy.m_arcs.size())) {
+            hierarchy.m_arcs.push_back({edge.from_node_index, edge.to_node_index, weight, i, no_arc, no_arc});
+        }
+    }
+
+    // Priority of a node is its edge difference plus the number of its contracted neighbours and its depth
+    // in the hierarchy, which spreads the contraction evenly over the graph. Contracting a node raises the
+    // priorities of its neighbours by one right away, their edge differences and depths are recomputed lazily
+    // when they get to the top of the queue.
+    std::vector<std::int64_t> contracted_neighbours(topology.node_count, 0);
+    std::vector<std::int64_t> depth(topology.node_count, 0);
+    auto getPriority = [&](std::size_t node, const std::vector<Shortcut>& shortcuts) {
+        return 2 * contractor.getEdgeDifference(node, shortcuts) + contracted_neighbours[node] + depth[node];
+    };
+
+    // Queue entries of contracted nodes and entries with an old priority are skipped
+    std::vector<std::int64_t> priority(topology.node_count);
+    std::vector<bool> is_contracted(topology.node_count, false);
+    std::vector<std::pair<std::int64_t, std::size_t>> queue;
+    for (std::size_t node = 0; node < topology.node_count; ++node) {
+        priority[node] = getPriority(node, contractor.findShortcuts(node));
+        queue.push_back({priority[node], node});
+    }
+    std::make_heap(queue.begin(), queue.end(), std::greater<>());
+
+    std::size_t next_rank = 0;
+    while (!queue.empty()) {
+        std::pop_heap(queue.begin(), queue.end(), std::greater<>());
+        auto [queued_priority, node] = queue.back();
+        queue.pop_back();
+        if (is_contracted[node] || queued_priority != priority[node]) {
+            continue;
+        }
+
+        auto shortcuts = contractor.findShortcuts(node);
+        priority[node] = getPriority(node, shortcuts);
+        if (!queue.empty() && priority[node] > queue.front().first) {
+            queue.push_back({priority[node], node});
+            std::push_heap(queue.begin(), queue.end(), std::greater<>());
+            continue;
+        }
+
+        for (auto& shortcut : shortcuts) {
+            if (contractor.addArc(shortcut.from_node, shortcut.to_node, shortcut.weight, hierarchy.m_arcs.size())) {
+                hierarchy.m_arcs.push_back({shortcut.from_node, shortcut.to_node, shortcut.weight,
+                    no_arc, shortcut.first_arc, shortcut.second_arc});
+            }
+        }
+        for (auto neighbour : contractor.removeNode(node)) {
+            ++contracted_neighbours[neighbour];
+            depth[neighbour] = std::max(depth[neighbour], depth[node] + 1);
+            queue.push_back({++priority[neighbour], neighbour});
+            std::push_heap(queue.begin(), queue.end(), std::greater<>());
+        }
+        is_contracted[node] = true;
+        hierarchy.m_rank[node] = next_rank++;
+    }
+
+    hierarchy.buildAdjacency();
+    return hierarchy;
+}
+
+void ContractionHierarchy::buildAdjacency() {
+    m_upward_offsets.assign(m_node_count + 1, 0);
+    m_downward_offsets.assign(m_node_count + 1, 0);
+    for (auto& arc : m_arcs) {
+        if (m_rank[arc.from_node] < m_rank[arc.to_node]) {
+            ++m_upward_offsets[arc.from_node + 1];
+        }
+        else {
+            ++m_downward_offsets[arc.to_node + 1];
+        }
+    }
+    for (std::size_t node = 0; node < m_node_count; ++node) {
+        m_upward_offsets[node + 1] += m_upward_offsets[node];
+        m_downward_offsets[node + 1] += m_downward_offsets[node];
+    }
+
+    m_upward_arcs.resize(m_upward_offsets[m_node_count]);
+    m_downward_arcs.resize(m_downward_offsets[m_node_count]);
+    auto upward_next = m_upward_offsets;
+    auto downward_next = m_downward_offsets;
+    for (std::size_t i = 0; i < m_arcs.size(); ++i) {
+        auto& arc = m_arcs[i];
+        if (m_rank[arc.from_node] < m_rank[arc.to_node]) {
+            m_upward_arcs[upward_next[arc.from_node]++] = i;
+        }
+        else {
+            m_downward_arcs[downward_next[arc.to_node]++] = i;
+        }
+    }
+}
+
+std::uint64_t ContractionHierarchy::getFingerprint(const PathGraphTopology& topology) {
+    // FNV-1a hash of the node count and of all the edges with their weights
+    std::uint64_t hash = 14695981039346656037ULL;
+    auto add = [&hash](std::uint64_t value) {
+        for (int i = 0; i < 8; ++i) {
+            hash ^= (value >> (i * 8)) & 0xFF;
+            hash *= 1099511628211ULL;
+        }
+    };
+
+    add(topology.node_count);
+    add(topology.edge_count);
+    for (std::size_t i = 0; i < topology.edge_count; ++i) {
+        add(topology.edges[i].from_node_index);
+        add(topology.edges[i].to_node_index);
+        add(topology.edge_weights[i]);
+    }
+    return hash;
+}
+
+void ContractionHierarchy::save(std::ostream& output) const {
+    auto toSaved = [](std::size_t value) {
+        if (value >= saved_no_arc) {
+            throw std::runtime_error("Contraction hierarchy is too big to be saved");
+        }
+        return static_cast<std::uint32_t>(value);
+    };
+
+    // Original edges are saved just by their index, shortcuts by their two arcs, the rest is taken from the graph
+    std::vector<std::uint32_t> data;
+    data.reserve(m_node_count + 2 * m_arcs.size());
+    for (auto rank : m_rank) {
+        data.push_back(toSaved(rank));
+    }
+    for (auto& arc : m_arcs) {
+        data.push_back(toSaved(arc.edge != no_arc ? arc.edge : arc.first_arc));
+    }
+    for (auto& arc : m_arcs) {
+        data.push_back(arc.edge != no_arc ? saved_no_arc : toSaved(arc.second_arc));
+    }
+
+    std::array<std::uint64_t, header_field_count> header = {index_version, m_node_count, m_fingerprint, m_arcs.size()};
+    convertLittleEndian(header);
+    convertLittleEndian(data);
+    output.write(index_magic, sizeof(index_magic));
+    output.write(reinterpret_cast<const char*>(header.data()), sizeof(header));
+    output.write(reinterpret_cast<const char*>(data.data()),
+        static_cast<std::streamsize>(data.size() * sizeof(std::uint32_t)));
+}
+
+ContractionHierarchy ContractionHierarchy::load(std::istream& input, const PathGraphTopology& topology) {
+    char magic[sizeof(index_magic)];
+    if (!input.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), index_magic)) {
+        throw std::runtime_error("Invalid contraction hierarchy header");
+    }
+    std::array<std::uint64_t, header_field_count> header;
+    if (!input.read(reinterpret_cast<char*>(header.data()), sizeof(header))) {
+        throw std::runtime_error("Invalid format for contraction hierarchy: missing header");
+    }
+    convertLittleEndian(header);
+    auto [version, node_count, fingerprint, arc_count] = header;
+    if (version != index_version) {
+        throw std::runtime_error("Unsupported version of contraction hierarchy");
+    }
+    if (node_count != topology.node_count || fingerprint != getFingerprint(topology)) {
+        throw std::runtime_error("Contraction hierarchy was built for a different graph");
+    }
+
+    // The arc count is checked against the rest of the file before anything is allocated
+    auto data_start = input.tellg();
+    input.seekg(0, std::ios::end);
+    auto data_end = input.tellg();
+    input.seekg(data_start);
+    if (data_start == std::streampos(-1) || data_end == std::streampos(-1)) {
+        throw std::runtime_error("Contraction hierarchy can't be read");
+    }
+    auto data_size = static_cast<std::uint64_t>(data_end - data_start);
+    if (arc_count > data_size / (2 * sizeof(std::uint32_t))
+        || data_size != (node_count + 2 * arc_count) * sizeof(std::uint32_t)) {
+        throw std::runtime_error("Invalid format for contraction hierarchy: unexpected size of the file");
+    }
+
+    std::vector<std::uint32_t> data(node_count + 2 * arc_count);
+    if (!input.read(reinterpret_cast<char*>(data.data()), static_cast<std::streamsize>(data_size))) {
+        throw std::runtime_error("Invalid format for contraction hierarchy: unexpected end of file");
+    }
+    convertLittleEndian(data);
+    auto ranks = std::span(data).subspan(0, node_count);
+    auto first_arcs = std::span(data).subspan(node_count, arc_count);
+    auto second_arcs = std::span(data).subspan(node_count + arc_count, arc_count);
+
+    ContractionHierarchy hierarchy(node_count, fingerprint);
+    std::vector<bool> rank_used(node_count, false);
+    for (std::size_t node = 0; node < node_count; ++node) {
+        if (ranks[node] >= node_count || rank_used[ranks[node]]) {
+            throw std::runtime_error("Invalid format for contraction hierarchy: node rank");
+        }
+        rank_used[ranks[node]] = true;
+        hierarchy.m_rank[node] = ranks[node];
+    }
+
+    hierarchy.m_arcs.reserve(arc_count);
+    for (std::size_t i = 0; i < arc_count; ++i) {
+        if (second_arcs[i] == saved_no_arc) {
+            std::size_t edge = first_arcs[i];
+            if (edge >= topology.edge_count) {
+                throw std::runtime_error("Invalid format for contraction hierarchy: edge index");
+            }
+            hierarchy.m_arcs.push_back({topology.edges[edge].from_node_index, topology.edges[edge].to_node_index,
+                topology.edge_weights[edge], edge, no_arc, no_arc});
+            continue;
+        }
+
+        // Shortcuts only consist of arcs created before them
+        if (first_arcs[i] >= i || second_arcs[i] >= i) {
+            throw std::runtime_error("Invalid format for contraction hierarchy: shortcut");
+        }
+        auto& first = hierarchy.m_arcs[first_arcs[i]];
+        auto& second = hierarchy.m_arcs[second_arcs[i]];
+        if (first.to_node != second.from_node) {
+            throw std::runtime_error("Invalid contraction hierarchy: shortcut does not match its arcs");
+        }
+        hierarchy.m_arcs.push_back({first.from_node, second.to_node, first.weight + second.weight,
+            no_arc, first_arcs[i], second_arcs[i]});
+    }
+
+    hierarchy.buildAdjacency();
+    return hierarchy;
+}
+
+std::shared_ptr<const ContractionHierarchy> ContractionHierarchy::loadOrBuild(const std::string& file_name,
+    const PathGraphTopology& topology) {
+
+    std::ifstream input(file_name, std::ios::binary);
+    if (input.good()) {
+        try {
+            return std::make_shared<const ContractionHierarchy>(load(input, topology));
+        }
+        catch (const std::runtime_error&) {
+            // The saved hierarchy is outdated or broken, it is built again
+        }
+    }
+
+    auto hierarchy = std::make_shared<const ContractionHierarchy>(build(topology));
+    std::ofstream output(file_name, std::ios::binary);
+    if (!output.good()) {
+        throw std::runtime_error("Can not write file: \"" + file_name + "\"");
+    }
+    hierarchy->save(output);
+    return hierarchy;
+}
+
+std::size_t ContractionHierarchy::getNodeCount() const {
+    return m_node_count;
+}
+
+const ContractionHierarchy::Arc& ContractionHierarchy::getArc(std::size_t arc) const {
+    return m_arcs[arc];
+}
+
+std::size_t ContractionHierarchy::getArcCount() const {
+    return m_arcs.size();
+}
+
+std::span<const std::size_t> ContractionHierarchy::getUpwardArcs(std::size_t node) const {
+    return std::span<const std::size_t>(m_upward_arcs).subspan(
+        m_upward_offsets[node], m_upward_offsets[node + 1] - m_upward_offsets[node]);
+}
+
+std::span<const std::size_t> ContractionHierarchy::getDownwardArcs(std::size_t node) const {
+    return std::span<const std::size_t>(m_downward_arcs).subspan(
+        m_downward_offsets[node], m_downward_offsets[node + 1] - m_downward_offsets[node]);
+}
+
+void ContractionHierarchy::unpackArc(std::size_t arc, std::vector<std::size_t>& original_arcs) const {
+    auto& hierarchy_arc = m_arcs[arc];
+    if (hierarchy_arc.edge != no_arc) {
+        original_arcs.push_back(arc);
+        return;
+    }
+    unpackArc(hierarchy_arc.first_arc, original_arcs);
+    unpackArc(hierarchy_arc.second_arc, original_arcs);
+}
+
+std::vector<std::size_t> ContractionHierarchy::unpackPath(std::span<const std::size_t> arcs) const {
+    std::vector<std::size_t> original_arcs;
+    for (auto arc : arcs) {
+        unpackArc(arc, original_arcs);
+    }
+
+    std::vector<std::size_t> path;
+    if (original_arcs.empty()) {
+        return path;
+    }
+
+    // With zero weight edges the unpacked shortcuts can go through a node twice (e.g. 6->5->6).
+    // Such a cycle has zero weight on a shortest path, so it is cut out and the path stays the shortest one.
+    std::unordered_map<std::size_t, std::size_t> path_positions; // Number of path arcs before reaching the node
+    path_positions.emplace(m_arcs[original_arcs.front()].from_node, 0);
+    for (auto arc : original_arcs) {
+        auto to_node = m_arcs[arc].to_node;
+        auto position = path_positions.find(to_node);
+        if (position == path_positions.end()) {
+            path.push_back(arc);
+            path_positions.emplace(to_node, path.size());
+            continue;
+        }
+
+        auto cycle_start = position->second;
+        while (path.size() > cycle_start) {
+            path_positions.erase(m_arcs[path.back()].to_node);
+            path.pop_back();
+        }
+    }
+
+    for (auto& arc : path) {
+        arc = m_arcs[arc].edge;
+    }
+    return path;
+}
+
+bool ContractionHierarchyQuery::QueueEntry::operator>(const QueueEntry& other) const {
+    if (distance != other.distance) {
+        return distance > other.distance;
+    }
+    return node > other.node;
+}
+
+ContractionHierarchyQuery::ContractionHierarchyQuery(std::shared_ptr<const ContractionHierarchy> hierarchy)
+    :   m_hierarchy(std::move(hierarchy)),
+        m_start_node(0),
+        m_end_node(0),
+        m_best_distance(infinite_distance),
+        m_meeting_node(0) {
+
+    for (auto search : {&m_forward, &m_backward}) {
+        search->distance.assign(m_hierarchy->getNodeCount(), infinite_distance);
+        search->entered_by.assign(m_hierarchy->getNodeCount(), ContractionHierarchy::no_arc);
+    }
+}
+
+void ContractionHierarchyQuery::start(std::size_t start_node, std::size_t end_node) {
+    for (auto node : m_touched) {
+        m_forward.distance[node] = infinite_distance;
+        m_backward.distance[node] = infinite_distance;
+    }
+    m_touched.clear();
+    m_forward.queue.clear();
+    m_backward.queue.clear();
+
+    m_start_node = start_node;
+    m_end_node = end_node;
+    m_best_distance = infinite_distance;
+    reach(m_forward, start_node, 0, ContractionHierarchy::no_arc);
+    reach(m_backward, end_node, 0, ContractionHierarchy::no_arc);
+}
+
+void ContractionHierarchyQuery::reach(Search& search, std::size_t node, std::uint64_t distance, std::size_t arc) {
+    if (distance >= search.distance[node]) {
+        return;
+    }
+    auto& other = (&search == &m_forward) ? m_backward : m_forward;
+    if (search.distance[node] == infinite_distance && other.distance[node] == infinite_distance) {
+        m_touched.push_back(node);
+    }
+
+    search.distance[node] = distance;
+    search.entered_by[node] = arc;
+    search.queue.push_back({distance, node});
+    std::push_heap(search.queue.begin(), search.queue.end(), std::greater<QueueEntry>());
+
+    if (other.distance[node] != infinite_distance && distance + other.distance[node] < m_best_distance) {
+        m_best_distance = distance + other.distance[node];
+        m_meeting_node = node;
+    }
+}
+
+std::uint64_t ContractionHierarchyQuery::getQueueMinimum(Search& search) {
+    while (!search.queue.empty() && search.queue.front().distance != search.distance[search.queue.front().node]) {
+        std::pop_heap(search.queue.begin(), search.queue.end(), std::greater<QueueEntry>());
+        search.queue.pop_back();
+    }
+    return search.queue.empty() ? infinite_distance : search.queue.front().distance;
+}
+
+std::optional<ContractionHierarchyQuery::SettledNode> ContractionHierarchyQuery::settleNext() {
+    // A side is done once it can't find anything shorter than the best path
+    auto forward_minimum = getQueueMinimum(m_forward);
+    auto backward_minimum = getQueueMinimum(m_backward);
+    if (forward_minimum >= m_best_distance && backward_minimum >= m_best_distance) {
+        return std::nullopt;
+    }
+
+    auto forward = forward_minimum <= backward_minimum;
+    auto& search = forward ? m_forward : m_backward;
+    std::pop_heap(search.queue.begin(), search.queue.end(), std::greater<QueueEntry>());
+    auto node = search.queue.back().node;
+    search.queue.pop_back();
+
+    // Stall on demand, a higher node already reached gives the node a shorter distance
+    auto distance = search.distance[node];
+    auto higher_arcs = forward ? m_hierarchy->getDownwardArcs(node) : m_hierarchy->getUpwardArcs(node);
+    for (auto arc_index : higher_arcs) {
+        auto& arc = m_hierarchy->getArc(arc_index);
+        auto higher_distance = search.distance[forward ? arc.from_node : arc.to_node];
+        if (higher_distance != infinite_distance && higher_distance + arc.weight < distance) {
+            return SettledNode{node, forward, false};
+        }
+    }
+
+    auto arcs = forward ? m_hierarchy->getUpwardArcs(node) : m_hierarchy->getDownwardArcs(node);
+    for (auto arc_index : arcs) {
+        auto& arc = m_hierarchy->getArc(arc_index);
+        reach(search, forward ? arc.to_node : arc.from_node, distance + arc.weight, arc_index);
+    }
+    return SettledNode{node, forward, true};
+}
+
+std::uint64_t ContractionHierarchyQuery::run(std::size_t start_node, std::size_t end_node) {
+    start(start_node, end_node);
+    while (settleNext()) {}
+    return m_best_distance;
+}
+
+std::uint64_t ContractionHierarchyQuery::getDistance() const {
+    return m_best_distance;
+}
+
+bool ContractionHierarchyQuery::isReached(std::size_t node, bool forward) const {
+    return (forward ? m_forward : m_backward).distance[node] != infinite_distance;
+}
+
+std::vector<std::size_t> ContractionHierarchyQuery::getPathEdges() const {
+    std::vector<std::size_t> arcs;
+    if (m_best_distance == infinite_distance) {
+        return arcs;
+    }
+
+    for (auto node = m_meeting_node; node != m_start_node;) {
+        auto arc = m_forward.entered_by[node];
+        arcs.push_back(arc);
+        node = m_hierarchy->getArc(arc).from_node;
+    }
+    std::reverse(arcs.begin(), arcs.end());
+    for (auto node = m_meeting_node; node != m_end_node;) {
+        auto arc = m_backward.entered_by[node];
+        arcs.push_back(arc);
+        node = m_hierarchy->getArc(arc).to_node;
+    }
+    return m_hierarchy->unpackPath(arcs);
+}
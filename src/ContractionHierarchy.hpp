@@ -0,0 +1,232 @@
+#ifndef ContractionHierarchy_hpp
+#define ContractionHierarchy_hpp
+
+#include "PathGraph.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * Class representing a contraction hierarchy of a path graph, an index for fast shortest path queries.
+ *
+ * Nodes are contracted one by one in the order of their importance (edge difference, number of contracted
+ * neighbours and depth). When a node is contracted, a shortcut is added between its remaining neighbours for every path
+ * through it that has no witness path of at most the same length. A query then only has to search
+ * upwards in the order from both ends. Every arc is an original edge or a shortcut made of two arcs,
+ * so any path of arcs can be unpacked back into the edges of the graph.
+ */
+class ContractionHierarchy {
+public:
+    // Structure representing an arc of the hierarchy, an original edge or a shortcut
+    struct Arc {
+        std::size_t from_node;
+        std::size_t to_node;
+        std::uint64_t weight;
+        std::size_t edge; // Index of the original edge, or no_arc for a shortcut
+        std::size_t first_arc; // Arcs the shortcut is made of, both are no_arc for an original edge
+        std::size_t second_arc;
+    };
+
+    static constexpr std::size_t no_arc = static_cast<std::size_t>(-1);
+
+private:
+    std::size_t m_node_count;
+    std::uint64_t m_fingerprint; // Fingerprint of the graph the hierarchy was built for
+    std::vector<std::size_t> m_rank; // Position of each node in the contraction order
+    std::vector<Arc> m_arcs;
+    std::vector<std::size_t> m_upward_arcs; // Arcs leaving each node to a higher node, grouped by node
+    std::vector<std::size_t> m_upward_offsets; // Start of the upward arcs of each node in m_upward_arcs
+    std::vector<std::size_t> m_downward_arcs; // Arcs entering each node from a higher node, grouped by node
+    std::vector<std::size_t> m_downward_offsets; // Start of the downward arcs of each node in m_downward_arcs
+
+    // Constructor for an empty hierarchy, filled by build() or load()
+    ContractionHierarchy(std::size_t node_count, std::uint64_t fingerprint);
+
+    /**
+     * Builds the upward and downward adjacency from the ranks and the arcs.
+     */
+    void buildAdjacency();
+
+    /**
+     * Appends the arcs of the original edges the arc is made of.
+     */
+    void unpackArc(std::size_t arc, std::vector<std::size_t>& original_arcs) const;
+
+public:
+    /**
+     * Contracts all the nodes of the graph and builds the hierarchy.
+     *
+     * @param topology The topology of the path graph.
+     * @return The built hierarchy.
+     */
+    static ContractionHierarchy build(const PathGraphTopology& topology);
+
+    /**
+     * Loads a hierarchy saved by save(), the blocks are read at once.
+     *
+     * @param input The input stream containing the saved hierarchy.
+     * @param topology The topology of the path graph the hierarchy has to belong to.
+     * @return The loaded hierarchy.
+     * @throws std::runtime_error if the data is invalid or was built for a different graph.
+     */
+    static ContractionHierarchy load(std::istream& input, const PathGraphTopology& topology);
+
+    /**
+     * Loads the hierarchy from the file, or builds it and saves it to the file if it is missing or outdated.
+     *
+     * @param file_name Name of the file with the saved hierarchy.
+     * @param topology The topology of the path graph.
+     * @return The shared hierarchy.
+     * @throws std::runtime_error if the built hierarchy can't be saved.
+     */
+    static std::shared_ptr<const ContractionHierarchy> loadOrBuild(const std::string& file_name,
+        const PathGraphTopology& topology);
+
+    /**
+     * Returns the fingerprint of the nodes, edges and weights of the graph.
+     */
+    static std::uint64_t getFingerprint(const PathGraphTopology& topology);
+
+    /**
+     * Saves the hierarchy in a binary format to the output stream: a header (magic, version, node count,
+     * fingerprint and arc count) followed by little-endian 32-bit blocks of the node ranks, of the first arcs
+     * (edge indices of the original edges) and of the second arcs of all the arcs.
+     *
+     * @throws std::runtime_error if the hierarchy has too many nodes or arcs for the format.
+     */
+    void save(std::ostream& output) const;
+
+    /**
+     * Returns the number of nodes.
+     */
+    std::size_t getNodeCount() const;
+
+    /**
+     * Returns the arc with the given index.
+     */
+    const Arc& getArc(std::size_t arc) const;
+
+    /**
+     * Returns the number of arcs, original edges and shortcuts.
+     */
+    std::size_t getArcCount() const;
+
+    /**
+     * Returns indices of the arcs leaving the node to higher nodes.
+     */
+    std::span<const std::size_t> getUpwardArcs(std::size_t node) const;
+
+    /**
+     * Returns indices of the arcs entering the node from higher nodes.
+     */
+    std::span<const std::size_t> getDownwardArcs(std::size_t node) const;
+
+    /**
+     * Returns indices of the original edges on the path of arcs, in order.
+     * Zero weight cycles of the unpacked path are left out, so no node is visited twice.
+     */
+    std::vector<std::size_t> unpackPath(std::span<const std::size_t> arcs) const;
+};
+
+/**
+ * Class for shortest path queries in a contraction hierarchy.
+ *
+ * It runs Dijkstra's algorithm upwards from the start node and upwards over reversed arcs from the end node.
+ * Nodes reached over a shorter path from a higher node are stalled (not expanded), as their distance can't be
+ * on a shortest path. The workspace is kept between queries and only the touched nodes are reset, so a query
+ * costs time proportional to the (small) searched part of the hierarchy, not to the size of the graph.
+ */
+class ContractionHierarchyQuery {
+public:
+    // Structure describing a node settled by one of the searches
+    struct SettledNode {
+        std::size_t node;
+        bool forward; // True for the search from the start node
+        bool expanded; // False if the node was stalled, so its arcs were not relaxed
+    };
+
+private:
+    // Entry of the priority queue, outdated entries are skipped when popped
+    struct QueueEntry {
+        std::uint64_t distance;
+        std::size_t node;
+
+        bool operator>(const QueueEntry& other) const;
+    };
+
+    // Structure holding the state of the search from one side
+    struct Search {
+        std::vector<std::uint64_t> distance; // Tentative distance from the root of the search
+        std::vector<std::size_t> entered_by; // Index of the arc each node was entered by
+        std::vector<QueueEntry> queue; // Binary min-heap of found nodes
+    };
+
+    std::shared_ptr<const ContractionHierarchy> m_hierarchy;
+    Search m_forward; // Search from the start node
+    Search m_backward; // Search from the end node
+    std::vector<std::size_t> m_touched; // Nodes with a finite distance on either side
+    std::size_t m_start_node;
+    std::size_t m_end_node;
+    std::uint64_t m_best_distance; // Length of the shortest path through a node reached by both searches
+    std::size_t m_meeting_node;
+
+    /**
+     * Removes outdated entries from the top of the queue and returns the lowest distance in it.
+     */
+    std::uint64_t getQueueMinimum(Search& search);
+
+    /**
+     * Sets the distance of the node in the search, if it is lower, and queues it.
+     */
+    void reach(Search& search, std::size_t node, std::uint64_t distance, std::size_t arc);
+
+public:
+    /**
+     * Constructor for ContractionHierarchyQuery.
+     *
+     * @param hierarchy The hierarchy the queries are answered in.
+     */
+    ContractionHierarchyQuery(std::shared_ptr<const ContractionHierarchy> hierarchy);
+
+    /**
+     * Starts a new query, the previous one is forgotten.
+     */
+    void start(std::size_t start_node, std::size_t end_node);
+
+    /**
+     * Settles the next node of the side with the lower tentative distance.
+     *
+     * @return The settled node, or nothing if the query is finished.
+     */
+    std::optional<SettledNode> settleNext();
+
+    /**
+     * Runs the whole query.
+     *
+     * @return The length of the shortest path, or the maximum value if there is none.
+     */
+    std::uint64_t run(std::size_t start_node, std::size_t end_node);
+
+    /**
+     * Returns the length of the shortest path found so far, or the maximum value if there is none.
+     */
+    std::uint64_t getDistance() const;
+
+    /**
+     * Returns true if the node was reached by the search from the given side.
+     */
+    bool isReached(std::size_t node, bool forward) const;
+
+    /**
+     * Returns indices of the original edges on the shortest path found, from the start node to the end node.
+     */
+    std::vector<std::size_t> getPathEdges() const;
+};
+
+#endif
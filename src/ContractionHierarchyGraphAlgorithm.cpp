@@ -0,0 +1,71 @@
+#include "ContractionHierarchyGraphAlgorithm.hpp"
+#include "PathGraph.hpp"
+
+#include <limits>
+
+ContractionHierarchyGraphAlgorithm::ContractionHierarchyGraphAlgorithm(PathGraph&& graph,
+    std::shared_ptr<const ContractionHierarchy> hierarchy)
+    :   m_graph(std::move(graph)),
+        m_hierarchy(std::move(hierarchy)),
+        m_query(m_hierarchy),
+        m_first_step(true),
+        m_finished(false) {}
+
+void ContractionHierarchyGraphAlgorithm::markReachedNodes(const ContractionHierarchyQuery::SettledNode& settled) {
+    auto arcs = settled.forward ? m_hierarchy->getUpwardArcs(settled.node) : m_hierarchy->getDownwardArcs(settled.node);
+    for (auto arc_index : arcs) {
+        auto& arc = m_hierarchy->getArc(arc_index);
+        auto node_index = settled.forward ? arc.to_node : arc.from_node;
+        if (m_graph.node_states[node_index] == PathNodeState::NotFound) {
+            m_graph.node_states[node_index] = settled.forward ? PathNodeState::Found : PathNodeState::FoundBackward;
+        }
+    }
+}
+
+void ContractionHierarchyGraphAlgorithm::markShortestPath() {
+    auto& topology = m_graph.getTopology();
+    if (m_query.getDistance() == std::numeric_limits<std::uint64_t>::max()) {
+        return;
+    }
+    if (m_graph.start_node == m_graph.end_node) {
+        m_graph.node_states[m_graph.start_node] = PathNodeState::OnShortestPath;
+    }
+
+    for (auto edge_index : m_query.getPathEdges()) {
+        m_graph.edge_states[edge_index] = PathEdgeState::OnShortestPath;
+        auto node_index = topology.edges[edge_index].to_node_index;
+        if (node_index != m_graph.end_node) {
+            m_graph.node_states[node_index] = PathNodeState::OnShortestPath;
+        }
+    }
+}
+
+bool ContractionHierarchyGraphAlgorithm::nextStep() {
+    // Lets the renderer draw the initial state of graph
+    if (m_first_step) {
+        m_query.start(m_graph.start_node, m_graph.end_node);
+        m_first_step = false;
+        return true;
+    }
+
+    if (m_finished) {
+        return false;
+    }
+
+    auto settled = m_query.settleNext();
+    if (!settled) {
+        markShortestPath();
+        m_finished = true;
+        return true;
+    }
+
+    m_graph.node_states[settled->node] = settled->forward ? PathNodeState::Visited : PathNodeState::VisitedBackward;
+    if (settled->expanded) {
+        markReachedNodes(*settled);
+    }
+    return true;
+}
+
+const Graph& ContractionHierarchyGraphAlgorithm::getState() const {
+    return m_graph;
+}
@@ -0,0 +1,59 @@
+#ifndef ContractionHierarchyGraphAlgorithm_hpp
+#define ContractionHierarchyGraphAlgorithm_hpp
+
+#include "ContractionHierarchy.hpp"
+#include "GraphAlgorithm.hpp"
+#include "PathGraph.hpp"
+#include <memory>
+
+/**
+ * Class for a shortest path query in a contraction hierarchy visualized on the path graph.
+ *
+ * Both searches only go upwards in the hierarchy, so just a few nodes are found and visited.
+ * Shortcuts can't be drawn, so the edges are only colored once the path is unpacked into the original edges.
+ */
+class ContractionHierarchyGraphAlgorithm : public GraphAlgorithm {
+    PathGraph m_graph;
+    std::shared_ptr<const ContractionHierarchy> m_hierarchy;
+    ContractionHierarchyQuery m_query;
+    bool m_first_step;
+    bool m_finished;
+
+    /**
+     * Marks the nodes reached over the arcs of the settled node as found.
+     */
+    void markReachedNodes(const ContractionHierarchyQuery::SettledNode& settled);
+
+    /**
+     * Unpacks the shortest path and marks its nodes and edges.
+     */
+    void markShortestPath();
+
+public:
+    /**
+     * Constructor for ContractionHierarchyGraphAlgorithm.
+     *
+     * @param graph The graph in which the shortest path is found.
+     * @param hierarchy The contraction hierarchy built for the topology of the graph.
+     */
+    ContractionHierarchyGraphAlgorithm(PathGraph&& graph, std::shared_ptr<const ContractionHierarchy> hierarchy);
+
+    /**
+     * Executes the next step of the query.
+     *
+     * Every step settles one node of the search from the start node (shown as visited) or of the search
+     * from the end node (shown as visited backward). The last step marks the unpacked shortest path.
+     *
+     * @return True if there are more steps to be taken, false otherwise.
+     */
+    virtual bool nextStep() override;
+
+    /**
+     * Returns the current state of the graph.
+     *
+     * @return A constant reference to the current state of the graph.
+     */
+    virtual const Graph& getState() const override;
+};
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef CoroutineGraphAlgorithm_hpp
+#define CoroutineGraphAlgorithm_hpp
+
+#include "Generator.hpp"
+#include "GraphAlgorithm.hpp"
+
+/**
+ * Abstract base class for graph algorithms written as coroutines.
+ *
+ * The algorithm is implemented as straight-line code in steps(), which does co_yield of its graph
+ * after every step instead of keeping the position in the run between calls of nextStep().
+ * nextStep() just resumes the coroutine, so both ways of stepping behave the same.
+ */
+class CoroutineGraphAlgorithm : public GraphAlgorithm {
+    Generator<Graph> m_steps; // Coroutine resumed by nextStep(), started by its first call
+    bool m_started = false;
+
+public:
+    /**
+     * Returns the coroutine running the algorithm, it yields the graph after every step.
+     */
+    virtual Generator<Graph> steps() override = 0;
+
+    /**
+     * Executes the next step of the algorithm by resuming its coroutine.
+     *
+     * @return True if there are more steps to be taken, false otherwise.
+     */
+    virtual bool nextStep() override {
+        if (!m_started) {
+            m_steps = steps();
+            m_started = true;
+        }
+        return m_steps.next();
+    }
+};
+
+#endif
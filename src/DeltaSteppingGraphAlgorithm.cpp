@@ -0,0 +1,234 @@
+#include "DeltaSteppingGraphAlgorithm.hpp"
+#include "PathGraph.hpp"
+
+#include <algorithm>
+#include <limits>
+
+// Nodes are owned by threads in blocks, so each thread writes states of whole cache lines
+static constexpr std::size_t owner_block_size = 64;
+
+static constexpr std::uint64_t infinite_distance = std::numeric_limits<std::uint64_t>::max();
+static constexpr std::size_t no_edge = std::numeric_limits<std::size_t>::max();
+
+// Helper function to choose the bucket width from the highest weight and the average out-degree
+static std::uint64_t getDefaultDelta(const PathGraphTopology& topology) {
+    auto node_count = std::max<std::size_t>(1, topology.node_count);
+    auto average_degree = std::max<std::size_t>(1, topology.edge_count / node_count);
+    return std::max<std::uint64_t>(1, topology.max_edge_weight / average_degree);
+}
+
+DeltaSteppingGraphAlgorithm::DeltaSteppingGraphAlgorithm(PathGraph&& graph, std::size_t thread_count, std::uint64_t delta)
+    :   m_graph(std::move(graph)),
+        m_pool(thread_count),
+        m_delta(delta != 0 ? delta : getDefaultDelta(m_graph.getTopology())),
+        m_bucket_count(0),
+        m_distance(m_graph.node_count, infinite_distance),
+        m_expanded_distance(m_graph.node_count, infinite_distance),
+        m_entered_by(m_graph.node_count, no_edge),
+        m_settled(m_graph.node_count, false),
+        m_requests(m_pool.size(), std::vector<std::vector<Request>>(m_pool.size())),
+        m_settled_in_bucket(m_pool.size()),
+        m_bucket_refilled(false),
+        m_current_bucket(0),
+        m_first_step(true),
+        m_finished(false) {
+
+    // A relaxation from the current bucket can reach at most max_edge_weight / delta + 1 buckets further
+    m_bucket_count = m_graph.getTopology().max_edge_weight / m_delta + 2;
+    m_buckets.assign(m_pool.size(), std::vector<std::vector<BucketEntry>>(m_bucket_count));
+}
+
+std::size_t DeltaSteppingGraphAlgorithm::getOwner(std::size_t node) const {
+    return (node / owner_block_size) % m_pool.size();
+}
+
+bool DeltaSteppingGraphAlgorithm::relax(const Request& request, std::size_t thread_index) {
+    auto node = request.node;
+    if (request.distance >= m_distance[node]) {
+        return false;
+    }
+
+    // Edges entering the node are only ever colored by the owner of the node
+    if (m_entered_by[node] != no_edge) {
+        m_graph.edge_states[m_entered_by[node]] = PathEdgeState::Default;
+    }
+    m_distance[node] = request.distance;
+    m_entered_by[node] = request.edge;
+    m_graph.edge_states[request.edge] = PathEdgeState::Peeked;
+    m_graph.node_states[node] = PathNodeState::Found;
+
+    auto bucket = request.distance / m_delta;
+    m_buckets[thread_index][bucket % m_bucket_count].push_back({node, request.distance});
+    return bucket == m_current_bucket;
+}
+
+bool DeltaSteppingGraphAlgorithm::requestRelaxations(std::size_t node, bool light, std::size_t thread_index) {
+    auto& topology = m_graph.getTopology();
+    auto distance = m_distance[node];
+    bool bucket_refilled = false;
+
+    for (auto edge_index : topology.getOutgoingEdges(node)) {
+        auto weight = topology.edge_weights[edge_index];
+        if ((weight < m_delta) != light) {
+            continue;
+        }
+        auto neighbour_index = topology.edges[edge_index].to_node_index;
+        Request request{neighbour_index, distance + weight, edge_index};
+
+        // Own nodes are relaxed right away, other threads only read their own nodes meanwhile
+        auto owner = getOwner(neighbour_index);
+        if (owner == thread_index) {
+            bucket_refilled = relax(request, thread_index) || bucket_refilled;
+        }
+        else {
+            m_requests[thread_index][owner].push_back(request);
+        }
+    }
+    return bucket_refilled;
+}
+
+bool DeltaSteppingGraphAlgorithm::applyRequests(std::size_t thread_index) {
+    bool bucket_refilled = false;
+    for (auto& requests : m_requests) {
+        for (auto& request : requests[thread_index]) {
+            bucket_refilled = relax(request, thread_index) || bucket_refilled;
+        }
+        requests[thread_index].clear();
+    }
+    return bucket_refilled;
+}
+
+bool DeltaSteppingGraphAlgorithm::findNextBucket() {
+    for (std::size_t i = 0; i < m_bucket_count; ++i) {
+        auto slot = (m_current_bucket + i) % m_bucket_count;
+        for (auto& buckets : m_buckets) {
+            if (!buckets[slot].empty()) {
+                m_current_bucket += i;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool DeltaSteppingGraphAlgorithm::processBucket() {
+    auto current_slot = m_current_bucket % m_bucket_count;
+
+    // Light edges can put nodes back into the bucket, so they are relaxed until it stays empty
+    do {
+        m_bucket_refilled = false;
+        m_pool.run([&](std::size_t thread_index) {
+            auto entries = std::move(m_buckets[thread_index][current_slot]);
+            m_buckets[thread_index][current_slot].clear();
+
+            bool bucket_refilled = false;
+            for (auto& entry : entries) {
+                auto node = entry.node;
+                if (entry.distance != m_distance[node] || entry.distance == m_expanded_distance[node]) {
+                    continue;
+                }
+                m_expanded_distance[node] = entry.distance;
+                if (!m_settled[node]) {
+                    m_settled[node] = true;
+                    m_settled_in_bucket[thread_index].push_back(node);
+                }
+                bucket_refilled = requestRelaxations(node, true, thread_index) || bucket_refilled;
+            }
+            if (bucket_refilled) {
+                m_bucket_refilled.store(true, std::memory_order_relaxed);
+            }
+        });
+        if (m_pool.size() > 1) {
+            m_pool.run([&](std::size_t thread_index) {
+                if (applyRequests(thread_index)) {
+                    m_bucket_refilled.store(true, std::memory_order_relaxed);
+                }
+            });
+        }
+    } while (m_bucket_refilled);
+
+    // Heavy edges can't reach the bucket, so one pass over its settled nodes is enough
+    m_pool.run([&](std::size_t thread_index) {
+        for (auto node : m_settled_in_bucket[thread_index]) {
+            m_graph.node_states[node] = PathNodeState::Visited;
+            if (node != m_graph.start_node) {
+                m_graph.edge_states[m_entered_by[node]] = PathEdgeState::Used;
+            }
+            requestRelaxations(node, false, thread_index);
+        }
+    });
+    if (m_pool.size() > 1) {
+        m_pool.run([&](std::size_t thread_index) {
+            applyRequests(thread_index);
+        });
+    }
+
+    bool any_settled = false;
+    for (auto& settled : m_settled_in_bucket) {
+        any_settled = any_settled || !settled.empty();
+        settled.clear();
+    }
+    ++m_current_bucket;
+    return any_settled;
+}
+
+void DeltaSteppingGraphAlgorithm::markShortestPath() {
+    auto& topology = m_graph.getTopology();
+    auto node_index = m_graph.end_node;
+    if (node_index == m_graph.start_node) {
+        m_graph.node_states[node_index] = PathNodeState::OnShortestPath;
+    }
+
+    while (node_index != m_graph.start_node) {
+        auto edge_index = m_entered_by[node_index];
+        m_graph.edge_states[edge_index] = PathEdgeState::OnShortestPath;
+        node_index = topology.edges[edge_index].from_node_index;
+        if (node_index != m_graph.start_node) {
+            m_graph.node_states[node_index] = PathNodeState::OnShortestPath;
+        }
+    }
+}
+
+bool DeltaSteppingGraphAlgorithm::nextStep() {
+    // Lets the renderer draw the initial state of graph
+    if (m_first_step) {
+        auto start_node = m_graph.start_node;
+        m_distance[start_node] = 0;
+        m_graph.node_states[start_node] = PathNodeState::Found;
+        m_buckets[getOwner(start_node)][0].push_back({start_node, 0});
+        m_first_step = false;
+        return true;
+    }
+
+    if (m_finished) {
+        return false;
+    }
+
+    // Skip buckets holding only outdated entries
+    do {
+        // We are finished
+        if (!findNextBucket()) {
+            m_finished = true;
+            return false;
+        }
+    } while (!processBucket());
+
+    // We found the end node
+    if (m_settled[m_graph.end_node]) {
+        markShortestPath();
+        m_finished = true;
+    }
+    return true;
+}
+
+const Graph& DeltaSteppingGraphAlgorithm::getState() const {
+    return m_graph;
+}
+
+std::uint64_t DeltaSteppingGraphAlgorithm::getDistance(std::size_t node) const {
+    return m_distance[node];
+}
+
+std::uint64_t DeltaSteppingGraphAlgorithm::getDelta() const {
+    return m_delta;
+}
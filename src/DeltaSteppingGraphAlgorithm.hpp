@@ -0,0 +1,134 @@
+#ifndef DeltaSteppingGraphAlgorithm_hpp
+#define DeltaSteppingGraphAlgorithm_hpp
+
+#include "GraphAlgorithm.hpp"
+#include "PathGraph.hpp"
+#include "ThreadPool.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Class for the parallel delta-stepping algorithm finding the shortest path in a graph with weighted edges.
+ *
+ * Found nodes are kept in buckets of width delta by their tentative distance. The lowest bucket is emptied
+ * in phases: light edges (lighter than delta) of its nodes are relaxed until no node falls back into it,
+ * then heavy edges of all the nodes settled in it are relaxed once. Every node belongs to one thread,
+ * which keeps its own bucket array and is the only one writing its distance and states. Other threads
+ * send it relaxation requests, applied after each phase, so no atomic operations are needed on the distances.
+ */
+class DeltaSteppingGraphAlgorithm : public GraphAlgorithm {
+    // Request to lower the distance of a node, sent to the thread owning the node
+    struct Request {
+        std::size_t node;
+        std::uint64_t distance;
+        std::size_t edge; // Index of the edge the node is reached by
+    };
+
+    // Entry of a bucket, outdated if the distance of the node has changed since
+    struct BucketEntry {
+        std::size_t node;
+        std::uint64_t distance;
+    };
+
+    PathGraph m_graph;
+    ThreadPool m_pool;
+    std::uint64_t m_delta; // Width of a bucket
+    std::size_t m_bucket_count; // Number of buckets in the cyclic bucket array of each thread
+    std::vector<std::uint64_t> m_distance; // Tentative distance of each node from the start node
+    std::vector<std::uint64_t> m_expanded_distance; // Distance each node had when its light edges were relaxed
+    std::vector<std::size_t> m_entered_by; // Index of the edge each node was entered by
+    std::vector<std::uint8_t> m_settled; // True for nodes whose distance is final
+    std::vector<std::vector<std::vector<BucketEntry>>> m_buckets; // Cyclic bucket array of each thread
+    std::vector<std::vector<std::vector<Request>>> m_requests; // Requests from each thread to each thread
+    std::vector<std::vector<std::size_t>> m_settled_in_bucket; // Nodes of each thread settled in the current bucket
+    std::atomic<bool> m_bucket_refilled; // True if a relaxation put a node back into the current bucket
+    std::uint64_t m_current_bucket; // Number of the lowest bucket which may not be empty
+    bool m_first_step;
+    bool m_finished;
+
+    /**
+     * Returns the index of the thread owning the node.
+     */
+    std::size_t getOwner(std::size_t node) const;
+
+    /**
+     * Lowers the distance of a node owned by the thread and puts it into the bucket of the new distance.
+     *
+     * @return True if the node was put into the current bucket.
+     */
+    bool relax(const Request& request, std::size_t thread_index);
+
+    /**
+     * Relaxes the light or the heavy outgoing edges of the node, requests are sent for nodes of other threads.
+     *
+     * @return True if a node was put back into the current bucket.
+     */
+    bool requestRelaxations(std::size_t node, bool light, std::size_t thread_index);
+
+    /**
+     * Applies the requests sent to the thread.
+     *
+     * @return True if a node was put back into the current bucket.
+     */
+    bool applyRequests(std::size_t thread_index);
+
+    /**
+     * Finds the lowest bucket with any entry.
+     *
+     * @return False if all the buckets are empty.
+     */
+    bool findNextBucket();
+
+    /**
+     * Settles all the nodes of the current bucket.
+     *
+     * @return True if any node was settled, all the entries of the bucket may be outdated.
+     */
+    bool processBucket();
+
+    /**
+     * Backtracks from the end node and marks the nodes and edges on the shortest path.
+     */
+    void markShortestPath();
+
+public:
+    /**
+     * Constructor for DeltaSteppingGraphAlgorithm.
+     *
+     * @param graph The graph in which the shortest path is found.
+     * @param thread_count Number of threads, zero means one thread per hardware thread.
+     * @param delta Width of a bucket, zero means the highest edge weight divided by the average out-degree.
+     */
+    DeltaSteppingGraphAlgorithm(PathGraph&& graph, std::size_t thread_count, std::uint64_t delta = 0);
+
+    /**
+     * Executes the next step of the delta-stepping algorithm.
+     *
+     * Every step settles one whole bucket. Settled nodes are shown as visited and nodes
+     * with a tentative distance as found.
+     *
+     * @return True if there are more steps to be taken, false otherwise.
+     */
+    virtual bool nextStep() override;
+
+    /**
+     * Returns the current state of the graph.
+     *
+     * @return A constant reference to the current state of the graph.
+     */
+    virtual const Graph& getState() const override;
+
+    /**
+     * Returns the distance of the node from the start node, final for settled nodes.
+     */
+    std::uint64_t getDistance(std::size_t node) const;
+
+    /**
+     * Returns the width of a bucket.
+     */
+    std::uint64_t getDelta() const;
+};
+
+#endif
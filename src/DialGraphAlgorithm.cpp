@@ -0,0 +1,140 @@
+#include "DialGraphAlgorithm.hpp"
+#include "PathGraph.hpp"
+
+#include <limits>
+
+static constexpr std::uint64_t infinite_distance = std::numeric_limits<std::uint64_t>::max();
+
+DialGraphAlgorithm::DialGraphAlgorithm(PathGraph&& graph)
+    :   m_graph(std::move(graph)),
+        m_buckets(m_graph.getTopology().max_edge_weight + 1),
+        m_queued(0),
+        m_level(0),
+        m_distance(m_graph.node_count, infinite_distance),
+        m_entered_by(m_graph.node_count),
+        m_first_step(true),
+        m_found_end(false) {}
+
+void DialGraphAlgorithm::setNodeState(std::size_t node, PathNodeState state) {
+    m_graph.node_states[node] = state;
+    if (m_event_sink) {
+        m_event_sink->onStepEvent(StepEvent::nodeState(node, state));
+    }
+}
+
+void DialGraphAlgorithm::setEdgeState(std::size_t edge, PathEdgeState state) {
+    m_graph.edge_states[edge] = state;
+    if (m_event_sink) {
+        m_event_sink->onStepEvent(StepEvent::edgeState(edge, state));
+    }
+}
+
+void DialGraphAlgorithm::markShortestPath() {
+    auto& topology = m_graph.getTopology();
+    auto node_index = m_graph.end_node;
+
+    while (node_index != m_graph.start_node) {
+        auto edge_index = m_entered_by[node_index];
+        setEdgeState(edge_index, PathEdgeState::OnShortestPath);
+        node_index = topology.edges[edge_index].from_node_index;
+        if (node_index != m_graph.start_node) {
+            setNodeState(node_index, PathNodeState::OnShortestPath);
+        }
+    }
+}
+
+std::size_t DialGraphAlgorithm::settleBucket() {
+    auto& topology = m_graph.getTopology();
+    auto bucket_index = m_level % m_buckets.size();
+    std::size_t settled = 0;
+
+    // Nodes reached over edges of weight 0 land in the same bucket, so it can grow while it is settled
+    for (std::size_t i = 0; i < m_buckets[bucket_index].size(); ++i) {
+        auto node_index = m_buckets[bucket_index][i];
+
+        // Skip entries of nodes which were settled or found again with a shorter distance
+        if (m_distance[node_index] != m_level || m_graph.node_states[node_index] == PathNodeState::Visited) {
+            continue;
+        }
+        setNodeState(node_index, PathNodeState::Visited);
+        if (node_index != m_graph.start_node) {
+            setEdgeState(m_entered_by[node_index], PathEdgeState::Used);
+        }
+        ++settled;
+
+        // We found the end node
+        if (node_index == m_graph.end_node) {
+            if (node_index == m_graph.start_node) {
+                setNodeState(node_index, PathNodeState::OnShortestPath);
+            }
+            markShortestPath();
+            m_found_end = true;
+            return settled;
+        }
+
+        for (auto edge_index : topology.getOutgoingEdges(node_index)) {
+            auto neighbour_index = topology.edges[edge_index].to_node_index;
+            auto new_distance = m_level + topology.edge_weights[edge_index];
+
+            if (m_graph.node_states[neighbour_index] == PathNodeState::Visited || new_distance >= m_distance[neighbour_index]) {
+                continue;
+            }
+
+            // The neighbour was found before over a longer path
+            if (m_graph.node_states[neighbour_index] == PathNodeState::Found) {
+                setEdgeState(m_entered_by[neighbour_index], PathEdgeState::Default);
+            }
+            setEdgeState(edge_index, PathEdgeState::Peeked);
+            setNodeState(neighbour_index, PathNodeState::Found);
+            m_distance[neighbour_index] = new_distance;
+            m_entered_by[neighbour_index] = edge_index;
+            m_buckets[new_distance % m_buckets.size()].push_back(neighbour_index);
+            ++m_queued;
+        }
+    }
+
+    m_queued -= m_buckets[bucket_index].size();
+    m_buckets[bucket_index].clear();
+    return settled;
+}
+
+bool DialGraphAlgorithm::nextStep() {
+    // Lets the renderer draw the initial state of graph
+    if (m_first_step) {
+        m_distance[m_graph.start_node] = 0;
+        m_buckets[0].push_back(m_graph.start_node);
+        m_queued = 1;
+        m_first_step = false;
+        return true;
+    }
+
+    if (m_found_end) {
+        return false;
+    }
+
+    // Buckets holding only outdated entries don't make a step
+    while (m_queued > 0) {
+        while (m_buckets[m_level % m_buckets.size()].empty()) {
+            ++m_level;
+        }
+        if (settleBucket() > 0) {
+            return true;
+        }
+    }
+
+    // We are finished
+    return false;
+}
+
+bool DialGraphAlgorithm::setEventSink(StepEventSink* sink) {
+    m_event_sink = sink;
+    return true;
+}
+
+const Graph& DialGraphAlgorithm::getState() const {
+    return m_graph;
+}
+
+std::uint64_t DialGraphAlgorithm::getDistance(std::size_t node) const {
+    return m_distance[node];
+}
@@ -0,0 +1,89 @@
+#ifndef DialGraphAlgorithm_hpp
+#define DialGraphAlgorithm_hpp
+
+#include "GraphAlgorithm.hpp"
+#include "PathGraph.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Class for Dial's algorithm finding the shortest path in a graph with small integer edge weights.
+ *
+ * It is Dijkstra's algorithm with a bucket queue instead of a heap. Tentative distances of found nodes
+ * lie between the current distance and the current distance plus the highest weight C, so C + 1 buckets
+ * indexed by the distance modulo C + 1 are enough. The search runs in O(V + E + D), where D is
+ * the distance of the end node, and never compares distances of two nodes.
+ */
+class DialGraphAlgorithm : public GraphAlgorithm {
+    PathGraph m_graph;
+    StepEventSink* m_event_sink = nullptr; // Receives the changes of the graph, if set
+    std::vector<std::vector<std::size_t>> m_buckets; // Found nodes, bucket i holds distances equal to i modulo the count
+    std::size_t m_queued; // Number of entries in all the buckets, including outdated ones
+    std::uint64_t m_level; // Distance of the nodes in the current bucket
+    std::vector<std::uint64_t> m_distance; // Tentative distance of each node from the start node
+    std::vector<std::size_t> m_entered_by; // Index of the edge each node was entered by
+    bool m_first_step;
+    bool m_found_end;
+
+    /**
+     * Backtracks from the end node and marks the nodes and edges on the shortest path.
+     */
+    void markShortestPath();
+
+    /**
+     * Settles all the nodes of the current bucket and relaxes their outgoing edges.
+     *
+     * @return Number of nodes settled, outdated entries are skipped.
+     */
+    std::size_t settleBucket();
+
+    /**
+     * Changes the state of the node and reports it to the event sink.
+     */
+    void setNodeState(std::size_t node, PathNodeState state);
+
+    /**
+     * Changes the state of the edge and reports it to the event sink.
+     */
+    void setEdgeState(std::size_t edge, PathEdgeState state);
+
+public:
+    /**
+     * Constructor for DialGraphAlgorithm.
+     *
+     * @param graph The graph in which the shortest path is found.
+     */
+    DialGraphAlgorithm(PathGraph&& graph);
+
+    /**
+     * Executes the next step of Dial's algorithm.
+     *
+     * Every step settles the whole next non-empty bucket, all the found nodes with the lowest distance
+     * together with the nodes reached from them over edges of weight 0.
+     *
+     * @return True if there are more steps to be taken, false otherwise.
+     */
+    virtual bool nextStep() override;
+
+    /**
+     * Sets the sink receiving the changes of the states of the nodes and edges.
+     *
+     * @return Always true.
+     */
+    virtual bool setEventSink(StepEventSink* sink) override;
+
+    /**
+     * Returns the current state of the graph.
+     *
+     * @return A constant reference to the current state of the graph.
+     */
+    virtual const Graph& getState() const override;
+
+    /**
+     * Returns the distance of the node from the start node, final for visited nodes.
+     */
+    std::uint64_t getDistance(std::size_t node) const;
+};
+
+#endif
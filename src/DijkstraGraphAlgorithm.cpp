@@ -0,0 +1,118 @@
+#include "DijkstraGraphAlgorithm.hpp"
+#include "PathGraph.hpp"
+
+#include <limits>
+#include <tuple>
+
+static constexpr std::uint64_t infinite_distance = std::numeric_limits<std::uint64_t>::max();
+
+DijkstraGraphAlgorithm::DijkstraGraphAlgorithm(PathGraph&& graph)
+    :   m_graph(std::move(graph)),
+        m_distance(m_graph.node_count, infinite_distance),
+        m_entered_by(m_graph.node_count),
+        m_first_step(true),
+        m_found_end(false) {}
+
+void DijkstraGraphAlgorithm::setNodeState(std::size_t node, PathNodeState state) {
+    m_graph.node_states[node] = state;
+    if (m_event_sink) {
+        m_event_sink->onStepEvent(StepEvent::nodeState(node, state));
+    }
+}
+
+void DijkstraGraphAlgorithm::setEdgeState(std::size_t edge, PathEdgeState state) {
+    m_graph.edge_states[edge] = state;
+    if (m_event_sink) {
+        m_event_sink->onStepEvent(StepEvent::edgeState(edge, state));
+    }
+}
+
+void DijkstraGraphAlgorithm::markShortestPath() {
+    auto& topology = m_graph.getTopology();
+    auto node_index = m_graph.end_node;
+
+    while (node_index != m_graph.start_node) {
+        auto edge_index = m_entered_by[node_index];
+        setEdgeState(edge_index, PathEdgeState::OnShortestPath);
+        node_index = topology.edges[edge_index].from_node_index;
+        if (node_index != m_graph.start_node) {
+            setNodeState(node_index, PathNodeState::OnShortestPath);
+        }
+    }
+}
+
+bool DijkstraGraphAlgorithm::nextStep() {
+    // Lets the renderer draw the initial state of graph
+    if (m_first_step) {
+        m_distance[m_graph.start_node] = 0;
+        m_heap.push(0, m_graph.start_node);
+        m_first_step = false;
+        return true;
+    }
+
+    if (m_found_end) {
+        return false;
+    }
+
+    // Skip entries of nodes which were settled or pushed again with a shorter distance
+    std::size_t node_index;
+    std::uint64_t distance;
+    do {
+        // We are finished
+        if (m_heap.empty()) {
+            return false;
+        }
+        std::tie(distance, node_index) = m_heap.pop();
+    } while (distance != m_distance[node_index] || m_graph.node_states[node_index] == PathNodeState::Visited);
+
+    auto& topology = m_graph.getTopology();
+    setNodeState(node_index, PathNodeState::Visited);
+    if (node_index != m_graph.start_node) {
+        setEdgeState(m_entered_by[node_index], PathEdgeState::Used);
+    }
+
+    // We found the end node
+    if (node_index == m_graph.end_node) {
+        if (node_index == m_graph.start_node) {
+            setNodeState(node_index, PathNodeState::OnShortestPath);
+        }
+        markShortestPath();
+        m_found_end = true;
+        return true;
+    }
+
+    // Else we relax the edges to the neighbours which are not settled yet
+    for (auto edge_index : topology.getOutgoingEdges(node_index)) {
+        auto neighbour_index = topology.edges[edge_index].to_node_index;
+        auto new_distance = distance + topology.edge_weights[edge_index];
+
+        if (m_graph.node_states[neighbour_index] == PathNodeState::Visited || new_distance >= m_distance[neighbour_index]) {
+            continue;
+        }
+
+        // The neighbour was found before over a longer path
+        if (m_graph.node_states[neighbour_index] == PathNodeState::Found) {
+            setEdgeState(m_entered_by[neighbour_index], PathEdgeState::Default);
+        }
+        setEdgeState(edge_index, PathEdgeState::Peeked);
+        setNodeState(neighbour_index, PathNodeState::Found);
+        m_distance[neighbour_index] = new_distance;
+        m_entered_by[neighbour_index] = edge_index;
+        m_heap.push(new_distance, neighbour_index);
+    }
+
+    return true;
+}
+
+bool DijkstraGraphAlgorithm::setEventSink(StepEventSink* sink) {
+    m_event_sink = sink;
+    return true;
+}
+
+const Graph& DijkstraGraphAlgorithm::getState() const {
+    return m_graph;
+}
+
+std::uint64_t DijkstraGraphAlgorithm::getDistance(std::size_t node) const {
+    return m_distance[node];
+}
@@ -0,0 +1,79 @@
+#ifndef DijkstraGraphAlgorithm_hpp
+#define DijkstraGraphAlgorithm_hpp
+
+#include "GraphAlgorithm.hpp"
+#include "PathGraph.hpp"
+#include "RadixHeap.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Class for Dijkstra's algorithm finding the shortest path in a graph with weighted edges.
+ *
+ * Tentative distances are kept in a radix heap with lazy deletion, a node whose distance improves
+ * is pushed again and its older entries are skipped when popped.
+ */
+class DijkstraGraphAlgorithm : public GraphAlgorithm {
+    PathGraph m_graph;
+    StepEventSink* m_event_sink = nullptr; // Receives the changes of the graph, if set
+    RadixHeap<std::size_t> m_heap; // Found nodes keyed by their tentative distance
+    std::vector<std::uint64_t> m_distance; // Tentative distance of each node from the start node
+    std::vector<std::size_t> m_entered_by; // Index of the edge each node was entered by
+    bool m_first_step;
+    bool m_found_end;
+
+    /**
+     * Backtracks from the end node and marks the nodes and edges on the shortest path.
+     */
+    void markShortestPath();
+
+    /**
+     * Changes the state of the node and reports it to the event sink.
+     */
+    void setNodeState(std::size_t node, PathNodeState state);
+
+    /**
+     * Changes the state of the edge and reports it to the event sink.
+     */
+    void setEdgeState(std::size_t edge, PathEdgeState state);
+
+public:
+    /**
+     * Constructor for DijkstraGraphAlgorithm.
+     *
+     * @param graph The graph in which the shortest path is found.
+     */
+    DijkstraGraphAlgorithm(PathGraph&& graph);
+
+    /**
+     * Executes the next step of Dijkstra's algorithm.
+     *
+     * Every step settles the found node closest to the start node and relaxes its outgoing edges.
+     * Edge currently giving the tentative distance of a found node is shown as peeked.
+     *
+     * @return True if there are more steps to be taken, false otherwise.
+     */
+    virtual bool nextStep() override;
+
+    /**
+     * Sets the sink receiving the changes of the states of the nodes and edges.
+     *
+     * @return Always true.
+     */
+    virtual bool setEventSink(StepEventSink* sink) override;
+
+    /**
+     * Returns the current state of the graph.
+     *
+     * @return A constant reference to the current state of the graph.
+     */
+    virtual const Graph& getState() const override;
+
+    /**
+     * Returns the distance of the node from the start node, final for visited nodes.
+     */
+    std::uint64_t getDistance(std::size_t node) const;
+};
+
+#endif
@@ -0,0 +1,223 @@
+#include "DinicGraphAlgorithm.hpp"
+#include "FlowGraph.hpp"
+#include "FlowResidualGraph.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <queue>
+
+static constexpr std::size_t unreached = std::numeric_limits<std::size_t>::max();
+
+DinicGraphAlgorithm::DinicGraphAlgorithm(FlowGraph&& graph)
+    :   m_graph(std::move(graph)),
+        m_start_node(m_graph.start_node),
+        m_end_node(m_graph.end_node),
+        m_level(m_graph.node_count, unreached),
+        m_current_arc(m_graph.node_count, 0),
+        m_max_flow(0),
+        m_next_step_state(NextStepState::CleanGraph) {}
+
+void DinicGraphAlgorithm::setNodeState(std::size_t node, FlowNodeState state) {
+    if (m_graph.node_states[node] == state) {
+        return;
+    }
+    m_graph.node_states[node] = state;
+    if (m_event_sink) {
+        m_event_sink->onStepEvent(StepEvent::nodeState(node, state));
+    }
+}
+
+void DinicGraphAlgorithm::setEdgeState(std::size_t edge, FlowEdgeState state) {
+    if (m_graph.edge_states[edge] == state) {
+        return;
+    }
+    m_graph.edge_states[edge] = state;
+    if (m_event_sink) {
+        m_event_sink->onStepEvent(StepEvent::edgeState(edge, state));
+    }
+}
+
+void DinicGraphAlgorithm::pushFlow(std::size_t arc, std::size_t flow) {
+    pushResidualFlow(m_graph, arc, flow);
+    if (m_event_sink) {
+        auto flow_change = static_cast<std::int64_t>(flow);
+        m_event_sink->onStepEvent(StepEvent::edgeFlow(arc / 2, arc % 2 == 0 ? flow_change : -flow_change));
+    }
+}
+
+bool DinicGraphAlgorithm::buildLevelGraph() {
+    auto& topology = m_graph.getTopology();
+    std::queue<std::size_t> queue;
+    m_level.assign(m_graph.node_count, unreached);
+    m_current_arc.assign(m_graph.node_count, 0);
+
+    queue.push(m_start_node);
+    m_level[m_start_node] = 0;
+
+    while (!queue.empty()) {
+        std::size_t current_node = queue.front();
+        queue.pop();
+
+        // Nodes further than the end node can't be on a shortest augmenting path
+        if (m_level[m_end_node] != unreached && m_level[current_node] >= m_level[m_end_node]) {
+            continue;
+        }
+
+        auto arc_count = getResidualArcCount(topology, current_node);
+        for (std::size_t i = 0; i < arc_count; ++i) {
+            auto arc = getResidualArc(topology, current_node, i);
+            auto to_node = getArcHead(topology, arc);
+
+            if (m_level[to_node] == unreached && getResidualCapacity(m_graph, arc) > 0) {
+                m_level[to_node] = m_level[current_node] + 1;
+                queue.push(to_node);
+            }
+        }
+    }
+
+    return m_level[m_end_node] != unreached;
+}
+
+void DinicGraphAlgorithm::showLevelGraph() {
+    auto& topology = m_graph.getTopology();
+    for (std::size_t node = 0; node < m_graph.node_count; ++node) {
+        if (m_level[node] == unreached || m_level[node] > m_level[m_end_node]) {
+            continue;
+        }
+        setNodeState(node, FlowNodeState::OnUnsaturatedPath);
+
+        auto arc_count = getResidualArcCount(topology, node);
+        for (std::size_t i = 0; i < arc_count; ++i) {
+            auto arc = getResidualArc(topology, node, i);
+            if (m_level[getArcHead(topology, arc)] == m_level[node] + 1 && getResidualCapacity(m_graph, arc) > 0) {
+                setEdgeState(arc / 2, FlowEdgeState::OnUnsaturatedPath);
+            }
+        }
+    }
+}
+
+std::size_t DinicGraphAlgorithm::pushBlockingFlow() {
+    auto& topology = m_graph.getTopology();
+    std::size_t blocking_flow = 0;
+    std::size_t node = m_start_node;
+    m_path.clear();
+
+    while (true) {
+        if (node == m_end_node) {
+            // An empty path has no bottleneck, nothing can be pushed along it
+            if (m_path.empty()) {
+                break;
+            }
+
+            // Find bottleneck capacity along the path
+            std::size_t flow = std::numeric_limits<std::size_t>::max();
+            for (auto arc : m_path) {
+                flow = std::min(flow, getResidualCapacity(m_graph, arc));
+            }
+
+            // Update the flow along the path and retreat to the tail of its first saturated arc
+            std::size_t saturated_position = m_path.size();
+            for (std::size_t i = 0; i < m_path.size(); ++i) {
+                pushFlow(m_path[i], flow);
+                if (saturated_position == m_path.size() && getResidualCapacity(m_graph, m_path[i]) == 0) {
+                    saturated_position = i;
+                }
+            }
+            blocking_flow += flow;
+            node = getArcTail(topology, m_path[saturated_position]);
+            m_path.resize(saturated_position);
+            continue;
+        }
+
+        // Advance along the first admissible arc
+        bool advanced = false;
+        auto arc_count = getResidualArcCount(topology, node);
+        while (m_current_arc[node] < arc_count) {
+            auto arc = getResidualArc(topology, node, m_current_arc[node]);
+            auto to_node = getArcHead(topology, arc);
+            if (m_level[to_node] == m_level[node] + 1 && getResidualCapacity(m_graph, arc) > 0) {
+                m_path.push_back(arc);
+                node = to_node;
+                advanced = true;
+                break;
+            }
+            m_current_arc[node]++;
+        }
+        if (advanced) {
+            continue;
+        }
+
+        // Retreat, the node is a dead end for the rest of the phase
+        if (node == m_start_node) {
+            break;
+        }
+        m_level[node] = unreached;
+        node = getArcTail(topology, m_path.back());
+        m_path.pop_back();
+        m_current_arc[node]++;
+    }
+
+    // Show the new flow
+    for (std::size_t i = 0; i < m_graph.edge_count; ++i) {
+        if (m_graph.edge_flows[i] == topology.edges[i].capacity) {
+            setEdgeState(i, FlowEdgeState::Saturated);
+        }
+    }
+    return blocking_flow;
+}
+
+void DinicGraphAlgorithm::cleanGraph() {
+    auto& topology = m_graph.getTopology();
+    for (std::size_t i = 0; i < m_graph.node_count; ++i) {
+        setNodeState(i, FlowNodeState::Default);
+    }
+    for (std::size_t i = 0; i < m_graph.edge_count; ++i) {
+        if (m_graph.edge_flows[i] == topology.edges[i].capacity) {
+            setEdgeState(i, FlowEdgeState::Saturated);
+        }
+        else {
+            setEdgeState(i, FlowEdgeState::Default);
+        }
+    }
+}
+
+bool DinicGraphAlgorithm::nextStep() {
+    if (m_start_node == m_end_node) {
+        return false;
+    }
+
+    switch (m_next_step_state) {
+        case NextStepState::CleanGraph:
+            cleanGraph();
+            m_next_step_state = NextStepState::LevelGraph;
+            return true;
+        case NextStepState::LevelGraph:
+            // Build the level graph, no more phases if the end node is not reachable
+            if (!buildLevelGraph()) {
+                return false;
+            }
+            showLevelGraph();
+            m_next_step_state = NextStepState::BlockingFlow;
+            return true;
+        case NextStepState::BlockingFlow:
+            m_max_flow += pushBlockingFlow();
+            m_next_step_state = NextStepState::CleanGraph;
+            return true;
+        default:
+            // not gonna happen
+            return false;
+    }
+}
+
+bool DinicGraphAlgorithm::setEventSink(StepEventSink* sink) {
+    m_event_sink = sink;
+    return true;
+}
+
+const Graph& DinicGraphAlgorithm::getState() const {
+    return m_graph;
+}
+
+std::size_t DinicGraphAlgorithm::getMaxFlow() const {
+    return m_max_flow;
+}
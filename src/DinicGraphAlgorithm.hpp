@@ -0,0 +1,101 @@
+#ifndef DinicGraphAlgorithm_hpp
+#define DinicGraphAlgorithm_hpp
+
+#include "FlowGraph.hpp"
+#include "GraphAlgorithm.hpp"
+#include <cstddef>
+#include <vector>
+
+// Class for Dinic's algorithm in a flow graph
+class DinicGraphAlgorithm : public GraphAlgorithm {
+    enum class NextStepState { CleanGraph, LevelGraph, BlockingFlow };
+
+    FlowGraph m_graph;
+    StepEventSink* m_event_sink = nullptr; // Receives the changes of the graph, if set
+    std::size_t m_start_node; // Index of the start node
+    std::size_t m_end_node; // Index of the end node
+    std::vector<std::size_t> m_level; // BFS level of each node in the residual graph
+    std::vector<std::size_t> m_current_arc; // Index of the next residual arc to try from each node
+    std::vector<std::size_t> m_path; // Residual arcs of the path the blocking flow search is on
+    std::size_t m_max_flow;
+    NextStepState m_next_step_state; // Tells nextStep which part of the algorithm should be done next
+
+    /**
+     * Changes the state of the node and reports it to the event sink, if the state differs.
+     */
+    void setNodeState(std::size_t node, FlowNodeState state);
+
+    /**
+     * Changes the state of the edge and reports it to the event sink, if the state differs.
+     */
+    void setEdgeState(std::size_t edge, FlowEdgeState state);
+
+    /**
+     * Sends the flow along the residual arc and reports the change of the flow of its edge to the event sink.
+     */
+    void pushFlow(std::size_t arc, std::size_t flow);
+
+    /**
+     * Resets the states of the nodes and edges, only saturated edges stay marked.
+     */
+    void cleanGraph();
+
+    /**
+     * Builds the level graph by BFS from the start node over the residual graph.
+     *
+     * @return True if the end node is reachable, false otherwise.
+     */
+    bool buildLevelGraph();
+
+    /**
+     * Helper function to show nodes and edges of the level graph.
+     */
+    void showLevelGraph();
+
+    /**
+     * Finds a blocking flow in the level graph using current-arc pointers and updates the flow.
+     *
+     * @return The value of the blocking flow.
+     */
+    std::size_t pushBlockingFlow();
+
+public:
+    /**
+     * Constructor for DinicGraphAlgorithm.
+     *
+     * @param graph The flow graph in which the maximal flow is found.
+     */
+    DinicGraphAlgorithm(FlowGraph&& graph);
+
+    /**
+     * Executes the next step of Dinic's algorithm.
+     *
+     * Every phase takes three steps. The graph is cleaned, the level graph is built and shown
+     * and then a blocking flow is pushed through it. Phases repeat until the end node
+     * is not reachable in the residual graph.
+     *
+     * @return True if there are more steps to be taken, false otherwise.
+     */
+    virtual bool nextStep() override;
+
+    /**
+     * Sets the sink receiving the changes of the states of the nodes and edges and of the flows.
+     *
+     * @return Always true.
+     */
+    virtual bool setEventSink(StepEventSink* sink) override;
+
+    /**
+     * Returns the current state of the graph.
+     *
+     * @return A constant reference to the current state of the graph.
+     */
+    virtual const Graph& getState() const override;
+
+    /**
+     * Returns the value of the flow found so far, the maximal flow once the algorithm is finished.
+     */
+    std::size_t getMaxFlow() const;
+};
+
+#endif
@@ -2,18 +2,18 @@
 #include "FlowGraph.hpp"
 #include "DrawHelpers.hpp"
 
+#include <algorithm>
 #include <cstddef>
 
 FlowNode::FlowNode(std::size_t pos_x, std::size_t pos_y, std::size_t size, 
-        FlowNodeColorPalette palette, FlowNodeState state, FlowNodeType type)
+        FlowNodeColorPalette palette, FlowNodeType type)
     :   pos_x(pos_x), 
         pos_y(pos_y),
         m_size(size),
         m_color_palette(palette),
-        state(state),
         type(type) {}
 
-Color FlowNode::getNodeColor() const {
+Color FlowNode::getNodeColor(FlowNodeState state) const {
     if (type == FlowNodeType::Start) {
         return m_color_palette.start_node_color;
     }
@@ -21,7 +21,7 @@ Color FlowNode::getNodeColor() const {
         return m_color_palette.end_node_color;
     }
 
-    if (state == FlowNodeState::OnUnsaturatedPath) {
+    if (state == FlowNodeState::OnUnsaturatedPath || state == FlowNodeState::HasExcess) {
         return m_color_palette.on_unsaturated_path_color;
     }
 
@@ -29,20 +29,45 @@ Color FlowNode::getNodeColor() const {
 }
 
 void FlowNode::draw(Frame& frame) const {
+    draw(frame, FlowNodeState::Default);
+}
+
+void FlowNode::draw(Frame& frame, FlowNodeState state) const {
     auto half_size = m_size / 2;
     auto top_left_x = pos_x - half_size;
     auto top_left_y = pos_y - half_size;
     auto bottom_right_x = pos_x + half_size;
     auto bottom_right_y = pos_y + half_size;
 
-    auto node_color = getNodeColor();
+    auto node_color = getNodeColor(state);
 
     frame.drawRectangle(top_left_x, top_left_y, bottom_right_x, bottom_right_y, node_color);
 }
 
+void FlowNode::draw(Frame& frame, FlowNodeState state, std::size_t level, std::size_t max_level) const {
+    draw(frame, state);
+    if (type != FlowNodeType::Normal || max_level == 0) {
+        return;
+    }
+
+    // Bar grows from the bottom of the node in the color of the other node state
+    auto half_size = m_size / 2;
+    auto bar_size = (std::size_t)(2 * half_size * ((double)std::min(level, max_level) / max_level));
+    auto bar_color = (state == FlowNodeState::Default) 
+        ? m_color_palette.on_unsaturated_path_color 
+        : m_color_palette.default_node_color;
+
+    frame.drawRectangle(
+        pos_x - half_size, 
+        pos_y + half_size - bar_size, 
+        pos_x + half_size, 
+        pos_y + half_size, 
+        bar_color);
+}
+
 FlowEdge::FlowEdge(std::size_t from, std::size_t to, std::size_t length, 
     std::size_t width, std::size_t border_width, std::size_t pos_x, std::size_t pos_y,
-    bool is_horizontal, bool direction_from_top_left, std::size_t capacity, FlowEdgeState state, FlowEdgeColorPalette palette)
+    bool is_horizontal, bool direction_from_top_left, std::size_t capacity, FlowEdgeColorPalette palette)
     :   from_node_index(from), 
         to_node_index(to), 
         m_length(length),
@@ -51,13 +76,11 @@ FlowEdge::FlowEdge(std::size_t from, std::size_t to, std::size_t length,
         m_pos_x(pos_x), 
         m_pos_y(pos_y),
         capacity(capacity),
-        current_flow(0),
         m_is_horizontal(is_horizontal), 
         m_direction_from_top_left(direction_from_top_left),
-        state(state),
         m_color_palette(palette) {}
 
-Color FlowEdge::getEdgeColor() const {
+Color FlowEdge::getEdgeColor(FlowEdgeState state) const {
     if (state == FlowEdgeState::OnUnsaturatedPath) {
         return m_color_palette.on_unsaturated_path_color;
     }
@@ -71,6 +94,10 @@ Color FlowEdge::getEdgeColor() const {
 
 
 void FlowEdge::draw(Frame& frame) const {
+    draw(frame, FlowEdgeState::Default, 0);
+}
+
+void FlowEdge::draw(Frame& frame, FlowEdgeState state, std::size_t current_flow) const {
     auto horizontal_half_size = m_is_horizontal ? m_length / 2 : m_width / 2;
     auto vertical_half_size = m_is_horizontal ? m_width / 2 : m_length / 2;
 
@@ -81,7 +108,7 @@ void FlowEdge::draw(Frame& frame) const {
     auto bottom_right_x = m_pos_x + horizontal_half_size;
     auto bottom_right_y = m_pos_y + vertical_half_size;
 
-    Color edge_color = getEdgeColor();
+    Color edge_color = getEdgeColor(state);
     Color border_offset = m_color_palette.border_color_offset;
     Color border_color = Color(
         std::max<std::size_t>(edge_color.R - border_offset.R, 0),
@@ -170,27 +197,43 @@ void FlowEdge::draw(Frame& frame) const {
     }
 }
 
-void FlowGraph::draw(Frame& frame) const {
-    frame.drawRectangle(
-        0, 
-        0, 
-        frame.width(),
-        frame.height(), 
-        m_background_color
-    );
+void FlowEdge::clear(Frame& frame, const Color& background_color) const {
+    auto horizontal_half_size = m_is_horizontal ? m_length / 2 : m_width / 2;
+    auto vertical_half_size = m_is_horizontal ? m_width / 2 : m_length / 2;
 
-    for (std::size_t i = 0; i < edge_count; ++i) {
-        FlowEdge edge = edges[i];
-        edge.draw(frame);
-    }
+    auto top_left_x = m_pos_x - horizontal_half_size;
+    auto top_left_y = m_pos_y - vertical_half_size;
+    auto bottom_right_x = m_pos_x + horizontal_half_size;
+    auto bottom_right_y = m_pos_y + vertical_half_size;
 
-    for (std::size_t i = 0; i < node_count; ++i) {
-        FlowNode node = nodes[i];
-        node.draw(frame);
+    // The same areas as the borders, the inner flow and the arrow in draw() cover
+    auto arrow_width = m_is_horizontal ? m_border_width * 2 : m_border_width * 3;
+    auto arrow_height = m_is_horizontal ? m_border_width * 3 : m_border_width * 2;
+    if (m_is_horizontal) {
+        frame.drawRectangle(
+            top_left_x,
+            top_left_y - m_border_width,
+            std::max(top_left_x + m_length, bottom_right_x),
+            bottom_right_y + m_border_width,
+            background_color);
+    }
+    else {
+        frame.drawRectangle(
+            top_left_x - m_border_width,
+            std::min(top_left_y, bottom_right_y - m_length),
+            bottom_right_x + m_border_width,
+            bottom_right_y,
+            background_color);
     }
+    frame.drawRectangle(
+        m_pos_x - arrow_width / 2,
+        m_pos_y - arrow_height / 2,
+        m_pos_x + arrow_width / 2 + arrow_width % 2,
+        m_pos_y + arrow_height / 2 + arrow_height % 2,
+        background_color);
 }
 
-std::pair<std::size_t, std::size_t> FlowGraph::getNodePosition(
+std::pair<std::size_t, std::size_t> FlowGraphTopology::getNodePosition(
     std::pair<std::size_t, std::size_t> indecies,
     const FlowGraphConfig& config) const {
 
@@ -228,7 +271,7 @@ static bool isEdgeDirectionFromTopLeft(const FlowNode& from, const FlowNode& to,
     return false;
 } 
 
-void FlowGraph::populateNodesAndEdges(const FlowGraphConfig& config) {
+void FlowGraphTopology::populateNodesAndEdges(const FlowGraphConfig& config) {
     for (std::size_t i = 0; i < node_count; ++i) {
         auto position = getNodePosition(config.nodes[i], config);
 
@@ -240,7 +283,6 @@ void FlowGraph::populateNodesAndEdges(const FlowGraphConfig& config) {
             position.second,
             config.node_size,
             config.node_color_palette,
-            FlowNodeState::Default,
             type
         );
     }
@@ -268,22 +310,189 @@ void FlowGraph::populateNodesAndEdges(const FlowGraphConfig& config) {
             is_horizontal,
             direction_from_top_left,
             edge_capacity,
-            FlowEdgeState::Default,
             config.edge_color_palette
         );
+    }
+
+    // Group outgoing edges by their nodes, keeping the order of the config within each node
+    m_outgoing_offsets.assign(node_count + 1, 0);
+    for (auto& edge : edges) {
+        m_outgoing_offsets[edge.from_node_index + 1]++;
+    }
+    for (std::size_t i = 0; i < node_count; ++i) {
+        m_outgoing_offsets[i + 1] += m_outgoing_offsets[i];
+    }
+    m_outgoing_edges.resize(edge_count);
+    std::vector<std::size_t> next_position(m_outgoing_offsets.begin(), m_outgoing_offsets.end() - 1);
+    for (std::size_t i = 0; i < edge_count; ++i) {
+        m_outgoing_edges[next_position[edges[i].from_node_index]++] = i;
+    }
 
-        nodes[from_index].edges.push_back(i);
+    // The same for incoming edges
+    m_incoming_offsets.assign(node_count + 1, 0);
+    for (auto& edge : edges) {
+        m_incoming_offsets[edge.to_node_index + 1]++;
+    }
+    for (std::size_t i = 0; i < node_count; ++i) {
+        m_incoming_offsets[i + 1] += m_incoming_offsets[i];
+    }
+    m_incoming_edges.resize(edge_count);
+    next_position.assign(m_incoming_offsets.begin(), m_incoming_offsets.end() - 1);
+    for (std::size_t i = 0; i < edge_count; ++i) {
+        m_incoming_edges[next_position[edges[i].to_node_index]++] = i;
     }
 }
 
-FlowGraph::FlowGraph(const FlowGraphConfig& config) 
-    :   m_background_color(config.background_color),
-        edge_count(config.edges.size()),
+FlowGraphTopology::FlowGraphTopology(const FlowGraphConfig& config) 
+    :   edge_count(config.edges.size()),
         node_count(config.nodes.size()),
         start_node(config.start_node),
         end_node(config.end_node),
-        nodes(config.nodes.size()),
-        edges(config.edges.size()) {
+        background_color(config.background_color),
+        edges(config.edges.size()),
+        nodes(config.nodes.size()) {
 
     populateNodesAndEdges(config);
 }
+
+std::span<const std::size_t> FlowGraphTopology::getOutgoingEdges(std::size_t node) const {
+    return std::span<const std::size_t>(
+        m_outgoing_edges.data() + m_outgoing_offsets[node],
+        m_outgoing_offsets[node + 1] - m_outgoing_offsets[node]);
+}
+
+std::span<const std::size_t> FlowGraphTopology::getIncomingEdges(std::size_t node) const {
+    return std::span<const std::size_t>(
+        m_incoming_edges.data() + m_incoming_offsets[node],
+        m_incoming_offsets[node + 1] - m_incoming_offsets[node]);
+}
+
+FlowGraph::FlowGraph(std::shared_ptr<const FlowGraphTopology> topology)
+    :   m_topology(std::move(topology)),
+        edge_count(m_topology->edge_count),
+        node_count(m_topology->node_count),
+        start_node(m_topology->start_node),
+        end_node(m_topology->end_node),
+        node_states(m_topology->node_count, FlowNodeState::Default),
+        edge_states(m_topology->edge_count, FlowEdgeState::Default),
+        edge_flows(m_topology->edge_count, 0),
+        node_levels(m_topology->node_count, 0),
+        max_node_level(0) {}
+
+const FlowGraphTopology& FlowGraph::getTopology() const {
+    return *m_topology;
+}
+
+void FlowGraph::draw(Frame& frame) const {
+    frame.drawRectangle(
+        0, 
+        0, 
+        frame.width(),
+        frame.height(), 
+        m_topology->background_color
+    );
+
+    for (std::size_t i = 0; i < edge_count; ++i) {
+        m_topology->edges[i].draw(frame, edge_states[i], edge_flows[i]);
+    }
+
+    for (std::size_t i = 0; i < node_count; ++i) {
+        m_topology->nodes[i].draw(frame, node_states[i], node_levels[i], max_node_level);
+    }
+}
+
+bool FlowGraph::drawChange(Frame& frame, const StepEvent& event) const {
+    auto& topology = *m_topology;
+
+    if (event.type == StepEvent::Type::NodeState) {
+        topology.nodes[event.index].draw(frame, node_states[event.index], node_levels[event.index], max_node_level);
+        return true;
+    }
+
+    auto from = topology.edges[event.index].from_node_index;
+    auto to = topology.edges[event.index].to_node_index;
+    topology.edges[event.index].clear(frame, topology.background_color);
+
+    // Edges between the same nodes cover the same area, they are drawn again in the order of draw()
+    std::vector<std::size_t> overlapping;
+    for (auto edge_index : topology.getOutgoingEdges(from)) {
+        if (topology.edges[edge_index].to_node_index == to) {
+            overlapping.push_back(edge_index);
+        }
+    }
+    for (auto edge_index : topology.getOutgoingEdges(to)) {
+        if (topology.edges[edge_index].to_node_index == from) {
+            overlapping.push_back(edge_index);
+        }
+    }
+    std::sort(overlapping.begin(), overlapping.end());
+    for (auto edge_index : overlapping) {
+        topology.edges[edge_index].draw(frame, edge_states[edge_index], edge_flows[edge_index]);
+    }
+
+    topology.nodes[from].draw(frame, node_states[from], node_levels[from], max_node_level);
+    topology.nodes[to].draw(frame, node_states[to], node_levels[to], max_node_level);
+    return true;
+}
+
+std::unique_ptr<Graph> FlowGraph::clone() const {
+    return std::make_unique<FlowGraph>(*this);
+}
+
+bool FlowGraph::applyChange(const StepEvent& event) {
+    if (event.type == StepEvent::Type::NodeState) {
+        if (event.index >= node_count) {
+            return false;
+        }
+        node_states[event.index] = static_cast<FlowNodeState>(event.state);
+        return true;
+    }
+    if (event.index >= edge_count) {
+        return false;
+    }
+    if (event.type == StepEvent::Type::EdgeState) {
+        edge_states[event.index] = static_cast<FlowEdgeState>(event.state);
+    }
+    else {
+        edge_flows[event.index] += event.flow_change;
+    }
+    return true;
+}
+
+bool FlowGraph::describeState(StepEventSink& sink) const {
+    if (max_node_level != 0) {
+        return false;
+    }
+    for (std::size_t node = 0; node < node_count; ++node) {
+        if (node_states[node] != FlowNodeState::Default) {
+            sink.onStepEvent(StepEvent::nodeState(node, node_states[node]));
+        }
+    }
+    for (std::size_t edge = 0; edge < edge_count; ++edge) {
+        if (edge_states[edge] != FlowEdgeState::Default) {
+            sink.onStepEvent(StepEvent::edgeState(edge, edge_states[edge]));
+        }
+        if (edge_flows[edge] != 0) {
+            sink.onStepEvent(StepEvent::edgeFlow(edge, static_cast<std::int64_t>(edge_flows[edge])));
+        }
+    }
+    return true;
+}
+
+std::size_t FlowGraph::getFlowValue() const {
+    auto& topology = *m_topology;
+    std::size_t leaving = 0;
+    std::size_t entering = 0;
+
+    for (auto edge : topology.getOutgoingEdges(start_node)) {
+        leaving += edge_flows[edge];
+    }
+    for (auto edge : topology.getIncomingEdges(start_node)) {
+        entering += edge_flows[edge];
+    }
+    return leaving - entering;
+}
+
+void FlowGraph::printResult(std::ostream& output) const {
+    output << "Maximal flow: " << getFlowValue() << std::endl;
+}
\ No newline at end of file
@@ -5,10 +5,12 @@
 #include "Graph.hpp"
 #include "Node.hpp"
 #include <cstddef>
+#include <memory>
+#include <span>
 #include <vector>
 
 // Enumeration representing the state of a flow node
-enum class FlowNodeState { Default, OnUnsaturatedPath };
+enum class FlowNodeState { Default, OnUnsaturatedPath, HasExcess };
 
 // Enumeration representing the type of a flow node
 enum class FlowNodeType { Normal, Start, End };
@@ -33,17 +35,15 @@ struct FlowEdgeColorPalette {
     arrow_color;
 };
 
-// Class representing a node in the flow graph.
+// Class representing the layout of a node in the flow graph.
 class FlowNode : public Node {
     std::size_t m_size;
     FlowNodeColorPalette m_color_palette;
 
-    Color getNodeColor() const;
+    Color getNodeColor(FlowNodeState state) const;
 public: 
     std::size_t pos_x, pos_y;
-    FlowNodeState state;
     FlowNodeType type;
-    std::vector<std::size_t> edges; // List of edges connected to the node
 
     // Default constructor for FlowNode
     FlowNode() {};
@@ -55,21 +55,38 @@ public:
      * @param pos_y y-coordinate of the node center position.
      * @param size Size of the node.
      * @param palette Color palette for the node.
-     * @param state State of the node.
      * @param type Type of the node.
      */
     FlowNode(std::size_t pos_x, std::size_t pos_y, std::size_t size,
-        FlowNodeColorPalette palette, FlowNodeState state, FlowNodeType type);
+        FlowNodeColorPalette palette, FlowNodeType type);
+
+    /**
+     * Draws the flow node in the given state on the given frame.
+     *
+     * @param frame The frame on which the node should be drawn.
+     * @param state State of the node.
+     */
+    void draw(Frame& frame, FlowNodeState state) const;
+
+    /**
+     * Draws the flow node in the given state with a bar showing its level (e.g. height in push-relabel).
+     *
+     * @param frame The frame on which the node should be drawn.
+     * @param state State of the node.
+     * @param level Level of the node.
+     * @param max_level Level at which the bar fills the whole node.
+     */
+    void draw(Frame& frame, FlowNodeState state, std::size_t level, std::size_t max_level) const;
     
     /**
-     * Draws the flow node on the given frame.
+     * Draws the flow node in the default state on the given frame.
      *
      * @param frame The frame on which the node should be drawn.
      */
     virtual void draw(Frame& frame) const override;
 };
 
-// Class representing an edge in the flow graph.
+// Class representing the layout of an edge in the flow graph.
 class FlowEdge : public Edge {
     FlowEdgeColorPalette m_color_palette;
     std::size_t m_length, m_width, m_border_width; 
@@ -77,10 +94,9 @@ class FlowEdge : public Edge {
     bool m_is_horizontal;
     bool m_direction_from_top_left; // True if direction of the edge is from top down or left to right
 
-    Color getEdgeColor() const;
+    Color getEdgeColor(FlowEdgeState state) const;
 public:
-    std::size_t capacity, current_flow;
-    FlowEdgeState state;
+    std::size_t capacity;
     std::size_t from_node_index;
     std::size_t to_node_index;
 
@@ -100,16 +116,33 @@ public:
      * @param is_horizontal True if the edge is horizontal, false otherwise.
      * @param direction_from_top_left True if direction of the edge is from top down or left to right, false otherwise.
      * @param capacity Capacity of the edge.
-     * @param state State of the edge.
      * @param palette Color palette for the edge.
      */
     FlowEdge(std::size_t from, std::size_t to, std::size_t length,
         std::size_t width, std::size_t border_width, std::size_t pos_x, std::size_t pos_y,
-        bool is_horizontal, bool direction_from_top_left, std::size_t capacity, FlowEdgeState state, 
+        bool is_horizontal, bool direction_from_top_left, std::size_t capacity, 
         FlowEdgeColorPalette palette);
 
     /**
-     * Draws the flow edge on the given frame.
+     * Draws the flow edge in the given state on the given frame.
+     *
+     * @param frame The frame on which the edge should be drawn.
+     * @param state State of the edge.
+     * @param current_flow Current flow through the edge.
+     */
+    void draw(Frame& frame, FlowEdgeState state, std::size_t current_flow) const;
+
+    /**
+     * Paints the area of the flow edge including its borders and arrow with the background color,
+     * so it can be drawn again.
+     *
+     * @param frame The frame on which the edge was drawn.
+     * @param background_color Background color of the graph.
+     */
+    void clear(Frame& frame, const Color& background_color) const;
+
+    /**
+     * Draws the flow edge in the default state without any flow on the given frame.
      *
      * @param frame The frame on which the edge should be drawn.
      */
@@ -136,9 +169,18 @@ struct FlowGraphConfig {
     std::size_t frame_delay; // Frame delay in tens of miliseconds
 };
 
-// Class representing a flow graph, derived from the Graph base class
-class FlowGraph : public Graph {
-    Color m_background_color;
+/**
+ * Class representing the immutable topology and layout of a flow graph.
+ *
+ * It is built once from the configuration and shared (read-only) by any number of FlowGraph
+ * states, so several algorithm runs on one input don't have to rebuild it. Outgoing and incoming
+ * edges of all nodes are stored in contiguous arrays.
+ */
+class FlowGraphTopology {
+    std::vector<std::size_t> m_outgoing_edges; // Outgoing edges of all the nodes, grouped by node
+    std::vector<std::size_t> m_outgoing_offsets; // Start of outgoing edges of each node in m_outgoing_edges
+    std::vector<std::size_t> m_incoming_edges; // Incoming edges of all the nodes, grouped by node
+    std::vector<std::size_t> m_incoming_offsets; // Start of incoming edges of each node in m_incoming_edges
 
      /**
      * Populates the nodes and edges of the graph based on the configuration.
@@ -163,10 +205,63 @@ public:
     std::size_t node_count;
     std::size_t start_node; // Index of the start node
     std::size_t end_node; // Index of the end node
+    Color background_color; // Background color of the graph
     std::vector<FlowEdge> edges;
     std::vector<FlowNode> nodes;
 
-    FlowGraph(const FlowGraphConfig& config);
+    /**
+     * Constructor for FlowGraphTopology.
+     *
+     * @param config The configuration for the flow graph.
+     */
+    FlowGraphTopology(const FlowGraphConfig& config);
+
+    /**
+     * Returns indices of the edges leaving the given node.
+     *
+     * @param node Index of the node.
+     * @return A view of the edge indices.
+     */
+    std::span<const std::size_t> getOutgoingEdges(std::size_t node) const;
+
+    /**
+     * Returns indices of the edges entering the given node.
+     * They are needed for walking the residual graph backwards along edges with flow.
+     *
+     * @param node Index of the node.
+     * @return A view of the edge indices.
+     */
+    std::span<const std::size_t> getIncomingEdges(std::size_t node) const;
+};
+
+// Class representing the state of a run of an algorithm on a flow graph, derived from the Graph base class
+class FlowGraph : public Graph {
+    std::shared_ptr<const FlowGraphTopology> m_topology; // Shared topology and layout of the graph
+
+public:
+    std::size_t edge_count;
+    std::size_t node_count;
+    std::size_t start_node; // Index of the start node
+    std::size_t end_node; // Index of the end node
+    std::vector<FlowNodeState> node_states; // State of each node
+    std::vector<FlowEdgeState> edge_states; // State of each edge
+    std::vector<std::size_t> edge_flows; // Current flow through each edge
+    std::vector<std::size_t> node_levels; // Level of each node shown as a bar, only if max_node_level isn't 0
+    std::size_t max_node_level; // Level at which the bar fills the whole node
+
+    /**
+     * Constructor for FlowGraph. All nodes and edges start in their default state without any flow.
+     *
+     * @param topology The shared topology of the flow graph.
+     */
+    FlowGraph(std::shared_ptr<const FlowGraphTopology> topology);
+
+    /**
+     * Returns the topology of the graph.
+     *
+     * @return A constant reference to the shared topology.
+     */
+    const FlowGraphTopology& getTopology() const;
 
     /**
      * Draws the flow graph on the given frame.
@@ -174,6 +269,47 @@ public:
      * @param frame The frame on which the flow graph should be drawn.
      */
     virtual void draw(Frame& frame) const override;
+
+    /**
+     * Redraws the node or the edge changed by the event. An edge is drawn again together with
+     * the edge going the other way between the same nodes and both its nodes, as they overlap it.
+     *
+     * @param frame The frame holding the drawing of the flow graph from before the step.
+     * @param event The change made by the step.
+     * @return Always true, flow graphs can draw every change on its own.
+     */
+    virtual bool drawChange(Frame& frame, const StepEvent& event) const override;
+
+    /**
+     * Returns a copy of the states and flows, the topology is shared with the copy.
+     */
+    virtual std::unique_ptr<Graph> clone() const override;
+
+    /**
+     * Changes the state of the node or the edge or the flow of the edge as described by the event.
+     *
+     * @return False for nodes and edges outside the graph, true otherwise.
+     */
+    virtual bool applyChange(const StepEvent& event) override;
+
+    /**
+     * Reports the states of the nodes and edges that are not in the default state and the flows.
+     *
+     * @return False if some node has a level, which isn't described by changes, true otherwise.
+     */
+    virtual bool describeState(StepEventSink& sink) const override;
+
+    /**
+     * Returns the value of the flow, the flow leaving the start node minus the flow entering it.
+     */
+    std::size_t getFlowValue() const;
+
+    /**
+     * Prints the value of the flow.
+     *
+     * @param output The stream the result is printed to.
+     */
+    virtual void printResult(std::ostream& output) const override;
 };
 
-#endif
\ No newline at end of file
+#endif
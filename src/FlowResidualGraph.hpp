@@ -0,0 +1,87 @@
+#ifndef FlowResidualGraph_hpp
+#define FlowResidualGraph_hpp
+
+#include "FlowGraph.hpp"
+#include <cstddef>
+
+// Helper functions for walking the residual graph of a flow graph.
+//
+// Residual arcs of a node are its outgoing edges (forward arcs) followed by its incoming
+// edges (backward arcs, which cancel flow). An arc is encoded as edge index * 2,
+// plus 1 if it goes against the direction of the edge.
+
+/**
+ * Returns the number of residual arcs leaving the node.
+ *
+ * @param topology The topology of the flow graph.
+ * @param node Index of the node.
+ * @return The number of residual arcs.
+ */
+inline std::size_t getResidualArcCount(const FlowGraphTopology& topology, std::size_t node) {
+    return topology.getOutgoingEdges(node).size() + topology.getIncomingEdges(node).size();
+}
+
+/**
+ * Returns the residual arc of the node on the given position.
+ *
+ * @param topology The topology of the flow graph.
+ * @param node Index of the node.
+ * @param position Position of the arc within the arcs of the node.
+ * @return The encoded arc.
+ */
+inline std::size_t getResidualArc(const FlowGraphTopology& topology, std::size_t node, std::size_t position) {
+    auto outgoing = topology.getOutgoingEdges(node);
+    if (position < outgoing.size()) {
+        return outgoing[position] * 2;
+    }
+    return topology.getIncomingEdges(node)[position - outgoing.size()] * 2 + 1;
+}
+
+/**
+ * Returns the node the residual arc leads to.
+ */
+inline std::size_t getArcHead(const FlowGraphTopology& topology, std::size_t arc) {
+    auto& edge = topology.edges[arc / 2];
+    return (arc % 2 == 0) ? edge.to_node_index : edge.from_node_index;
+}
+
+/**
+ * Returns the node the residual arc leaves from.
+ */
+inline std::size_t getArcTail(const FlowGraphTopology& topology, std::size_t arc) {
+    auto& edge = topology.edges[arc / 2];
+    return (arc % 2 == 0) ? edge.from_node_index : edge.to_node_index;
+}
+
+/**
+ * Returns the residual capacity of the arc.
+ *
+ * @param graph The flow graph with the current flow.
+ * @param arc The encoded arc.
+ * @return How much more flow can be sent along the arc.
+ */
+inline std::size_t getResidualCapacity(const FlowGraph& graph, std::size_t arc) {
+    auto edge_index = arc / 2;
+    if (arc % 2 == 0) {
+        return graph.getTopology().edges[edge_index].capacity - graph.edge_flows[edge_index];
+    }
+    return graph.edge_flows[edge_index];
+}
+
+/**
+ * Sends flow along the residual arc, increasing or cancelling the flow of its edge.
+ *
+ * @param graph The flow graph with the current flow.
+ * @param arc The encoded arc.
+ * @param flow Amount of flow to be sent, at most the residual capacity of the arc.
+ */
+inline void pushResidualFlow(FlowGraph& graph, std::size_t arc, std::size_t flow) {
+    if (arc % 2 == 0) {
+        graph.edge_flows[arc / 2] += flow;
+    }
+    else {
+        graph.edge_flows[arc / 2] -= flow;
+    }
+}
+
+#endif
@@ -0,0 +1,174 @@
+#include "FlowGraph.hpp"
+#include "FlowGraphConfigLoader.hpp"
+#include "FordFulkersonGraphAlgorithm.hpp"
+#include "StepEvent.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+
+// Check that the steps of Ford-Fulkerson after the first one don't allocate any memory
+
+static std::size_t allocation_count = 0;
+
+void* operator new(std::size_t size) {
+    ++allocation_count;
+    if (auto pointer = std::malloc(size ? size : 1)) {
+        return pointer;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+
+// Event sink counting the changes without storing them, so it doesn't allocate
+class CountingEventSink : public StepEventSink {
+public:
+    std::size_t event_count = 0;
+
+    virtual void onStepEvent(const StepEvent&) override {
+        ++event_count;
+    }
+};
+
+void printHelp(const std::string& command) {
+    std::cout << "Usage: " << command << " [FLOW_CONFIG_FILE | WIDTHxHEIGHT]" << std::endl;
+    std::cout << "Check that FF-BFS and FF-SCALING don't allocate memory after their first step" << std::endl;
+    std::cout << "on the flow graph from FLOW_CONFIG_FILE or on a random WIDTHxHEIGHT grid flow network (100x100 by default)." << std::endl;
+}
+
+/**
+ * Creates a random flow network on a grid with the start node in the top left corner and the end node
+ * in the bottom right corner. Every cell is connected to its right and bottom neighbour, some of them
+ * in both directions. The same size always gives the same network.
+ */
+FlowGraphConfig createGridFlowConfig(std::size_t width, std::size_t height) {
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<std::size_t> capacity(1, 100);
+    std::bernoulli_distribution backward(0.3);
+
+    FlowGraphConfig config{};
+    config.grid_width = width;
+    config.grid_height = height;
+    config.node_size = 10;
+    config.edge_length = 10;
+    config.edge_width = 10;
+    config.max_capacity = 100;
+    config.frame_delay = 1;
+
+    for (std::size_t y = 0; y < height; ++y) {
+        for (std::size_t x = 0; x < width; ++x) {
+            config.nodes.emplace_back(x, y);
+        }
+    }
+    for (std::size_t y = 0; y < height; ++y) {
+        for (std::size_t x = 0; x < width; ++x) {
+            auto node = y * width + x;
+            if (x + 1 < width) {
+                config.edges.push_back({{node, node + 1}, capacity(generator)});
+                if (backward(generator)) {
+                    config.edges.push_back({{node + 1, node}, capacity(generator)});
+                }
+            }
+            if (y + 1 < height) {
+                config.edges.push_back({{node, node + width}, capacity(generator)});
+                if (backward(generator)) {
+                    config.edges.push_back({{node + width, node}, capacity(generator)});
+                }
+            }
+        }
+    }
+    config.start_node = 0;
+    config.end_node = width * height - 1;
+    return config;
+}
+
+/**
+ * Runs the algorithm to the end and returns the number of allocations after its first step.
+ * The first step starts the coroutine of the algorithm, which allocates its frame.
+ */
+std::size_t countSteadyAllocations(FordFulkersonGraphAlgorithm& algorithm, std::size_t& step_count) {
+    step_count = algorithm.nextStep() ? 1 : 0;
+    auto allocations_before = allocation_count;
+    while (algorithm.nextStep()) {
+        ++step_count;
+    }
+    return allocation_count - allocations_before;
+}
+
+int main(int argc, const char *argv[]) {
+    if (argc > 2 || (argc == 2 && std::string(argv[1]) == "--help")) {
+        printHelp(argv[0]);
+        return (argc == 2) ? 0 : 1;
+    }
+
+    try {
+        FlowGraphConfig config;
+        std::string input = (argc == 2) ? argv[1] : "100x100";
+        auto separator = input.find('x');
+        std::ifstream input_stream(input);
+
+        if (input_stream.good()) {
+            config = loadFlowGraphConfig(input_stream);
+        }
+        else if (separator != std::string::npos) {
+            config = createGridFlowConfig(std::stoul(input.substr(0, separator)), std::stoul(input.substr(separator + 1)));
+        }
+        else {
+            std::cout << "Error: Can not open file: \"" << input << "\"" << std::endl;
+            return 1;
+        }
+
+        auto topology = std::make_shared<const FlowGraphTopology>(config);
+        std::cout << "Nodes: " << topology->nodes.size() << ", edges: " << topology->edges.size() << std::endl;
+
+        bool all_passed = true;
+        for (bool capacity_scaling : {false, true}) {
+            for (bool reports_events : {false, true}) {
+                FordFulkersonGraphAlgorithm algorithm(FlowGraph(topology), capacity_scaling);
+                CountingEventSink sink;
+                if (reports_events) {
+                    algorithm.setEventSink(&sink);
+                }
+
+                std::size_t step_count = 0;
+                auto allocations = countSteadyAllocations(algorithm, step_count);
+                std::cout << (capacity_scaling ? "FF-SCALING" : "FF-BFS") << (reports_events ? " with events" : "")
+                    << ": " << step_count << " steps, flow " << algorithm.getMaxFlow() << ", "
+                    << allocations << " allocations after the first step" << std::endl;
+
+                if (allocations != 0) {
+                    std::cout << "Error: Steps of the algorithm allocate memory" << std::endl;
+                    all_passed = false;
+                }
+            }
+        }
+        return all_passed ? 0 : 1;
+    }
+    catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
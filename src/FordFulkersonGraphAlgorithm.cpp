@@ -1,40 +1,93 @@
 
 #include "FordFulkersonGraphAlgorithm.hpp"
 #include "FlowGraph.hpp"
+#include "FlowResidualGraph.hpp"
 
+#include <algorithm>
+#include <cstdint>
 #include <limits>
-#include <queue>
-#include <stdexcept>
 
-FordFulkersonGraphAlgorithm::FordFulkersonGraphAlgorithm(FlowGraph&& graph)
-    :   m_graph(graph),
-        m_start_node(graph.start_node),
-        m_end_node(graph.end_node),
+static constexpr std::size_t no_arc = std::numeric_limits<std::size_t>::max();
+
+FordFulkersonGraphAlgorithm::FordFulkersonGraphAlgorithm(FlowGraph&& graph, bool capacity_scaling)
+    :   m_graph(std::move(graph)),
+        m_start_node(m_graph.start_node),
+        m_end_node(m_graph.end_node),
+        m_parent_arc(m_graph.node_count, no_arc),
+        m_visited_in(m_graph.node_count, 0),
+        m_queue(m_graph.node_count),
         m_max_flow(0),
-        m_next_step_state(NextStepState::CleanGraph) {}
+        m_capacity_scaling(capacity_scaling),
+        m_delta(1) {
+
+    if (m_capacity_scaling) {
+        std::size_t max_capacity = 0;
+        for (auto& edge : m_graph.getTopology().edges) {
+            max_capacity = std::max(max_capacity, edge.capacity);
+        }
+        while (m_delta * 2 <= max_capacity) {
+            m_delta *= 2;
+        }
+    }
+
+    // The nodes and edges not in their clean state at the start are reset by the first cleaning
+    auto& topology = m_graph.getTopology();
+    m_marked_nodes.reserve(m_graph.node_count);
+    m_marked_edges.reserve(m_graph.edge_count);
+    for (std::size_t i = 0; i < m_graph.node_count; ++i) {
+        if (m_graph.node_states[i] != FlowNodeState::Default) {
+            m_marked_nodes.push_back(i);
+        }
+    }
+    for (std::size_t i = 0; i < m_graph.edge_count; ++i) {
+        auto state = m_graph.edge_flows[i] == topology.edges[i].capacity
+            ? FlowEdgeState::Saturated
+            : FlowEdgeState::Default;
+        if (m_graph.edge_states[i] != state) {
+            m_marked_edges.push_back(i);
+        }
+    }
+}
+
+void FordFulkersonGraphAlgorithm::setNodeState(std::size_t node, FlowNodeState state) {
+    m_graph.node_states[node] = state;
+    if (m_event_sink) {
+        m_event_sink->onStepEvent(StepEvent::nodeState(node, state));
+    }
+}
+
+void FordFulkersonGraphAlgorithm::setEdgeState(std::size_t edge, FlowEdgeState state) {
+    m_graph.edge_states[edge] = state;
+    if (m_event_sink) {
+        m_event_sink->onStepEvent(StepEvent::edgeState(edge, state));
+    }
+}
 
 bool FordFulkersonGraphAlgorithm::BFS() {
-    std::queue<std::size_t> queue;
-    std::vector<bool> visited(m_graph.node_count, false);
-    
-    // Start BFS from the start node
-    queue.push(m_start_node);
-    visited[m_start_node] = true;
-    m_parent.assign(m_graph.node_count, std::numeric_limits<std::size_t>::max());
+    auto& topology = m_graph.getTopology();
+    std::size_t queue_begin = 0;
+    std::size_t queue_end = 0;
+
+    // Start BFS from the start node, the nodes visited by the previous searches count as unvisited
+    ++m_search;
+    m_queue[queue_end++] = m_start_node;
+    m_visited_in[m_start_node] = m_search;
+    m_parent_arc[m_start_node] = no_arc;
     
-    while (!queue.empty()) {
-        std::size_t current_node = queue.front();
-        queue.pop();
+    while (queue_begin != queue_end) {
+        std::size_t current_node = m_queue[queue_begin++];
         
-        for (std::size_t edge_index : m_graph.nodes[current_node].edges) {
-            FlowEdge& edge = m_graph.edges[edge_index];
-            std::size_t to_node = edge.to_node_index;
+        // Backward arcs cancel flow, without them the found flow would not always be maximal
+        auto arc_count = getResidualArcCount(topology, current_node);
+        for (std::size_t i = 0; i < arc_count; ++i) {
+            auto arc = getResidualArc(topology, current_node, i);
+            std::size_t to_node = getArcHead(topology, arc);
             
             // Check for unsaturated path
-            if (!visited[to_node] && edge.current_flow < edge.capacity) {
-                queue.push(to_node);
-                visited[to_node] = true;
-                m_parent[to_node] = current_node;
+            if (m_visited_in[to_node] != m_search && getResidualCapacity(m_graph, arc) >= m_delta) {
+                m_queue[queue_end++] = to_node;
+                m_visited_in[to_node] = m_search;
+                m_parent_arc[to_node] = arc;
                 
                 // If end node is reached, an augmenting path is found
                 if (to_node == m_end_node) {
@@ -49,88 +102,104 @@ bool FordFulkersonGraphAlgorithm::BFS() {
 }
 
 std::size_t FordFulkersonGraphAlgorithm::updateFlow() {
+    auto& topology = m_graph.getTopology();
+
     // Find bottleneck capacity along the path from end node to start node
     std::size_t flow = std::numeric_limits<std::size_t>::max();
-    for (std::size_t node = m_end_node; node != m_start_node; node = m_parent[node]) {
-        std::size_t parent_node = m_parent[node];
-        FlowEdge& edge = findEdge(parent_node, node);
-        flow = std::min(flow, edge.capacity - edge.current_flow);
+    for (std::size_t node = m_end_node; node != m_start_node; node = getArcTail(topology, m_parent_arc[node])) {
+        flow = std::min(flow, getResidualCapacity(m_graph, m_parent_arc[node]));
     }
 
     // Update the flow along the augmenting path
-    for (std::size_t node = m_end_node; node != m_start_node; node = m_parent[node]) {
-        std::size_t parent_node = m_parent[node];
-        FlowEdge& edge = findEdge(parent_node, node);
+    for (std::size_t node = m_end_node; node != m_start_node; node = getArcTail(topology, m_parent_arc[node])) {
+        auto arc = m_parent_arc[node];
+        std::size_t edge_index = arc / 2;
 
-        // Update forward edge
-        edge.current_flow += flow;
+        pushResidualFlow(m_graph, arc, flow);
+        if (m_event_sink) {
+            auto flow_change = static_cast<std::int64_t>(flow);
+            m_event_sink->onStepEvent(StepEvent::edgeFlow(edge_index, arc % 2 == 0 ? flow_change : -flow_change));
+        }
 
-        if (edge.current_flow == edge.capacity) {
-            edge.state = FlowEdgeState::Saturated;
+        if (m_graph.edge_flows[edge_index] == topology.edges[edge_index].capacity) {
+            setEdgeState(edge_index, FlowEdgeState::Saturated);
         }
     }
     return flow;
 }
 
+void FordFulkersonGraphAlgorithm::cleanGraph() {
+    auto& topology = m_graph.getTopology();
 
-FlowEdge& FordFulkersonGraphAlgorithm::findEdge(std::size_t from_node, std::size_t to_node) {
-    for (std::size_t edge_index : m_graph.nodes[from_node].edges) {
-        FlowEdge& edge = m_graph.edges[edge_index];
-        if (edge.to_node_index == to_node) {
-            return edge;
+    // Only the states which change are set, so just the changes are reported, in the order of the indices
+    std::sort(m_marked_nodes.begin(), m_marked_nodes.end());
+    for (auto node : m_marked_nodes) {
+        if (m_graph.node_states[node] != FlowNodeState::Default) {
+            setNodeState(node, FlowNodeState::Default);
         }
     }
-    throw std::runtime_error("Edge not found between given nodes.");
-}
-
-void cleanGraph(FlowGraph& graph) {
-    for (auto& node : graph.nodes) {
-        node.state = FlowNodeState::Default;
-    }
-    for (auto& edge : graph.edges) {
-        if (edge.current_flow == edge.capacity) {
-            edge.state = FlowEdgeState::Saturated;
-        }
-        else {
-            edge.state = FlowEdgeState::Default;
+    std::sort(m_marked_edges.begin(), m_marked_edges.end());
+    for (auto edge : m_marked_edges) {
+        auto state = m_graph.edge_flows[edge] == topology.edges[edge].capacity
+            ? FlowEdgeState::Saturated
+            : FlowEdgeState::Default;
+        if (m_graph.edge_states[edge] != state) {
+            setEdgeState(edge, state);
         }
     }
+    m_marked_nodes.clear();
+    m_marked_edges.clear();
 }
 
 void FordFulkersonGraphAlgorithm::showFoundPath() {
-    for (std::size_t node = m_end_node; node != m_start_node; node = m_parent[node]) {
-        std::size_t parent_node = m_parent[node];
-        m_graph.nodes[parent_node].state = FlowNodeState::OnUnsaturatedPath;
-        FlowEdge& edge = findEdge(parent_node, node);
-        edge.state = FlowEdgeState::OnUnsaturatedPath;
+    auto& topology = m_graph.getTopology();
+    for (std::size_t node = m_end_node; node != m_start_node; node = getArcTail(topology, m_parent_arc[node])) {
+        auto arc = m_parent_arc[node];
+        setNodeState(getArcTail(topology, arc), FlowNodeState::OnUnsaturatedPath);
+        setEdgeState(arc / 2, FlowEdgeState::OnUnsaturatedPath);
+        m_marked_nodes.push_back(getArcTail(topology, arc));
+        m_marked_edges.push_back(arc / 2);
     }
 }
 
-bool FordFulkersonGraphAlgorithm::nextStep() {
-    switch (m_next_step_state) {
-        case NextStepState::CleanGraph:
-            cleanGraph(m_graph);
-            m_next_step_state = NextStepState::PathFind;
-            return true;
-        case NextStepState::PathFind:
-            // Perform BFS to find an augmenting path
-            if (!BFS()) {
-                return false;
+Generator<Graph> FordFulkersonGraphAlgorithm::steps() {
+    m_ends_phase = true;
+    while (true) {
+        cleanGraph();
+        co_yield m_graph;
+        m_ends_phase = false;
+
+        // Perform BFS to find an augmenting path, lowering delta until there is one
+        while (!BFS()) {
+            if (m_delta == 1) {
+                co_return;
             }
-            showFoundPath();
-            m_next_step_state = NextStepState::UpdatePath;
-            return true;
-        case NextStepState::UpdatePath:
-            // Update the flow along the augmenting path
-            m_max_flow += updateFlow();
-            m_next_step_state = NextStepState::CleanGraph;
-            return true;
-        default:
-            // not gonna happen
-            return false;
+            m_delta /= 2;
+        }
+        showFoundPath();
+        co_yield m_graph;
+
+        // Update the flow along the augmenting path
+        m_max_flow += updateFlow();
+        m_ends_phase = true;
+        co_yield m_graph;
+        m_ends_phase = false;
     }
 }
 
+bool FordFulkersonGraphAlgorithm::endsPhase() const {
+    return m_ends_phase;
+}
+
+bool FordFulkersonGraphAlgorithm::setEventSink(StepEventSink* sink) {
+    m_event_sink = sink;
+    return true;
+}
+
 const Graph& FordFulkersonGraphAlgorithm::getState() const {
     return m_graph;
+}
+
+std::size_t FordFulkersonGraphAlgorithm::getMaxFlow() const {
+    return m_max_flow;
 }
\ No newline at end of file
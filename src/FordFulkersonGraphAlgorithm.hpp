@@ -2,18 +2,54 @@
 #define FordFulkersonGraphAlgorithm_hpp
 
 #include "FlowGraph.hpp"
-#include "GraphAlgorithm.hpp"
-
-// Class for Ford-Fulkerson algorithm in a flow graph
-class FordFulkersonGraphAlgorithm : public GraphAlgorithm {
-    enum class NextStepState { CleanGraph, PathFind, UpdatePath };
+#include "CoroutineGraphAlgorithm.hpp"
 
+/**
+ * Class for Ford-Fulkerson algorithm in a flow graph.
+ *
+ * Augmenting paths are the shortest paths found by BFS in the residual graph, which includes the arcs
+ * cancelling the flow of the edges, so the found flow is maximal.
+ *
+ * In the capacity-scaling mode augmenting paths are searched in the whole residual graph, but only
+ * over arcs with residual capacity of at least delta. Delta starts at the highest power of two not
+ * above the maximal capacity and is halved whenever no such path is left, which needs far fewer
+ * augmentations on inputs with a wide range of capacities.
+ *
+ * All the memory of the search is allocated by the constructor and reused by every augmentation,
+ * so the steps of a run don't allocate. Nodes are marked as visited by the number of the search
+ * instead of clearing the marks, and the nodes and edges marked on the graph are remembered,
+ * so only they are reset before the next search.
+ */
+class FordFulkersonGraphAlgorithm : public CoroutineGraphAlgorithm {
     FlowGraph m_graph;
     std::size_t m_start_node; // Index of the start node
     std::size_t m_end_node; // Index of the end node
-    std::vector<std::size_t> m_parent; // For trasking parent nodes during BFS
+    std::vector<std::size_t> m_parent_arc; // For tracking the residual arc each node was reached by during BFS
+    std::vector<std::size_t> m_visited_in; // Number of the last BFS which visited each node
+    std::size_t m_search = 0; // Number of the current BFS, nodes with a lower number are unvisited
+    std::vector<std::size_t> m_queue; // Nodes of the BFS, every node is queued at most once per search
+    std::vector<std::size_t> m_marked_nodes; // Nodes whose state may differ from the clean one
+    std::vector<std::size_t> m_marked_edges; // Edges whose state may differ from the clean one
     std::size_t m_max_flow;
-    NextStepState m_next_step_state; // Tells nextStep which part of the algorithm should be done next
+    bool m_capacity_scaling; // True if the capacity-scaling mode is used
+    std::size_t m_delta; // Minimal residual capacity of arcs used in the current phase
+    StepEventSink* m_event_sink = nullptr; // Receives the changes of the graph, if set
+    bool m_ends_phase = true; // True if the last step updated the flow or it is the initial state
+
+    /**
+     * Changes the state of the node and reports it to the event sink.
+     */
+    void setNodeState(std::size_t node, FlowNodeState state);
+
+    /**
+     * Changes the state of the edge and reports it to the event sink.
+     */
+    void setEdgeState(std::size_t edge, FlowEdgeState state);
+
+    /**
+     * Resets the states of the marked nodes and edges, only the saturated edges stay marked.
+     */
+    void cleanGraph();
 
     /**
      * Performs Breadth-First Search (BFS) to find an augmenting path in the flow graph.
@@ -29,33 +65,42 @@ class FordFulkersonGraphAlgorithm : public GraphAlgorithm {
      */
     std::size_t updateFlow();
 
-    /**
-     * Helper function to find the flow edge between two nodes.
-     *
-     * @param from_node Index of the starting node.
-     * @param to_node Index of the ending node.
-     * @return Reference to the flow edge between the given nodes.
-     */
-    FlowEdge& findEdge(std::size_t from_node, std::size_t to_node);
-
     /**
      * Helper function to show edges and nodes on new augmenting path.
      */
     void showFoundPath();
 
 public:
-    FordFulkersonGraphAlgorithm(FlowGraph&& graph);
-    // TODO change this to iterator
+    /**
+     * Constructor for FordFulkersonGraphAlgorithm.
+     *
+     * @param graph The flow graph in which the maximal flow is found.
+     * @param capacity_scaling True to use the capacity-scaling mode.
+     */
+    FordFulkersonGraphAlgorithm(FlowGraph&& graph, bool capacity_scaling = false);
 
     /**
-     * Executes the next step of the Ford-Fulkerson graph algorithm.
+     * Runs the Ford-Fulkerson algorithm.
      *
-     * This method will continue to find augmenting paths and update the flow
-     * until no more augmenting paths are found.
+     * Every augmentation takes three steps, the graph is cleaned, the augmenting path is shown and
+     * the flow is updated along it, until no more augmenting paths are found. In the capacity-scaling
+     * mode the search moves to the next phase without an extra step whenever a phase runs out of paths.
      *
-     * @return True if there are more steps to be taken, false otherwise.
+     * @return Generator of the graph after every step.
      */
-    virtual bool nextStep() override;
+    virtual Generator<Graph> steps() override;
+
+    /**
+     * Returns true if the last step updated the flow along an augmenting path, or it is the initial state.
+     */
+    virtual bool endsPhase() const override;
+
+    /**
+     * Sets the sink receiving the changes of the states of the nodes and edges and of the flows.
+     *
+     * @return Always true.
+     */
+    virtual bool setEventSink(StepEventSink* sink) override;
 
     /**
      * Returns the current state of the graph.
@@ -63,6 +108,11 @@ public:
      * @return A constant reference to the current state of the graph.
      */
     virtual const Graph& getState() const override;
+
+    /**
+     * Returns the value of the flow found so far, the maximal flow once the algorithm is finished.
+     */
+    std::size_t getMaxFlow() const;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,47 @@
+#include "FramePolicy.hpp"
+
+#include <stdexcept>
+
+bool EveryStepFramePolicy::shouldDraw(std::size_t /*step*/, bool /*ends_phase*/) {
+    return true;
+}
+
+StepIntervalFramePolicy::StepIntervalFramePolicy(std::size_t interval)
+    :   m_interval(interval) {
+
+    if (m_interval == 0) {
+        throw std::runtime_error("Number of steps per frame has to be at least 1");
+    }
+}
+
+bool StepIntervalFramePolicy::shouldDraw(std::size_t step, bool /*ends_phase*/) {
+    return step % m_interval == 0;
+}
+
+bool PhaseFramePolicy::shouldDraw(std::size_t /*step*/, bool ends_phase) {
+    return ends_phase;
+}
+
+FrameCountFramePolicy::FrameCountFramePolicy(std::size_t frame_count, std::size_t step_count)
+    :   m_frame_count(frame_count),
+        m_step_count(step_count) {
+
+    if (m_frame_count == 0) {
+        throw std::runtime_error("Number of frames has to be at least 1");
+    }
+}
+
+bool FrameCountFramePolicy::shouldDraw(std::size_t step, bool /*ends_phase*/) {
+    // A single frame is the final state, which is always drawn
+    if (m_frame_count == 1) {
+        return false;
+    }
+    if (step == 0 || m_frame_count >= m_step_count) {
+        return true;
+    }
+
+    // Step i falls to frame i * (F - 1) / (S - 1), the first step of every frame is drawn
+    auto frame_gaps = m_frame_count - 1;
+    auto step_gaps = m_step_count - 1;
+    return step * frame_gaps / step_gaps != (step - 1) * frame_gaps / step_gaps;
+}
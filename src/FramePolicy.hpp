@@ -0,0 +1,68 @@
+#ifndef FramePolicy_hpp
+#define FramePolicy_hpp
+
+#include <cstddef>
+
+// Abstract base class deciding which steps of an algorithm run are drawn as frames
+class FramePolicy {
+public:
+    /**
+     * Decides if the graph after the step is drawn. The steps in between are executed without drawing,
+     * the state after the last step is drawn regardless of the policy.
+     *
+     * @param step Number of the step, the initial state of the graph is step 0.
+     * @param ends_phase True if the step finished a phase of the algorithm, see GraphAlgorithm::endsPhase().
+     * @return True if the step should be drawn, false otherwise.
+     */
+    virtual bool shouldDraw(std::size_t step, bool ends_phase) = 0;
+
+    virtual ~FramePolicy() {};
+};
+
+// Policy drawing every step
+class EveryStepFramePolicy : public FramePolicy {
+public:
+    virtual bool shouldDraw(std::size_t step, bool ends_phase) override;
+};
+
+// Policy drawing the initial state and then every n-th step
+class StepIntervalFramePolicy : public FramePolicy {
+    std::size_t m_interval;
+
+public:
+    /**
+     * Constructor for StepIntervalFramePolicy.
+     *
+     * @param interval Number of steps per frame.
+     * @throws std::runtime_error if the interval is 0.
+     */
+    StepIntervalFramePolicy(std::size_t interval);
+
+    virtual bool shouldDraw(std::size_t step, bool ends_phase) override;
+};
+
+// Policy drawing one frame per phase of the algorithm, like a BFS level or a Ford-Fulkerson augmentation
+class PhaseFramePolicy : public FramePolicy {
+public:
+    virtual bool shouldDraw(std::size_t step, bool ends_phase) override;
+};
+
+// Policy spreading a fixed number of frames evenly over a run with a known number of steps
+class FrameCountFramePolicy : public FramePolicy {
+    std::size_t m_frame_count;
+    std::size_t m_step_count;
+
+public:
+    /**
+     * Constructor for FrameCountFramePolicy. The first and the last step are among the drawn ones.
+     *
+     * @param frame_count Number of frames to be drawn, all the steps are drawn if there are fewer of them.
+     * @param step_count Number of steps of the run including the initial state, see GraphAlgorithm::run().
+     * @throws std::runtime_error if the frame count is 0.
+     */
+    FrameCountFramePolicy(std::size_t frame_count, std::size_t step_count);
+
+    virtual bool shouldDraw(std::size_t step, bool ends_phase) override;
+};
+
+#endif
@@ -13,5 +13,12 @@ Frame& GIFRenderer::beginDrawing() {
 
 void GIFRenderer::endDrawing() {
     m_writer.write_frame(m_next_frame.getFrame());
-    m_next_frame = GIFFrame(m_frame_width, m_frame_height);
+}
+
+std::unique_ptr<Frame> GIFRenderer::createFrame() const {
+    return std::make_unique<GIFFrame>(m_frame_width, m_frame_height);
+}
+
+void GIFRenderer::writeFrame(const Frame& frame) {
+    m_writer.write_frame(static_cast<const GIFFrame&>(frame).getFrame());
 }
\ No newline at end of file
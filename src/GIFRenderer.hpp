@@ -14,7 +14,7 @@ class GIFRenderer : public Renderer {
     std::size_t m_frame_width;
     std::size_t m_frame_height;
     gif::GifWriter m_writer; // GIF writer for creating the GIF file
-    GIFFrame m_next_frame; // The next frame to be drawn in the GIF
+    GIFFrame m_next_frame; // The next frame to be drawn in the GIF, it keeps the drawing of the previous one
 
 public:
     /**
@@ -40,6 +40,25 @@ public:
      */
     virtual void endDrawing() override;
 
+    /**
+     * The frame is reused for the next frame of the GIF, so it keeps the previous drawing.
+     */
+    virtual bool keepsPreviousFrame() const override { return true; }
+
+    /**
+     * Creates a blank GIF frame of the size of the animation.
+     *
+     * @return A unique pointer to the new frame.
+     */
+    virtual std::unique_ptr<Frame> createFrame() const override;
+
+    /**
+     * Writes the frame as the next frame of the GIF.
+     *
+     * @param frame A frame created by createFrame().
+     */
+    virtual void writeFrame(const Frame& frame) override;
+
     /**
      * Finalizes the GIF rendering process.
      * This method may contain any necessary cleanup operations before finishing the GIF file.
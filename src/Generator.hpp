@@ -0,0 +1,140 @@
+#ifndef Generator_hpp
+#define Generator_hpp
+
+#include <coroutine>
+#include <exception>
+#include <iterator>
+#include <utility>
+
+/**
+ * Lazy coroutine generator of references to values of type T, a subset of std::generator.
+ *
+ * The coroutine body runs only when the generator is advanced, either by next() or by iterating it,
+ * and it stops at every co_yield until the next advance. The yielded values are not copied, so they
+ * have to stay alive until the coroutine is resumed again.
+ */
+template <typename T>
+class Generator {
+public:
+    // Structure connecting the coroutine body with the generator
+    struct promise_type {
+        const T* value = nullptr; // The value of the last co_yield
+        std::exception_ptr exception;
+
+        Generator get_return_object() {
+            return Generator(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        std::suspend_always yield_value(const T& yielded) noexcept {
+            value = &yielded;
+            return {};
+        }
+        void return_void() noexcept {}
+        void unhandled_exception() { exception = std::current_exception(); }
+
+        // Awaiting inside the generator is not supported
+        void await_transform() = delete;
+    };
+
+    // Input iterator over the yielded values, it advances the generator it was taken from
+    class iterator {
+        std::coroutine_handle<promise_type> m_handle;
+
+    public:
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+
+        iterator() = default;
+        explicit iterator(std::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+
+        const T& operator*() const { return *m_handle.promise().value; }
+        const T* operator->() const { return m_handle.promise().value; }
+
+        iterator& operator++() {
+            resume(m_handle);
+            return *this;
+        }
+        void operator++(int) { ++*this; }
+
+        bool operator==(std::default_sentinel_t) const { return !m_handle || m_handle.done(); }
+    };
+
+private:
+    std::coroutine_handle<promise_type> m_handle;
+
+    explicit Generator(std::coroutine_handle<promise_type> handle) : m_handle(handle) {}
+
+    /**
+     * Runs the coroutine until its next co_yield or its end and rethrows an exception escaping from it.
+     */
+    static void resume(std::coroutine_handle<promise_type> handle) {
+        handle.resume();
+        if (handle.done() && handle.promise().exception) {
+            std::rethrow_exception(std::exchange(handle.promise().exception, nullptr));
+        }
+    }
+
+public:
+    /**
+     * Constructor of an empty generator, which yields no values.
+     */
+    Generator() = default;
+
+    Generator(Generator&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+
+    Generator& operator=(Generator&& other) noexcept {
+        if (this != &other) {
+            if (m_handle) {
+                m_handle.destroy();
+            }
+            m_handle = std::exchange(other.m_handle, nullptr);
+        }
+        return *this;
+    }
+
+    Generator(const Generator&) = delete;
+    Generator& operator=(const Generator&) = delete;
+
+    ~Generator() {
+        if (m_handle) {
+            m_handle.destroy();
+        }
+    }
+
+    /**
+     * Runs the coroutine until it yields the next value.
+     *
+     * @return True if a value was yielded, false if the coroutine has finished.
+     * @throws Any exception escaping from the coroutine body.
+     */
+    bool next() {
+        if (!m_handle || m_handle.done()) {
+            return false;
+        }
+        resume(m_handle);
+        return !m_handle.done();
+    }
+
+    /**
+     * Returns the value of the last co_yield, valid only after next() returned true.
+     */
+    const T& value() const {
+        return *m_handle.promise().value;
+    }
+
+    /**
+     * Starts the iteration by running the coroutine until its first co_yield.
+     * The generator can be iterated only once.
+     */
+    iterator begin() {
+        if (m_handle && !m_handle.done()) {
+            resume(m_handle);
+        }
+        return iterator(m_handle);
+    }
+
+    std::default_sentinel_t end() const noexcept { return {}; }
+};
+
+#endif
@@ -2,10 +2,61 @@
 #define Graph_hpp
 
 #include "Drawable.hpp"
+#include "Frame.hpp"
+#include "StepEvent.hpp"
+
+#include <memory>
+#include <ostream>
 
 // Abstract base class representing a graph that can be drawn on a frame
 class Graph : public Drawable {
 public:
+    /**
+     * Redraws only the part of the frame changed by the event.
+     *
+     * The frame has to hold the drawing of the graph from before the step and the graph has to be
+     * in the state after the step. By default graphs can't draw single changes.
+     *
+     * @param frame The frame on which the graph was drawn.
+     * @param event The change made by the step.
+     * @return False if the change can't be drawn on its own, so the whole graph has to be drawn, true otherwise.
+     */
+    virtual bool drawChange(Frame& /*frame*/, const StepEvent& /*event*/) const { return false; }
+
+    /**
+     * Returns a copy of the current state of the graph, which can be drawn while the original one changes.
+     * By default graphs can't be copied.
+     *
+     * @return The copy, or nullptr if the graph can't be copied.
+     */
+    virtual std::unique_ptr<Graph> clone() const { return nullptr; }
+
+    /**
+     * Makes the change described by the event, so a copy of the graph can follow an algorithm run
+     * without running the algorithm. By default graphs can't apply changes.
+     *
+     * @param event The change made by a step of an algorithm on a graph of the same topology.
+     * @return False if the change can't be applied, true otherwise.
+     */
+    virtual bool applyChange(const StepEvent& /*event*/) { return false; }
+
+    /**
+     * Reports the current state as the changes which make it from the graph in the state it was created in,
+     * so the state can be saved and restored by applyChange(). By default graphs can't describe their state.
+     *
+     * @param sink The sink receiving the changes.
+     * @return False if the state can't be described by changes, true otherwise.
+     */
+    virtual bool describeState(StepEventSink& /*sink*/) const { return false; }
+
+    /**
+     * Prints the result the algorithm left in the graph, like the found path or the value of the flow.
+     * By default graphs have no result to print.
+     *
+     * @param output The stream the result is printed to, one value per line.
+     */
+    virtual void printResult(std::ostream& /*output*/) const {}
+
     /**
      * Virtual destructor for Graph.
      * Allows proper cleanup when derived classes are deleted via a base class pointer.
@@ -14,4 +65,4 @@ public:
 };
 
 
-#endif
\ No newline at end of file
+#endif
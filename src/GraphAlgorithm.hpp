@@ -1,13 +1,14 @@
 #ifndef GraphAlgorithm_hpp
 #define GraphAlgorithm_hpp
 
+#include "Generator.hpp"
 #include "Graph.hpp"
+#include "StepEvent.hpp"
+#include <cstddef>
 
 // Abstract base class for graph algorithms
 class GraphAlgorithm {
 public:
-    // TODO change this to iterator
-
     /**
      * Executes the next step of the graph algorithm.
      *
@@ -22,6 +23,53 @@ public:
      */
     virtual const Graph& getState() const = 0;
 
+    /**
+     * Returns a lazy sequence of the states of the graph after every step of the algorithm.
+     *
+     * The default implementation yields getState() after every successful nextStep(), algorithms
+     * written as coroutines yield their graph directly. The steps share the state with nextStep(),
+     * so only one of them should be used to run the algorithm.
+     *
+     * @return Generator of the graph states, the algorithm has to outlive it.
+     */
+    virtual Generator<Graph> steps() {
+        while (nextStep()) {
+            co_yield getState();
+        }
+    }
+
+    /**
+     * Sets the sink receiving every change of the graph made by the following steps.
+     * By default algorithms don't report their changes, then every drawn step redraws the whole graph
+     * and the run can't be recorded. The parallel, bidirectional, multi-source, grid, JPS, CH, LPA*
+     * and push-relabel algorithms don't report them (push-relabel also changes the node heights,
+     * which no StepEvent describes).
+     *
+     * @param sink The sink, it has to outlive the algorithm run, or nullptr to stop reporting.
+     * @return True if the algorithm reports its changes, false otherwise.
+     */
+    virtual bool setEventSink(StepEventSink* /*sink*/) { return false; }
+
+    /**
+     * Returns true if the last step finished a phase of the algorithm, like a level of BFS or an augmentation
+     * of Ford-Fulkerson, so it is a good point for a frame when not every step is drawn.
+     * By default every step is a phase of its own.
+     */
+    virtual bool endsPhase() const { return true; }
+
+    /**
+     * Runs the whole algorithm without looking at the steps.
+     *
+     * @return The number of steps including the initial state, as yielded by steps().
+     */
+    std::size_t run() {
+        std::size_t step_count = 0;
+        for (auto steps = this->steps(); steps.next();) {
+            ++step_count;
+        }
+        return step_count;
+    }
+
     /**
      * Virtual destructor for GraphAlgorithm.
      * Allows proper cleanup when derived classes are deleted via a base class pointer.
@@ -29,4 +77,4 @@ public:
     virtual ~GraphAlgorithm() {};
 };
 
-#endif
\ No newline at end of file
+#endif
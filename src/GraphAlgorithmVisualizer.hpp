@@ -1,14 +1,53 @@
 #ifndef GraphAlgorithmVisualizer_hpp
 #define GraphAlgorithmVisualizer_hpp
 
+#include "FramePolicy.hpp"
 #include "GraphAlgorithm.hpp"
 #include "Renderer.hpp"
+#include "StepEvent.hpp"
+#include <cstddef>
 #include <memory>
+#include <vector>
 
 // Class for visualizing the whole run of graph algorithm
 class GraphAlgorithmVisualizer {
+    // Above this number of changes since the last frame the graph is drawn whole
+    static constexpr std::size_t max_undrawn_changes = 1 << 16;
+
     std::unique_ptr<GraphAlgorithm> m_algorithm;
     std::unique_ptr<Renderer> m_renderer;
+    std::unique_ptr<FramePolicy> m_frame_policy;
+    std::vector<StepEvent> m_undrawn_changes; // Changes made since the last frame
+    bool m_draws_changes = false; // True if only the changes are drawn on the previous frame
+    bool m_draws_whole = true; // True if the next frame has to be drawn whole
+
+    /**
+     * Draws the changes since the last frame on the frame holding the last frame.
+     *
+     * @return False if some change can't be drawn on its own, true otherwise.
+     */
+    static bool drawChanges(const Graph& graph, Frame& frame, const std::vector<StepEvent>& events) {
+        for (auto& event : events) {
+            if (!graph.drawChange(frame, event)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Draws the graph as the next frame, only its changes if possible.
+     */
+    void drawFrame(const Graph& graph) {
+        Frame& nextFrame = m_renderer->beginDrawing();
+        if (m_draws_whole || !m_draws_changes || !drawChanges(graph, nextFrame, m_undrawn_changes)) {
+            graph.draw(nextFrame);
+        }
+        m_renderer->endDrawing();
+
+        m_undrawn_changes.clear();
+        m_draws_whole = false;
+    }
 
 public:
     /**
@@ -16,27 +55,58 @@ public:
      *
      * @param algorithm A unique pointer to the graph algorithm to be visualized.
      * @param renderer A unique pointer to the renderer used for visualization.
+     * @param frame_policy A unique pointer to the policy choosing the drawn steps, every step is drawn if null.
      */
-    GraphAlgorithmVisualizer(std::unique_ptr<GraphAlgorithm> algorithm, std::unique_ptr<Renderer> renderer)
-        : m_algorithm(std::move(algorithm)), m_renderer(std::move(renderer)) {}
+    GraphAlgorithmVisualizer(std::unique_ptr<GraphAlgorithm> algorithm, std::unique_ptr<Renderer> renderer,
+        std::unique_ptr<FramePolicy> frame_policy = nullptr)
+        :   m_algorithm(std::move(algorithm)),
+            m_renderer(std::move(renderer)),
+            m_frame_policy(frame_policy ? std::move(frame_policy) : std::make_unique<EveryStepFramePolicy>()) {}
 
     /**
      * Visualizes the entire run of the graph algorithm.
      * 
-     * The method executes the algorithm step by step and visualizes each step using the renderer.
+     * The method iterates the steps of the algorithm and draws the graph after the steps chosen by
+     * the frame policy using the renderer, the steps in between are not drawn at all. The final state is
+     * always drawn. If the algorithm reports its changes and the renderer keeps the previous frame,
+     * only the changes since the last frame are drawn. The changes of every step are passed to the renderer as well.
      */
     void visualize() {
-        while (m_algorithm->nextStep()) {
-            Frame& nextFrame = m_renderer->beginDrawing();
+        StepEventBuffer events;
+        bool reports_events = m_algorithm->setEventSink(&events);
+        m_draws_changes = reports_events && m_renderer->keepsPreviousFrame();
+        m_draws_whole = true;
+        m_undrawn_changes.clear();
 
-            // Get the state of the graph from the algorithm
-            auto& nextGraph = m_algorithm->getState();
-            nextGraph.draw(nextFrame);
+        std::size_t step = 0;
+        bool last_step_drawn = true;
+        for (auto& nextGraph : m_algorithm->steps()) {
+            if (reports_events) {
+                m_renderer->onStepEvents(events.events);
+                if (m_draws_changes && !m_draws_whole) {
+                    if (m_undrawn_changes.size() + events.events.size() > max_undrawn_changes) {
+                        m_undrawn_changes.clear();
+                        m_draws_whole = true;
+                    }
+                    else {
+                        m_undrawn_changes.insert(m_undrawn_changes.end(), events.events.begin(), events.events.end());
+                    }
+                }
+                events.events.clear();
+            }
 
-            m_renderer->endDrawing();
+            last_step_drawn = m_frame_policy->shouldDraw(step++, m_algorithm->endsPhase());
+            if (last_step_drawn) {
+                drawFrame(nextGraph);
+            }
+        }
+        if (!last_step_drawn) {
+            drawFrame(m_algorithm->getState());
         }
+
+        m_algorithm->setEventSink(nullptr);
         m_renderer->finalize();
     }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,67 @@
+#include "GridBFSGraphAlgorithm.hpp"
+#include "GridGraph.hpp"
+
+static constexpr GridDirection directions[] = {
+    GridDirection::Up, GridDirection::Right, GridDirection::Down, GridDirection::Left
+};
+
+GridBFSGraphAlgorithm::GridBFSGraphAlgorithm(GridGraph&& graph)
+    : m_graph(std::move(graph)), m_unvisited_node_queue(), m_first_step(true), m_found_end(false) {}
+
+bool GridBFSGraphAlgorithm::nextStep() {
+    // Lets the renderer draw the initial state of graph
+    if (m_first_step) {
+        m_unvisited_node_queue.push(m_graph.start_node);
+        m_first_step = false;
+        return true;
+    }
+
+    // We are finished
+    if (m_unvisited_node_queue.empty() || m_found_end) {
+        return false;
+    }
+
+    auto& topology = m_graph.getTopology();
+    auto node = m_unvisited_node_queue.front();
+    m_unvisited_node_queue.pop();
+
+    m_graph.setNodeState(node, PathNodeState::Visited);
+
+    // We found the end node
+    if (node == m_graph.end_node) {
+        if (node == m_graph.start_node) {
+            m_graph.setNodeState(node, PathNodeState::OnShortestPath);
+            m_found_end = true;
+            return true;
+        }
+
+        // Backtrack and mark the nodes on the shortest path, edges are derived from them
+        auto previous = topology.getNeighbour(node, getOppositeDirection(m_graph.getEnteredFrom(node)));
+        while (previous != m_graph.start_node) {
+            m_graph.setNodeState(previous, PathNodeState::OnShortestPath);
+            previous = topology.getNeighbour(previous, getOppositeDirection(m_graph.getEnteredFrom(previous)));
+        }
+        m_found_end = true;
+        return true;
+    }
+
+    // Else we go throgh the neighbours and add them to queue
+    for (auto direction : directions) {
+        if (!topology.hasEdge(node, direction)) {
+            continue;
+        }
+        auto neighbour = topology.getNeighbour(node, direction);
+
+        if (m_graph.getNodeState(neighbour) == PathNodeState::NotFound) {
+            m_unvisited_node_queue.push(neighbour);
+            m_graph.setNodeState(neighbour, PathNodeState::Found);
+            m_graph.setEnteredFrom(neighbour, direction);
+        }
+    }
+
+    return true;
+}
+
+const Graph& GridBFSGraphAlgorithm::getState() const {
+    return m_graph;
+}
@@ -0,0 +1,38 @@
+#ifndef GridBFSGraphAlgorithm_hpp
+#define GridBFSGraphAlgorithm_hpp
+
+#include "GraphAlgorithm.hpp"
+#include "GridGraph.hpp"
+#include <queue>
+
+// Class for Breadth-First Search (BFS) algorithm in an implicit grid graph
+class GridBFSGraphAlgorithm : public GraphAlgorithm {
+    GridGraph m_graph;
+    std::queue<std::size_t> m_unvisited_node_queue;
+    bool m_first_step;
+    bool m_found_end;
+
+public:
+    /**
+     * Constructor for GridBFSGraphAlgorithm.
+     *
+     * @param graph The grid graph to be traversed using BFS.
+     */
+    GridBFSGraphAlgorithm(GridGraph&& graph);
+
+    /**
+     * Executes the next step of the BFS algorithm.
+     *
+     * @return True if there are more steps to be taken, false otherwise.
+     */
+    virtual bool nextStep() override;
+
+    /**
+     * Returns the current state of the graph.
+     *
+     * @return A constant reference to the current state of the graph.
+     */
+    virtual const Graph& getState() const override;
+};
+
+#endif
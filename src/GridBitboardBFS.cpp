@@ -0,0 +1,197 @@
+#include "GridBitboardBFS.hpp"
+#include "GridGraph.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+static constexpr GridDirection directions[] = {
+    GridDirection::Up, GridDirection::Right, GridDirection::Down, GridDirection::Left
+};
+
+GridBitboardBFS::GridBitboardBFS(const GridGraphTopology& topology)
+    :   m_topology(topology),
+        m_words_per_row((topology.width + 63) / 64),
+        m_visited(topology.height * m_words_per_row, 0),
+        m_frontier(topology.height * m_words_per_row, 0),
+        m_next(topology.height * m_words_per_row, 0) {
+
+    for (auto& can_move : m_can_move) {
+        can_move.assign(topology.height * m_words_per_row, 0);
+    }
+    for (std::size_t y = 0; y < topology.height; ++y) {
+        for (std::size_t x = 0; x < topology.width; ++x) {
+            auto cell = y * topology.width + x;
+            if (!topology.hasAnyEdge(cell)) {
+                continue;
+            }
+            for (auto direction : directions) {
+                if (topology.hasEdge(cell, direction)) {
+                    m_can_move[static_cast<std::uint8_t>(direction)][y * m_words_per_row + x / 64]
+                        |= std::uint64_t(1) << (x % 64);
+                }
+            }
+        }
+    }
+
+    auto start_x = topology.start_node % topology.width;
+    auto start_word = (topology.start_node / topology.width) * m_words_per_row + start_x / 64;
+    m_visited[start_word] |= std::uint64_t(1) << (start_x % 64);
+    m_frontier[start_word] |= std::uint64_t(1) << (start_x % 64);
+    m_frontier_words.push_back(start_word);
+    storeLevel();
+}
+
+bool GridBitboardBFS::isInLevel(std::size_t cell, std::size_t level) const {
+    auto x = cell % m_topology.width;
+    auto index = (cell / m_topology.width) * m_words_per_row + x / 64;
+    auto& stored = m_levels[level];
+
+    auto position = std::lower_bound(stored.indices.begin(), stored.indices.end(), index);
+    if (position == stored.indices.end() || *position != index) {
+        return false;
+    }
+    return (stored.words[position - stored.indices.begin()] >> (x % 64)) & 1;
+}
+
+GridDirection GridBitboardBFS::findEnteredFrom(std::size_t cell, std::size_t level) const {
+    auto x = cell % m_topology.width;
+    auto y = cell / m_topology.width;
+
+    for (auto direction : directions) {
+        // The cell the edge in this direction would have to come from
+        bool exists = (direction == GridDirection::Up && y + 1 < m_topology.height)
+            || (direction == GridDirection::Right && x > 0)
+            || (direction == GridDirection::Down && y > 0)
+            || (direction == GridDirection::Left && x + 1 < m_topology.width);
+        if (!exists) {
+            continue;
+        }
+        auto previous = m_topology.getNeighbour(cell, getOppositeDirection(direction));
+        if (isInLevel(previous, level - 1) && m_topology.hasEdge(previous, direction)) {
+            return direction;
+        }
+    }
+    throw std::runtime_error("Cell was not reached in the given level");
+}
+
+void GridBitboardBFS::addToNext(std::size_t index, std::uint64_t cells) {
+    if (cells == 0) {
+        return;
+    }
+    if (m_next[index] == 0) {
+        m_next_words.push_back(index);
+    }
+    m_next[index] |= cells;
+}
+
+void GridBitboardBFS::storeLevel() {
+    Level level{m_frontier_words, {}};
+    level.words.reserve(m_frontier_words.size());
+    for (auto index : m_frontier_words) {
+        level.words.push_back(m_frontier[index]);
+    }
+    m_levels.push_back(std::move(level));
+}
+
+bool GridBitboardBFS::expandLevel() {
+    auto& can_move_up = m_can_move[static_cast<std::uint8_t>(GridDirection::Up)];
+    auto& can_move_right = m_can_move[static_cast<std::uint8_t>(GridDirection::Right)];
+    auto& can_move_down = m_can_move[static_cast<std::uint8_t>(GridDirection::Down)];
+    auto& can_move_left = m_can_move[static_cast<std::uint8_t>(GridDirection::Left)];
+    auto words = m_words_per_row;
+
+    for (auto index : m_frontier_words) {
+        auto word = index % words;
+        auto cells = m_frontier[index];
+        auto moving_right = cells & can_move_right[index];
+        auto moving_left = cells & can_move_left[index];
+
+        // A move right is a shift to the higher bit, the highest bit enters the next word of the row
+        addToNext(index, (moving_right << 1) | (moving_left >> 1));
+        if (word + 1 < words) {
+            addToNext(index + 1, moving_right >> 63);
+        }
+        if (word > 0) {
+            addToNext(index - 1, moving_left << 63);
+        }
+        if (index >= words) {
+            addToNext(index - words, cells & can_move_up[index]);
+        }
+        if (index + words < m_next.size()) {
+            addToNext(index + words, cells & can_move_down[index]);
+        }
+    }
+
+    // Only the cells not reached in any earlier level stay in the next frontier
+    std::size_t kept = 0;
+    for (auto index : m_next_words) {
+        m_next[index] &= ~m_visited[index];
+        if (m_next[index] != 0) {
+            m_visited[index] |= m_next[index];
+            m_next_words[kept++] = index;
+        }
+    }
+    m_next_words.resize(kept);
+
+    // Nothing new was reached, the frontier stays the last level
+    if (m_next_words.empty()) {
+        return false;
+    }
+
+    for (auto index : m_frontier_words) {
+        m_frontier[index] = 0;
+    }
+    std::sort(m_next_words.begin(), m_next_words.end());
+    std::swap(m_frontier, m_next);
+    std::swap(m_frontier_words, m_next_words);
+    m_next_words.clear();
+    storeLevel();
+    return true;
+}
+
+std::size_t GridBitboardBFS::getLevel() const {
+    return m_levels.size() - 1;
+}
+
+std::vector<std::size_t> GridBitboardBFS::getFrontierCells() const {
+    std::vector<std::size_t> cells;
+
+    for (auto index : m_frontier_words) {
+        auto first_cell = (index / m_words_per_row) * m_topology.width + (index % m_words_per_row) * 64;
+        auto bits = m_frontier[index];
+        while (bits != 0) {
+            cells.push_back(first_cell + std::countr_zero(bits));
+            bits &= bits - 1;
+        }
+    }
+    return cells;
+}
+
+bool GridBitboardBFS::isInFrontier(std::size_t cell) const {
+    auto x = cell % m_topology.width;
+    return (m_frontier[(cell / m_topology.width) * m_words_per_row + x / 64] >> (x % 64)) & 1;
+}
+
+GridDirection GridBitboardBFS::getEnteredFrom(std::size_t cell) const {
+    return findEnteredFrom(cell, getLevel());
+}
+
+std::vector<std::size_t> GridBitboardBFS::getPath(std::size_t cell) const {
+    std::size_t level = 0;
+    while (level < m_levels.size() && !isInLevel(cell, level)) {
+        ++level;
+    }
+    // The cell was not reached yet
+    if (level == m_levels.size()) {
+        return {};
+    }
+
+    std::vector<std::size_t> path{cell};
+    for (; level > 0; --level) {
+        auto direction = findEnteredFrom(path.back(), level);
+        path.push_back(m_topology.getNeighbour(path.back(), getOppositeDirection(direction)));
+    }
+    std::reverse(path.begin(), path.end());
+    return path;
+}
@@ -0,0 +1,104 @@
+#ifndef GridBitboardBFS_hpp
+#define GridBitboardBFS_hpp
+
+#include "GridGraph.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Class for Breadth-First Search over an implicit grid graph represented by bitboards.
+ *
+ * Every row of the grid is packed into 64-bit words. For every direction a bitboard holds the cells
+ * with an edge in that direction, so the frontier is moved by masking its words with them and shifting
+ * them by one cell (a bit within the row, or a row up or down), a few word operations per 64 cells
+ * and no queue. Only the non-empty words of the frontier are processed. The non-empty words of the frontier
+ * of every level are stored, so the path to any reached cell can be backtracked.
+ */
+class GridBitboardBFS {
+    // Structure holding the frontier of one level, the non-empty words of the bitboard
+    struct Level {
+        std::vector<std::size_t> indices; // Indices of the words in the bitboard, in increasing order
+        std::vector<std::uint64_t> words;
+    };
+
+    const GridGraphTopology& m_topology;
+    std::size_t m_words_per_row;
+    std::array<std::vector<std::uint64_t>, 4> m_can_move; // Cells with an edge in each GridDirection
+    std::vector<std::uint64_t> m_visited; // Cells reached in any level so far
+    std::vector<std::uint64_t> m_frontier; // Cells of the current level
+    std::vector<std::uint64_t> m_next; // Cells of the next level while it is computed, otherwise no cells
+    std::vector<std::size_t> m_frontier_words; // Indices of the non-empty words of m_frontier, in increasing order
+    std::vector<std::size_t> m_next_words; // Indices of the non-empty words of m_next
+    std::vector<Level> m_levels; // Frontier of every level, the level is the distance from the start
+
+    /**
+     * Returns true if the cell is in the frontier of the given level.
+     */
+    bool isInLevel(std::size_t cell, std::size_t level) const;
+
+    /**
+     * Returns the direction of an edge entering the cell from a cell of the previous level.
+     *
+     * @param cell Id of a cell of the given level.
+     * @param level The level of the cell, at least 1.
+     * @throws std::runtime_error if the cell is not in the given level.
+     */
+    GridDirection findEnteredFrom(std::size_t cell, std::size_t level) const;
+
+    /**
+     * Adds the cells to the word of the next frontier.
+     */
+    void addToNext(std::size_t index, std::uint64_t cells);
+
+    /**
+     * Stores the current frontier as the next level.
+     */
+    void storeLevel();
+
+public:
+    /**
+     * Constructor for GridBitboardBFS. The start node forms the frontier of level 0.
+     *
+     * @param topology The topology of the searched grid graph, it has to outlive the search.
+     */
+    GridBitboardBFS(const GridGraphTopology& topology);
+
+    /**
+     * Expands the current frontier by one level.
+     *
+     * @return False if no new cell was reached, so the search is finished, true otherwise.
+     */
+    bool expandLevel();
+
+    /**
+     * Returns the distance of the cells in the current frontier from the start node.
+     */
+    std::size_t getLevel() const;
+
+    /**
+     * Returns the ids of the cells in the current frontier, in increasing order.
+     */
+    std::vector<std::size_t> getFrontierCells() const;
+
+    /**
+     * Returns true if the cell is in the current frontier.
+     */
+    bool isInFrontier(std::size_t cell) const;
+
+    /**
+     * Returns the direction of an edge entering the cell from the previous level.
+     * The cell has to be in the current frontier and it must not be the start node.
+     */
+    GridDirection getEnteredFrom(std::size_t cell) const;
+
+    /**
+     * Returns the ids of the cells on a shortest path from the start node to the reached cell, both included.
+     *
+     * @return The cells in order, or an empty vector if the cell was not reached yet.
+     */
+    std::vector<std::size_t> getPath(std::size_t cell) const;
+};
+
+#endif
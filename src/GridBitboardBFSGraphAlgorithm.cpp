@@ -0,0 +1,57 @@
+#include "GridBitboardBFSGraphAlgorithm.hpp"
+#include "GridGraph.hpp"
+
+GridBitboardBFSGraphAlgorithm::GridBitboardBFSGraphAlgorithm(GridGraph&& graph)
+    :   m_graph(std::move(graph)),
+        m_search(m_graph.getTopology()),
+        m_first_step(true),
+        m_found_end(false) {}
+
+bool GridBitboardBFSGraphAlgorithm::nextStep() {
+    // Lets the renderer draw the initial state of graph
+    if (m_first_step) {
+        m_shown_frontier.push_back(m_graph.start_node);
+        m_first_step = false;
+        return true;
+    }
+
+    // We are finished
+    if (m_shown_frontier.empty() || m_found_end) {
+        return false;
+    }
+
+    for (auto cell : m_shown_frontier) {
+        m_graph.setNodeState(cell, PathNodeState::Visited);
+    }
+
+    // We found the end node
+    if (m_search.isInFrontier(m_graph.end_node)) {
+        // Mark the nodes on the shortest path, they were found over the same edges the path is backtracked by
+        for (auto cell : m_search.getPath(m_graph.end_node)) {
+            if (cell != m_graph.start_node && cell != m_graph.end_node) {
+                m_graph.setNodeState(cell, PathNodeState::OnShortestPath);
+            }
+        }
+        if (m_graph.end_node == m_graph.start_node) {
+            m_graph.setNodeState(m_graph.end_node, PathNodeState::OnShortestPath);
+        }
+        m_found_end = true;
+        return true;
+    }
+
+    // Else the whole next level is found at once
+    m_shown_frontier.clear();
+    if (m_search.expandLevel()) {
+        m_shown_frontier = m_search.getFrontierCells();
+        for (auto cell : m_shown_frontier) {
+            m_graph.setNodeState(cell, PathNodeState::Found);
+            m_graph.setEnteredFrom(cell, m_search.getEnteredFrom(cell));
+        }
+    }
+
+    return true;
+}
+
+const Graph& GridBitboardBFSGraphAlgorithm::getState() const {
+    return m_graph;
+}
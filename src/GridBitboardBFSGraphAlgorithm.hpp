@@ -0,0 +1,48 @@
+#ifndef GridBitboardBFSGraphAlgorithm_hpp
+#define GridBitboardBFSGraphAlgorithm_hpp
+
+#include "GraphAlgorithm.hpp"
+#include "GridBitboardBFS.hpp"
+#include "GridGraph.hpp"
+#include <cstddef>
+#include <vector>
+
+/**
+ * Class for Breadth-First Search (BFS) in an implicit grid graph advancing whole levels on bitboards.
+ *
+ * The search itself is done by GridBitboardBFS, the cells of every new level are only written into
+ * the states of the grid graph to be drawn.
+ */
+class GridBitboardBFSGraphAlgorithm : public GraphAlgorithm {
+    GridGraph m_graph;
+    GridBitboardBFS m_search;
+    std::vector<std::size_t> m_shown_frontier; // Cells of the current level shown as found
+    bool m_first_step;
+    bool m_found_end;
+
+public:
+    /**
+     * Constructor for GridBitboardBFSGraphAlgorithm.
+     *
+     * @param graph The grid graph to be traversed.
+     */
+    GridBitboardBFSGraphAlgorithm(GridGraph&& graph);
+
+    /**
+     * Executes the next step of the bitboard BFS.
+     *
+     * Every step visits the cells of the current level and finds the cells of the next one.
+     *
+     * @return True if there are more steps to be taken, false otherwise.
+     */
+    virtual bool nextStep() override;
+
+    /**
+     * Returns the current state of the graph.
+     *
+     * @return A constant reference to the current state of the graph.
+     */
+    virtual const Graph& getState() const override;
+};
+
+#endif
@@ -0,0 +1,57 @@
+#include "GridDistanceHeuristic.hpp"
+#include "PathGraph.hpp"
+
+#include <algorithm>
+
+// Octile distance is scaled by 1000 and uses 414 as a lower bound of 1000 * (sqrt(2) - 1),
+// so it stays an integer norm and can only underestimate
+static constexpr std::uint64_t octile_straight_cost = 1000;
+static constexpr std::uint64_t octile_diagonal_extra_cost = 414;
+
+GridDistanceHeuristic::GridDistanceHeuristic(const PathGraphTopology& topology, std::size_t target)
+    :   m_topology(topology),
+        m_target(target),
+        m_distance(GridDistance::Manhattan),
+        m_weight_numerator(0),
+        m_weight_denominator(1) {
+
+    for (auto& edge : topology.edges) {
+        auto& from = topology.grid_positions[edge.from_node_index];
+        auto& to = topology.grid_positions[edge.to_node_index];
+        if (from.first != to.first && from.second != to.second) {
+            m_distance = GridDistance::Octile;
+            break;
+        }
+    }
+
+    // Find the lowest weight per unit of length, edges without length can't make the estimate too high
+    bool found_ratio = false;
+    for (std::size_t i = 0; i < topology.edge_count; ++i) {
+        auto length = getGridDistance(topology.edges[i].from_node_index, topology.edges[i].to_node_index);
+        if (length == 0) {
+            continue;
+        }
+        auto weight = topology.edge_weights[i];
+        if (!found_ratio || weight * m_weight_denominator < m_weight_numerator * length) {
+            m_weight_numerator = weight;
+            m_weight_denominator = length;
+            found_ratio = true;
+        }
+    }
+}
+
+std::uint64_t GridDistanceHeuristic::getGridDistance(std::size_t from_node, std::size_t to_node) const {
+    auto& from = m_topology.grid_positions[from_node];
+    auto& to = m_topology.grid_positions[to_node];
+    std::uint64_t dx = (from.first > to.first) ? from.first - to.first : to.first - from.first;
+    std::uint64_t dy = (from.second > to.second) ? from.second - to.second : to.second - from.second;
+
+    if (m_distance == GridDistance::Manhattan) {
+        return dx + dy;
+    }
+    return octile_straight_cost * std::max(dx, dy) + octile_diagonal_extra_cost * std::min(dx, dy);
+}
+
+std::uint64_t GridDistanceHeuristic::operator()(std::size_t node) const {
+    return getGridDistance(node, m_target) * m_weight_numerator / m_weight_denominator;
+}
@@ -0,0 +1,45 @@
+#ifndef GridDistanceHeuristic_hpp
+#define GridDistanceHeuristic_hpp
+
+#include "PathGraph.hpp"
+#include <cstddef>
+#include <cstdint>
+
+// Enumeration representing the distance in the grid used by the heuristic
+enum class GridDistance { Manhattan, Octile };
+
+/**
+ * Class for the lower bound of the distance to a target node computed from grid coordinates of the nodes.
+ *
+ * It is the Manhattan distance in the grid, or the octile distance if there are diagonal edges, multiplied
+ * by the lowest ratio of edge weight to edge length over all edges of the topology. That keeps it consistent
+ * for any weights, also if some of the edges are left out.
+ */
+class GridDistanceHeuristic {
+    const PathGraphTopology& m_topology;
+    std::size_t m_target; // Index of the node the distance is estimated to
+    GridDistance m_distance;
+    std::uint64_t m_weight_numerator; // Lowest ratio of edge weight to edge length, multiplied by the distance
+    std::uint64_t m_weight_denominator;
+
+    /**
+     * Returns the grid distance between two nodes.
+     */
+    std::uint64_t getGridDistance(std::size_t from_node, std::size_t to_node) const;
+
+public:
+    /**
+     * Constructor for GridDistanceHeuristic. The distance is chosen from the directions of the edges.
+     *
+     * @param topology The topology of the path graph, it has to outlive the heuristic.
+     * @param target Index of the node the distance is estimated to.
+     */
+    GridDistanceHeuristic(const PathGraphTopology& topology, std::size_t target);
+
+    /**
+     * Returns the lower bound of the distance from the node to the target node.
+     */
+    std::uint64_t operator()(std::size_t node) const;
+};
+
+#endif
@@ -0,0 +1,397 @@
+#include "GridGraph.hpp"
+#include "Frame.hpp"
+#include "PathGraph.hpp"
+#include "PathGraphConfigLoader.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+static constexpr std::size_t rank_block_words = 8; // Words of m_has_node counted by one entry of m_node_ranks
+
+static constexpr GridDirection directions[] = {
+    GridDirection::Up, GridDirection::Right, GridDirection::Down, GridDirection::Left
+};
+
+GridDirection getOppositeDirection(GridDirection direction) {
+    return static_cast<GridDirection>((static_cast<std::uint8_t>(direction) + 2) % 4);
+}
+
+// Helper function to find the direction from one cell to its neighbour
+static GridDirection getDirection(std::pair<std::size_t, std::size_t> from, std::pair<std::size_t, std::size_t> to) {
+    if (from.second == to.second && from.first + 1 == to.first) {
+        return GridDirection::Right;
+    }
+    if (from.second == to.second && from.first == to.first + 1) {
+        return GridDirection::Left;
+    }
+    if (from.first == to.first && from.second + 1 == to.second) {
+        return GridDirection::Down;
+    }
+    if (from.first == to.first && from.second == to.second + 1) {
+        return GridDirection::Up;
+    }
+    throw std::runtime_error("Edge does not connect neighbouring cells of the grid");
+}
+
+// Helper function to read the nibble of the given node from an array with two cells per byte
+static std::uint8_t getNibble(const std::vector<std::uint8_t>& packed, std::size_t node) {
+    return (packed[node / 2] >> ((node % 2) * 4)) & 0x0F;
+}
+
+// Helper function to write the nibble of the given node into an array with two cells per byte
+static void setNibble(std::vector<std::uint8_t>& packed, std::size_t node, std::uint8_t value) {
+    auto shift = (node % 2) * 4;
+    packed[node / 2] = (packed[node / 2] & ~(0x0F << shift)) | ((value & 0x0F) << shift);
+}
+
+GridGraphTopology::GridGraphTopology(std::istream& config_input)
+    :   width(0),
+        height(0) {
+
+    std::size_t node_count = 0;
+    std::size_t previous_cell = 0;
+    bool ranks_valid = false;
+
+    auto config = streamPathGraphConfig(
+        config_input,
+        [&](const PathGraphConfig& config, std::size_t node_x, std::size_t node_y) {
+            previous_cell = addNode(config, node_x, node_y, node_count, previous_cell);
+            ++node_count;
+            ranks_valid = false;
+        },
+        [&](const PathGraphConfig&, std::size_t from_node, std::size_t to_node, std::size_t) {
+            if (!ranks_valid) {
+                buildNodeRanks();
+                ranks_valid = true;
+            }
+            auto from_cell = getNodeCell(from_node);
+            auto to_cell = getNodeCell(to_node);
+            auto direction = getDirection({from_cell % width, from_cell / width}, {to_cell % width, to_cell / width});
+
+            auto mask = getNibble(m_edge_masks, from_cell);
+            setNibble(m_edge_masks, from_cell, mask | (1 << static_cast<std::uint8_t>(direction)));
+        }
+    );
+    if (!ranks_valid) {
+        buildNodeRanks();
+    }
+
+    if (config.start_node >= node_count || config.end_node >= node_count) {
+        throw std::runtime_error("Invalid start or end node index");
+    }
+    start_node = getNodeCell(config.start_node);
+    end_node = getNodeCell(config.end_node);
+    node_color_palette = config.node_color_palette;
+    edge_color_palette = config.edge_color_palette;
+    background_color = config.background_color;
+    node_size = config.node_size;
+    edge_length = config.edge_length;
+    edge_width = config.edge_width;
+    frame_delay = config.frame_delay;
+}
+
+std::size_t GridGraphTopology::addNode(const PathGraphConfig& config, std::size_t node_x, std::size_t node_y,
+        std::size_t node_count, std::size_t previous_cell) {
+    // The grid data precedes the nodes, so the grid is allocated with the first node
+    if (node_count == 0) {
+        // Nodes read before the grid data would all be reported outside of a grid of size 0
+        if (config.grid_width == 0 || config.grid_height == 0) {
+            throw std::runtime_error("Grid algorithms need [GRID DATA] with a non-empty grid before [NODES]");
+        }
+        width = config.grid_width;
+        height = config.grid_height;
+        m_edge_masks.assign((width * height + 1) / 2, 0);
+        m_has_node.assign((width * height + 63) / 64, 0);
+    }
+    if (node_x >= width || node_y >= height) {
+        throw std::runtime_error("Node outside the grid: "
+            + std::to_string(node_x) + " " + std::to_string(node_y));
+    }
+    auto cell = node_y * width + node_x;
+
+    // Once a node is not after the previous one, the cells of all the nodes have to be stored
+    if (m_node_cells.empty() && node_count > 0 && cell <= previous_cell) {
+        m_node_cells.reserve(node_count + 1);
+        for (std::size_t word = 0; word < m_has_node.size(); ++word) {
+            for (auto bits = m_has_node[word]; bits != 0; bits &= bits - 1) {
+                m_node_cells.push_back(word * 64 + std::countr_zero(bits));
+            }
+        }
+    }
+    if (!m_node_cells.empty()) {
+        m_node_cells.push_back(cell);
+    }
+    m_has_node[cell / 64] |= std::uint64_t{1} << (cell % 64);
+    return cell;
+}
+
+void GridGraphTopology::buildNodeRanks() {
+    m_node_ranks.assign((m_has_node.size() + rank_block_words - 1) / rank_block_words, 0);
+    std::size_t count = 0;
+    for (std::size_t word = 0; word < m_has_node.size(); ++word) {
+        if (word % rank_block_words == 0) {
+            m_node_ranks[word / rank_block_words] = count;
+        }
+        count += std::popcount(m_has_node[word]);
+    }
+}
+
+std::size_t GridGraphTopology::getNodeCell(std::size_t index) const {
+    if (!m_node_cells.empty()) {
+        return m_node_cells[index];
+    }
+
+    // Last block with fewer nodes before it than the index, then the word and the bit inside it
+    auto block = std::upper_bound(m_node_ranks.begin(), m_node_ranks.end(), index) - m_node_ranks.begin() - 1;
+    auto remaining = index - m_node_ranks[block];
+    auto word = block * rank_block_words;
+    while (static_cast<std::size_t>(std::popcount(m_has_node[word])) <= remaining) {
+        remaining -= std::popcount(m_has_node[word]);
+        ++word;
+    }
+    auto bits = m_has_node[word];
+    std::size_t bit = 0;
+    while (static_cast<std::size_t>(std::popcount(bits & 0xFF)) <= remaining) {
+        remaining -= std::popcount(bits & 0xFF);
+        bits >>= 8;
+        bit += 8;
+    }
+    for (; remaining > 0; --remaining) {
+        bits &= bits - 1;
+    }
+    return word * 64 + bit + std::countr_zero(bits);
+}
+
+bool GridGraphTopology::hasNode(std::size_t node) const {
+    return (m_has_node[node / 64] >> (node % 64)) & 1;
+}
+
+bool GridGraphTopology::hasAnyEdge(std::size_t node) const {
+    return getNibble(m_edge_masks, node) != 0;
+}
+
+bool GridGraphTopology::hasEdge(std::size_t node, GridDirection direction) const {
+    return (getNibble(m_edge_masks, node) >> static_cast<std::uint8_t>(direction)) & 1;
+}
+
+std::size_t GridGraphTopology::getNeighbour(std::size_t node, GridDirection direction) const {
+    switch (direction) {
+        case GridDirection::Up:
+            return node - width;
+        case GridDirection::Right:
+            return node + 1;
+        case GridDirection::Down:
+            return node + width;
+        default:
+            return node - 1;
+    }
+}
+
+std::vector<std::size_t> GridGraphTopology::getNodeIndices(const std::vector<std::size_t>& nodes) const {
+    std::vector<std::size_t> indices;
+    indices.reserve(nodes.size());
+
+    if (m_node_cells.empty()) {
+        // Nodes are listed in the order of their cells, so the index is the number of nodes before the cell
+        for (auto node : nodes) {
+            auto word = node / 64;
+            auto index = m_node_ranks[word / rank_block_words];
+            for (auto counted = (word / rank_block_words) * rank_block_words; counted < word; ++counted) {
+                index += std::popcount(m_has_node[counted]);
+            }
+            index += std::popcount(m_has_node[word] & ((std::uint64_t{1} << (node % 64)) - 1));
+            indices.push_back(index);
+        }
+        return indices;
+    }
+
+    // One pass over all the nodes, the first node listed in a cell is used
+    std::unordered_map<std::size_t, std::size_t> positions;
+    for (std::size_t position = 0; position < nodes.size(); ++position) {
+        positions.emplace(nodes[position], position);
+    }
+    indices.assign(nodes.size(), m_node_cells.size());
+    for (std::size_t index = 0; index < m_node_cells.size(); ++index) {
+        auto position = positions.find(m_node_cells[index]);
+        if (position != positions.end() && indices[position->second] == m_node_cells.size()) {
+            indices[position->second] = index;
+        }
+    }
+    return indices;
+}
+
+GridGraph::GridGraph(std::shared_ptr<const GridGraphTopology> topology)
+    :   m_topology(std::move(topology)),
+        m_cell_states((m_topology->width * m_topology->height + 1) / 2, 0),
+        start_node(m_topology->start_node),
+        end_node(m_topology->end_node) {}
+
+const GridGraphTopology& GridGraph::getTopology() const {
+    return *m_topology;
+}
+
+PathNodeState GridGraph::getNodeState(std::size_t node) const {
+    return static_cast<PathNodeState>(getNibble(m_cell_states, node) & 0x03);
+}
+
+void GridGraph::setNodeState(std::size_t node, PathNodeState state) {
+    auto cell_state = getNibble(m_cell_states, node);
+    setNibble(m_cell_states, node, (cell_state & 0x0C) | static_cast<std::uint8_t>(state));
+}
+
+GridDirection GridGraph::getEnteredFrom(std::size_t node) const {
+    return static_cast<GridDirection>(getNibble(m_cell_states, node) >> 2);
+}
+
+void GridGraph::setEnteredFrom(std::size_t node, GridDirection direction) {
+    auto cell_state = getNibble(m_cell_states, node);
+    setNibble(m_cell_states, node, (cell_state & 0x03) | (static_cast<std::uint8_t>(direction) << 2));
+}
+
+PathEdgeState GridGraph::getEdgeState(std::size_t node, GridDirection direction) const {
+    auto neighbour = m_topology->getNeighbour(node, direction);
+    auto neighbour_state = getNodeState(neighbour);
+
+    if (neighbour == start_node
+        || neighbour_state == PathNodeState::NotFound
+        || getEnteredFrom(neighbour) != direction) {
+        return PathEdgeState::Default;
+    }
+
+    if (neighbour_state == PathNodeState::Found) {
+        return PathEdgeState::Peeked;
+    }
+    // The end node is only visited once the whole shortest path is marked
+    if (neighbour_state == PathNodeState::OnShortestPath || neighbour == end_node) {
+        return PathEdgeState::OnShortestPath;
+    }
+    return PathEdgeState::Used;
+}
+
+std::pair<std::size_t, std::size_t> GridGraph::getNodePosition(std::size_t node) const {
+    std::size_t margin = m_topology->node_size + (m_topology->node_size / 2);
+    std::size_t step = m_topology->node_size + m_topology->edge_length;
+
+    auto first = margin + ((node % m_topology->width) * step);
+    auto second = margin + ((node / m_topology->width) * step);
+    return std::pair<std::size_t, std::size_t>(first, second);
+}
+
+void GridGraph::draw(Frame& frame) const {
+    auto& topology = *m_topology;
+    frame.drawRectangle(
+        0,
+        0,
+        frame.width(),
+        frame.height(),
+        topology.background_color
+    );
+
+    std::size_t step = topology.node_size + topology.edge_length;
+    auto cell_count = topology.width * topology.height;
+
+    for (std::size_t node = 0; node < cell_count; ++node) {
+        if (!topology.hasAnyEdge(node)) {
+            continue;
+        }
+        auto position = getNodePosition(node);
+
+        for (auto direction : directions) {
+            if (!topology.hasEdge(node, direction)) {
+                continue;
+            }
+            auto is_horizontal = direction == GridDirection::Right || direction == GridDirection::Left;
+            auto direction_from_top_left = direction == GridDirection::Right || direction == GridDirection::Down;
+            auto pos_x = position.first;
+            auto pos_y = position.second;
+            if (is_horizontal) {
+                pos_x = direction_from_top_left ? pos_x + step / 2 : pos_x - (step + 1) / 2;
+            }
+            else {
+                pos_y = direction_from_top_left ? pos_y + step / 2 : pos_y - (step + 1) / 2;
+            }
+
+            PathEdge edge(
+                node,
+                topology.getNeighbour(node, direction),
+                topology.edge_length,
+                topology.edge_width,
+                pos_x,
+                pos_y,
+                is_horizontal,
+                direction_from_top_left,
+                topology.edge_color_palette
+            );
+            edge.draw(frame, getEdgeState(node, direction));
+        }
+    }
+
+    for (std::size_t node = 0; node < cell_count; ++node) {
+        if (!topology.hasNode(node)) {
+            continue;
+        }
+        auto position = getNodePosition(node);
+
+        PathNode path_node(
+            position.first,
+            position.second,
+            topology.node_size,
+            topology.node_color_palette,
+            node == start_node,
+            node == end_node
+        );
+        path_node.draw(frame, getNodeState(node));
+    }
+}
+
+std::unique_ptr<Graph> GridGraph::clone() const {
+    return std::make_unique<GridGraph>(*this);
+}
+
+std::vector<std::size_t> GridGraph::getMarkedPath() const {
+    auto& topology = *m_topology;
+    auto cell_count = topology.width * topology.height;
+    std::vector<std::size_t> path{start_node};
+
+    // Other cells of a shortest path are never reachable by an edge from the current one,
+    // that would be a shortcut, so at most one edge is marked as part of the path
+    while (path.back() != end_node && path.size() <= cell_count) {
+        auto node = path.back();
+        bool extended = false;
+        for (auto direction : directions) {
+            if (topology.hasEdge(node, direction)
+                && getEdgeState(node, direction) == PathEdgeState::OnShortestPath) {
+                path.push_back(topology.getNeighbour(node, direction));
+                extended = true;
+                break;
+            }
+        }
+        if (!extended) {
+            return {};
+        }
+    }
+    if (path.back() != end_node) {
+        return {};
+    }
+    return path;
+}
+
+void GridGraph::printResult(std::ostream& output) const {
+    auto path = getMarkedPath();
+
+    if (path.empty()) {
+        output << "Path: not found" << std::endl;
+        return;
+    }
+
+    output << "Path length: " << path.size() - 1 << std::endl;
+    output << "Path:";
+    for (auto index : m_topology->getNodeIndices(path)) {
+        output << " " << index;
+    }
+    output << std::endl;
+}
@@ -0,0 +1,210 @@
+#ifndef GridGraph_hpp
+#define GridGraph_hpp
+
+#include "Graph.hpp"
+#include "PathGraph.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <vector>
+
+// Enumeration representing the direction of an edge leaving a grid cell
+enum class GridDirection : std::uint8_t { Up, Right, Down, Left };
+
+/**
+ * Class representing the immutable topology and layout of an implicit 4-connected grid graph.
+ *
+ * Node id of a cell is y * width + x. Instead of explicit node and edge objects every cell stores
+ * a 4-bit mask of its outgoing edges, two cells per byte. Neighbours are computed from the id.
+ * Like PathGraphTopology it is built once and shared by any number of GridGraph states.
+ *
+ * It is built straight from the configuration stream, so the node and edge lists of the configuration
+ * are never held in memory. When the nodes are listed in the order of their cells, as in generated grids,
+ * the index of a node in the configuration is the number of nodes in the cells before it and only
+ * a small rank directory is stored, otherwise the cell of every node is kept.
+ */
+class GridGraphTopology {
+    std::vector<std::uint8_t> m_edge_masks; // Outgoing edge masks, two cells per byte
+    std::vector<std::uint64_t> m_has_node; // Bit set of the cells with a node
+    std::vector<std::size_t> m_node_ranks; // Number of nodes before every block of m_has_node words
+    std::vector<std::size_t> m_node_cells; // Cell of every node in the order of the configuration, empty if
+                                           // the nodes are listed in the order of their cells
+
+    /**
+     * Adds a node read from the configuration.
+     *
+     * @param config The part of the configuration read so far.
+     * @param node_x The x coordinate of the node.
+     * @param node_y The y coordinate of the node.
+     * @param node_count The number of nodes added before this one.
+     * @param previous_cell The cell of the previous node.
+     * @return The cell of the node.
+     * @throws std::runtime_error if the node lies outside the grid.
+     */
+    std::size_t addNode(const PathGraphConfig& config, std::size_t node_x, std::size_t node_y, std::size_t node_count,
+        std::size_t previous_cell);
+
+    /**
+     * Counts the nodes before every block of cells, so the cells of the nodes can be found by their index.
+     */
+    void buildNodeRanks();
+
+    /**
+     * Returns the cell of the node with the given index in the configuration.
+     */
+    std::size_t getNodeCell(std::size_t index) const;
+
+public:
+    std::size_t width; // Width of the grid
+    std::size_t height; // Height of the grid
+    std::size_t start_node; // Id of the start node
+    std::size_t end_node; // Id of the end node
+    PathNodeColorPalette node_color_palette;
+    PathEdgeColorPalette edge_color_palette;
+    Color background_color;
+    std::size_t node_size;
+    std::size_t edge_length;
+    std::size_t edge_width;
+    std::size_t frame_delay; // Frame delay in tens of miliseconds
+
+    /**
+     * Constructor for GridGraphTopology.
+     *
+     * @param config_input The stream with the path graph configuration. Edges have to connect neighbouring cells
+     * and the grid data has to precede the nodes.
+     * @throws std::runtime_error if the configuration is invalid, the nodes precede the grid data,
+     * a node lies outside the grid or an edge does not connect neighbouring cells.
+     */
+    GridGraphTopology(std::istream& config_input);
+
+    /**
+     * Returns true if there is a node in the cell with the given id.
+     */
+    bool hasNode(std::size_t node) const;
+
+    /**
+     * Returns true if there is any edge leaving the node.
+     */
+    bool hasAnyEdge(std::size_t node) const;
+
+    /**
+     * Returns true if there is an edge leaving the node in the given direction.
+     */
+    bool hasEdge(std::size_t node, GridDirection direction) const;
+
+    /**
+     * Returns the id of the neighbouring cell in the given direction.
+     * The caller has to make sure the neighbour exists (e.g. by hasEdge()).
+     */
+    std::size_t getNeighbour(std::size_t node, GridDirection direction) const;
+
+    /**
+     * Returns the indices of the nodes in the configuration for the given node ids.
+     *
+     * @param nodes Ids of distinct cells with a node.
+     * @return The index of every node in the order of the given ids.
+     */
+    std::vector<std::size_t> getNodeIndices(const std::vector<std::size_t>& nodes) const;
+};
+
+/**
+ * Class representing the state of a run of an algorithm on a grid graph, derived from the Graph base class.
+ *
+ * Every cell stores a 4-bit state (PathNodeState and the direction the node was entered from),
+ * two cells per byte, so a 10k x 10k grid takes roughly 100 MB together with its topology.
+ */
+class GridGraph : public Graph {
+    std::shared_ptr<const GridGraphTopology> m_topology; // Shared topology and layout of the graph
+    std::vector<std::uint8_t> m_cell_states; // Node state and entered from direction, two cells per byte
+
+    /**
+     * Returns the state of the edge leaving the node in the given direction.
+     * Only the edge a node was entered by is ever colored, so the state is derived from that node.
+     *
+     * @param node Id of the node the edge leaves from.
+     * @param direction Direction of the edge.
+     * @return The state of the edge.
+     */
+    PathEdgeState getEdgeState(std::size_t node, GridDirection direction) const;
+
+    /**
+     * Returns the pixel position of the center of the node.
+     *
+     * @param node Id of the node.
+     * @return A pair containing the x and y coordinates of the node position.
+     */
+    std::pair<std::size_t, std::size_t> getNodePosition(std::size_t node) const;
+
+public:
+    std::size_t start_node; // Id of the start node
+    std::size_t end_node; // Id of the end node
+
+    /**
+     * Constructor for GridGraph. All nodes start in their default state.
+     *
+     * @param topology The shared topology of the grid graph.
+     */
+    GridGraph(std::shared_ptr<const GridGraphTopology> topology);
+
+    /**
+     * Returns the topology of the graph.
+     *
+     * @return A constant reference to the shared topology.
+     */
+    const GridGraphTopology& getTopology() const;
+
+    /**
+     * Returns the state of the node.
+     */
+    PathNodeState getNodeState(std::size_t node) const;
+
+    /**
+     * Sets the state of the node. Only states up to OnShortestPath fit into a cell.
+     */
+    void setNodeState(std::size_t node, PathNodeState state);
+
+    /**
+     * Returns the direction of the edge the node was entered by.
+     */
+    GridDirection getEnteredFrom(std::size_t node) const;
+
+    /**
+     * Sets the direction of the edge the node was entered by.
+     */
+    void setEnteredFrom(std::size_t node, GridDirection direction);
+
+    /**
+     * Draws the grid graph on the given frame.
+     *
+     * @param frame The frame on which the grid graph should be drawn.
+     */
+    virtual void draw(Frame& frame) const override;
+
+    /**
+     * Returns a copy of the cell states, the topology is shared with the copy.
+     */
+    virtual std::unique_ptr<Graph> clone() const override;
+
+    /**
+     * Returns the cells of the path marked as the shortest one, in the order from the start node to the end node.
+     *
+     * @return The node ids, empty if no path from the start node to the end node is marked.
+     */
+    std::vector<std::size_t> getMarkedPath() const;
+
+    /**
+     * Prints the length and the nodes of the path marked as the shortest one.
+     * The nodes are printed as their indices in the configuration, like for the other path graphs.
+     *
+     * @param output The stream the result is printed to.
+     */
+    virtual void printResult(std::ostream& output) const override;
+};
+
+/**
+ * Returns the direction opposite to the given one.
+ */
+GridDirection getOppositeDirection(GridDirection direction);
+
+#endif
\ No newline at end of file
@@ -0,0 +1,86 @@
+#include "GridOccupancy.hpp"
+#include "GridGraph.hpp"
+#include "PathGraph.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+static constexpr std::size_t no_index = std::numeric_limits<std::size_t>::max();
+
+GridOccupancy::GridOccupancy(const PathGraphTopology& topology)
+    :   m_node_edges(topology.node_count * 4, no_index),
+        width(0),
+        height(0),
+        edge_weight(topology.edge_weights.empty() ? 1 : topology.edge_weights.front()) {
+
+    for (auto& position : topology.grid_positions) {
+        width = std::max(width, static_cast<std::int64_t>(position.first) + 1);
+        height = std::max(height, static_cast<std::int64_t>(position.second) + 1);
+    }
+
+    m_cell_nodes.assign(width * height, no_index);
+    for (std::size_t i = 0; i < topology.node_count; ++i) {
+        auto& position = topology.grid_positions[i];
+        auto& cell = m_cell_nodes[position.second * width + position.first];
+        if (cell != no_index) {
+            throw std::runtime_error("Grid is not uniform: two nodes in one cell");
+        }
+        cell = i;
+    }
+
+    for (std::size_t i = 0; i < topology.edge_count; ++i) {
+        auto& edge = topology.edges[i];
+        auto& from = topology.grid_positions[edge.from_node_index];
+        auto& to = topology.grid_positions[edge.to_node_index];
+
+        GridDirection direction;
+        if (from.second == to.second && from.first + 1 == to.first) {
+            direction = GridDirection::Right;
+        }
+        else if (from.second == to.second && from.first == to.first + 1) {
+            direction = GridDirection::Left;
+        }
+        else if (from.first == to.first && from.second + 1 == to.second) {
+            direction = GridDirection::Down;
+        }
+        else if (from.first == to.first && from.second == to.second + 1) {
+            direction = GridDirection::Up;
+        }
+        else {
+            throw std::runtime_error("Grid is not uniform: edge does not connect neighbouring cells");
+        }
+        if (topology.edge_weights[i] != edge_weight) {
+            throw std::runtime_error("Grid is not uniform: edges have different weights");
+        }
+        m_node_edges[edge.from_node_index * 4 + static_cast<std::size_t>(direction)] = i;
+    }
+
+    // Every two neighbouring nodes have to be connected in both directions
+    for (std::int64_t y = 0; y < height; ++y) {
+        for (std::int64_t x = 0; x < width; ++x) {
+            if (!isOpen(x, y)) {
+                continue;
+            }
+            auto node = getNode(x, y);
+            if ((isOpen(x + 1, y) && (getEdge(node, GridDirection::Right) == no_index
+                    || getEdge(getNode(x + 1, y), GridDirection::Left) == no_index))
+                || (isOpen(x, y + 1) && (getEdge(node, GridDirection::Down) == no_index
+                    || getEdge(getNode(x, y + 1), GridDirection::Up) == no_index))) {
+                throw std::runtime_error("Grid is not uniform: neighbouring nodes are not connected in both directions");
+            }
+        }
+    }
+}
+
+bool GridOccupancy::isOpen(std::int64_t x, std::int64_t y) const {
+    return x >= 0 && y >= 0 && x < width && y < height && m_cell_nodes[y * width + x] != no_index;
+}
+
+std::size_t GridOccupancy::getNode(std::int64_t x, std::int64_t y) const {
+    return m_cell_nodes[y * width + x];
+}
+
+std::size_t GridOccupancy::getEdge(std::size_t node, GridDirection direction) const {
+    return m_node_edges[node * 4 + static_cast<std::size_t>(direction)];
+}
@@ -0,0 +1,49 @@
+#ifndef GridOccupancy_hpp
+#define GridOccupancy_hpp
+
+#include "GridGraph.hpp"
+#include "PathGraph.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Class answering which cells of a uniform 4-connected grid are open, built from a path graph topology.
+ *
+ * In a uniform grid every two nodes in neighbouring cells are connected in both directions, there are
+ * no other edges and all edges have the same weight, so a path only depends on which cells have a node.
+ */
+class GridOccupancy {
+    std::vector<std::size_t> m_cell_nodes; // Index of the node in each cell
+    std::vector<std::size_t> m_node_edges; // Index of the edge leaving each node in each of the four directions
+
+public:
+    std::int64_t width; // Width of the grid
+    std::int64_t height; // Height of the grid
+    std::size_t edge_weight; // Weight shared by all the edges
+
+    /**
+     * Constructor for GridOccupancy.
+     *
+     * @param topology The topology of the path graph.
+     * @throws std::runtime_error if the graph isn't a uniform 4-connected grid.
+     */
+    GridOccupancy(const PathGraphTopology& topology);
+
+    /**
+     * Returns true if there is a node in the cell, false for cells outside the grid.
+     */
+    bool isOpen(std::int64_t x, std::int64_t y) const;
+
+    /**
+     * Returns the index of the node in the cell. The cell has to be open.
+     */
+    std::size_t getNode(std::int64_t x, std::int64_t y) const;
+
+    /**
+     * Returns the index of the edge leaving the node in the given direction. The neighbouring cell has to be open.
+     */
+    std::size_t getEdge(std::size_t node, GridDirection direction) const;
+};
+
+#endif
@@ -0,0 +1,10 @@
+#include "HeadlessRunner.hpp"
+
+#include <chrono>
+
+HeadlessRunReport runHeadless(GraphAlgorithm& algorithm) {
+    auto start = std::chrono::steady_clock::now();
+    auto step_count = algorithm.run();
+    auto end = std::chrono::steady_clock::now();
+    return {step_count, std::chrono::duration<double, std::milli>(end - start).count()};
+}
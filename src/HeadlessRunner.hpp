@@ -0,0 +1,22 @@
+#ifndef HeadlessRunner_hpp
+#define HeadlessRunner_hpp
+
+#include "GraphAlgorithm.hpp"
+#include <cstddef>
+
+// Structure holding the statistics of a run of an algorithm without drawing
+struct HeadlessRunReport {
+    std::size_t step_count; // Number of steps including the initial state
+    double wall_time; // Wall time of the run in milliseconds
+};
+
+/**
+ * Runs the algorithm to completion without drawing any step, so the measured time is the computation alone.
+ * The result stays in the final state of the graph, see Graph::printResult().
+ *
+ * @param algorithm The algorithm, it must not have been run yet.
+ * @return The number of steps and the wall time of the run.
+ */
+HeadlessRunReport runHeadless(GraphAlgorithm& algorithm);
+
+#endif
@@ -0,0 +1,204 @@
+#include "JumpPointSearchGraphAlgorithm.hpp"
+#include "GridGraph.hpp"
+#include "PathGraph.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+static constexpr std::uint64_t infinite_distance = std::numeric_limits<std::uint64_t>::max();
+static constexpr std::size_t no_node = std::numeric_limits<std::size_t>::max();
+
+// Helper function to find the step in x and y coordinates of the direction
+static std::pair<std::int64_t, std::int64_t> getStep(GridDirection direction) {
+    switch (direction) {
+        case GridDirection::Up:
+            return {0, -1};
+        case GridDirection::Right:
+            return {1, 0};
+        case GridDirection::Down:
+            return {0, 1};
+        default:
+            return {-1, 0};
+    }
+}
+
+bool JumpPointSearchGraphAlgorithm::OpenEntry::operator>(const OpenEntry& other) const {
+    if (estimate != other.estimate) {
+        return estimate > other.estimate;
+    }
+    if (heuristic != other.heuristic) {
+        return heuristic > other.heuristic;
+    }
+    return node > other.node;
+}
+
+JumpPointSearchGraphAlgorithm::JumpPointSearchGraphAlgorithm(PathGraph&& graph)
+    :   m_graph(std::move(graph)),
+        m_occupancy(m_graph.getTopology()),
+        m_distance(m_graph.node_count, infinite_distance),
+        m_parent(m_graph.node_count, no_node),
+        m_entered_in(m_graph.node_count, GridDirection::Up),
+        m_first_step(true),
+        m_found_end(false) {}
+
+std::uint64_t JumpPointSearchGraphAlgorithm::getDistance(std::size_t from_node, std::size_t to_node) const {
+    auto& from = m_graph.getTopology().grid_positions[from_node];
+    auto& to = m_graph.getTopology().grid_positions[to_node];
+    std::uint64_t dx = (from.first > to.first) ? from.first - to.first : to.first - from.first;
+    std::uint64_t dy = (from.second > to.second) ? from.second - to.second : to.second - from.second;
+    return (dx + dy) * m_occupancy.edge_weight;
+}
+
+std::size_t JumpPointSearchGraphAlgorithm::jumpHorizontally(std::int64_t x, std::int64_t y, std::int64_t dx) const {
+    while (true) {
+        x += dx;
+        if (!m_occupancy.isOpen(x, y)) {
+            return no_node;
+        }
+        auto node = m_occupancy.getNode(x, y);
+        if (node == m_graph.end_node) {
+            return node;
+        }
+
+        // A vertical neighbour is forced if the cell before it is closed, no vertical-first path leads to it
+        if ((m_occupancy.isOpen(x, y - 1) && !m_occupancy.isOpen(x - dx, y - 1))
+            || (m_occupancy.isOpen(x, y + 1) && !m_occupancy.isOpen(x - dx, y + 1))) {
+            return node;
+        }
+    }
+}
+
+std::size_t JumpPointSearchGraphAlgorithm::jumpVertically(std::int64_t x, std::int64_t y, std::int64_t dy) const {
+    while (true) {
+        y += dy;
+        if (!m_occupancy.isOpen(x, y)) {
+            return no_node;
+        }
+        auto node = m_occupancy.getNode(x, y);
+        if (node == m_graph.end_node) {
+            return node;
+        }
+
+        // The cell is a jump point if a horizontal jump from it leads anywhere
+        if (jumpHorizontally(x, y, -1) != no_node || jumpHorizontally(x, y, 1) != no_node) {
+            return node;
+        }
+    }
+}
+
+void JumpPointSearchGraphAlgorithm::markShortestPath() {
+    auto& topology = m_graph.getTopology();
+    auto node_index = m_graph.end_node;
+
+    while (node_index != m_graph.start_node) {
+        // Walk back along the straight jump to the previous jump point
+        auto direction = m_entered_in[node_index];
+        auto opposite = getOppositeDirection(direction);
+        auto [dx, dy] = getStep(opposite);
+        auto parent = m_parent[node_index];
+        std::int64_t x = topology.grid_positions[node_index].first;
+        std::int64_t y = topology.grid_positions[node_index].second;
+
+        while (node_index != parent) {
+            auto previous = m_occupancy.getNode(x + dx, y + dy);
+            m_graph.edge_states[m_occupancy.getEdge(previous, direction)] = PathEdgeState::OnShortestPath;
+            if (previous != m_graph.start_node) {
+                m_graph.node_states[previous] = PathNodeState::OnShortestPath;
+            }
+            node_index = previous;
+            x += dx;
+            y += dy;
+        }
+    }
+}
+
+bool JumpPointSearchGraphAlgorithm::nextStep() {
+    // Lets the renderer draw the initial state of graph
+    if (m_first_step) {
+        auto heuristic = getDistance(m_graph.start_node, m_graph.end_node);
+        m_distance[m_graph.start_node] = 0;
+        m_open_list.push_back({heuristic, heuristic, m_graph.start_node});
+        m_first_step = false;
+        return true;
+    }
+
+    if (m_found_end) {
+        return false;
+    }
+
+    // Skip entries of nodes which were closed or pushed again with a shorter distance
+    OpenEntry entry;
+    do {
+        // We are finished
+        if (m_open_list.empty()) {
+            return false;
+        }
+        std::pop_heap(m_open_list.begin(), m_open_list.end(), std::greater<OpenEntry>());
+        entry = m_open_list.back();
+        m_open_list.pop_back();
+    } while (m_graph.node_states[entry.node] == PathNodeState::Visited
+        || entry.estimate - entry.heuristic != m_distance[entry.node]);
+
+    auto& topology = m_graph.getTopology();
+    auto node_index = entry.node;
+    m_graph.node_states[node_index] = PathNodeState::Visited;
+
+    // We found the end node
+    if (node_index == m_graph.end_node) {
+        if (node_index == m_graph.start_node) {
+            m_graph.node_states[node_index] = PathNodeState::OnShortestPath;
+        }
+        markShortestPath();
+        m_found_end = true;
+        return true;
+    }
+
+    // Directions worth jumping in, the start node tries all of them
+    std::int64_t x = topology.grid_positions[node_index].first;
+    std::int64_t y = topology.grid_positions[node_index].second;
+    std::vector<GridDirection> directions;
+    if (node_index == m_graph.start_node) {
+        directions = {GridDirection::Up, GridDirection::Right, GridDirection::Down, GridDirection::Left};
+    }
+    else if (m_entered_in[node_index] == GridDirection::Up || m_entered_in[node_index] == GridDirection::Down) {
+        directions = {m_entered_in[node_index], GridDirection::Right, GridDirection::Left};
+    }
+    else {
+        auto dx = getStep(m_entered_in[node_index]).first;
+        directions = {m_entered_in[node_index]};
+        if (m_occupancy.isOpen(x, y - 1) && !m_occupancy.isOpen(x - dx, y - 1)) {
+            directions.push_back(GridDirection::Up);
+        }
+        if (m_occupancy.isOpen(x, y + 1) && !m_occupancy.isOpen(x - dx, y + 1)) {
+            directions.push_back(GridDirection::Down);
+        }
+    }
+
+    for (auto direction : directions) {
+        auto [dx, dy] = getStep(direction);
+        auto jump_point = (dx != 0) ? jumpHorizontally(x, y, dx) : jumpVertically(x, y, dy);
+        if (jump_point == no_node || m_graph.node_states[jump_point] == PathNodeState::Visited) {
+            continue;
+        }
+
+        auto new_distance = m_distance[node_index] + getDistance(node_index, jump_point);
+        if (new_distance >= m_distance[jump_point]) {
+            continue;
+        }
+        m_graph.node_states[jump_point] = PathNodeState::Found;
+        m_distance[jump_point] = new_distance;
+        m_parent[jump_point] = node_index;
+        m_entered_in[jump_point] = direction;
+
+        auto heuristic = getDistance(jump_point, m_graph.end_node);
+        m_open_list.push_back({new_distance + heuristic, heuristic, jump_point});
+        std::push_heap(m_open_list.begin(), m_open_list.end(), std::greater<OpenEntry>());
+    }
+
+    return true;
+}
+
+const Graph& JumpPointSearchGraphAlgorithm::getState() const {
+    return m_graph;
+}
@@ -0,0 +1,96 @@
+#ifndef JumpPointSearchGraphAlgorithm_hpp
+#define JumpPointSearchGraphAlgorithm_hpp
+
+#include "GraphAlgorithm.hpp"
+#include "GridGraph.hpp"
+#include "GridOccupancy.hpp"
+#include "PathGraph.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Class for Jump Point Search (JPS) finding the shortest path in a uniform 4-connected grid.
+ *
+ * It is A* over jump points only. Of all the shortest paths it considers just the ones going vertically
+ * first and turning horizontally, so it can jump over straight runs of cells without expanding them:
+ * a vertical jump scans horizontally from every cell it passes, a horizontal jump stops where a vertical
+ * neighbour can't be reached by any vertical-first path (a forced neighbour).
+ */
+class JumpPointSearchGraphAlgorithm : public GraphAlgorithm {
+    // Entry of the open list, outdated entries are skipped when popped
+    struct OpenEntry {
+        std::uint64_t estimate; // Distance from the start node plus the heuristic
+        std::uint64_t heuristic;
+        std::size_t node;
+
+        bool operator>(const OpenEntry& other) const;
+    };
+
+    PathGraph m_graph;
+    GridOccupancy m_occupancy;
+    std::vector<OpenEntry> m_open_list; // Binary min-heap of open (found) jump points
+    std::vector<std::uint64_t> m_distance; // Tentative distance of each jump point from the start node
+    std::vector<std::size_t> m_parent; // Previous jump point on the path to each jump point
+    std::vector<GridDirection> m_entered_in; // Direction of the jump each jump point was reached by
+    bool m_first_step;
+    bool m_found_end;
+
+    /**
+     * Returns the Manhattan distance between two nodes multiplied by the edge weight.
+     */
+    std::uint64_t getDistance(std::size_t from_node, std::size_t to_node) const;
+
+    /**
+     * Moves horizontally from the cell until a jump point is found.
+     *
+     * @param x x-coordinate of the cell the jump starts from.
+     * @param y y-coordinate of the cell the jump starts from.
+     * @param dx Direction of the jump, 1 or -1.
+     * @return Index of the jump point, or no node if the jump hits a closed cell.
+     */
+    std::size_t jumpHorizontally(std::int64_t x, std::int64_t y, std::int64_t dx) const;
+
+    /**
+     * Moves vertically from the cell until a jump point is found.
+     *
+     * @param x x-coordinate of the cell the jump starts from.
+     * @param y y-coordinate of the cell the jump starts from.
+     * @param dy Direction of the jump, 1 or -1.
+     * @return Index of the jump point, or no node if the jump hits a closed cell.
+     */
+    std::size_t jumpVertically(std::int64_t x, std::int64_t y, std::int64_t dy) const;
+
+    /**
+     * Backtracks from the end node and marks all the cells and edges between the jump points on the shortest path.
+     */
+    void markShortestPath();
+
+public:
+    /**
+     * Constructor for JumpPointSearchGraphAlgorithm.
+     *
+     * @param graph The graph in which the shortest path is found.
+     * @throws std::runtime_error if the graph isn't a uniform 4-connected grid.
+     */
+    JumpPointSearchGraphAlgorithm(PathGraph&& graph);
+
+    /**
+     * Executes the next step of Jump Point Search.
+     *
+     * Every step expands the open jump point with the lowest estimate. Only jump points are shown
+     * as found and visited, cells jumped over keep their state.
+     *
+     * @return True if there are more steps to be taken, false otherwise.
+     */
+    virtual bool nextStep() override;
+
+    /**
+     * Returns the current state of the graph.
+     *
+     * @return A constant reference to the current state of the graph.
+     */
+    virtual const Graph& getState() const override;
+};
+
+#endif
@@ -0,0 +1,262 @@
+#include "LifelongPlanningAStarGraphAlgorithm.hpp"
+#include "PathGraph.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+static constexpr std::uint64_t infinite_distance = std::numeric_limits<std::uint64_t>::max();
+static constexpr std::size_t no_edge = std::numeric_limits<std::size_t>::max();
+
+bool LifelongPlanningAStarGraphAlgorithm::QueueEntry::operator>(const QueueEntry& other) const {
+    if (estimate != other.estimate) {
+        return estimate > other.estimate;
+    }
+    if (distance != other.distance) {
+        return distance > other.distance;
+    }
+    return node > other.node;
+}
+
+LifelongPlanningAStarGraphAlgorithm::LifelongPlanningAStarGraphAlgorithm(PathGraph&& graph,
+    const std::vector<PathEdgeChange>& changes)
+    :   m_graph(std::move(graph)),
+        m_heuristic(m_graph.getTopology(), m_graph.end_node),
+        m_next_change(0),
+        m_step(0),
+        m_edge_active(m_graph.edge_count, true),
+        m_distance(m_graph.node_count, infinite_distance),
+        m_lookahead(m_graph.node_count, infinite_distance),
+        m_best_edge(m_graph.node_count, no_edge),
+        m_first_step(true),
+        m_path_shown(false) {
+
+    auto& topology = m_graph.getTopology();
+    // With edges of weight 0 a node could keep its distance over a cycle after its real path is removed
+    for (auto weight : topology.edge_weights) {
+        if (weight == 0) {
+            throw std::runtime_error("LPA* requires positive edge weights");
+        }
+    }
+
+    for (auto& change : changes) {
+        if (change.from_node >= m_graph.node_count || change.to_node >= m_graph.node_count) {
+            throw std::runtime_error("Invalid node index in edge change");
+        }
+        auto outgoing = topology.getOutgoingEdges(change.from_node);
+        auto edge = std::find_if(outgoing.begin(), outgoing.end(), [&](std::size_t edge_index) {
+            return topology.edges[edge_index].to_node_index == change.to_node;
+        });
+        if (edge == outgoing.end()) {
+            throw std::runtime_error("Changed edge is not in the graph: "
+                + std::to_string(change.from_node) + " " + std::to_string(change.to_node));
+        }
+        m_changes.push_back({change.step, change.insert, *edge});
+    }
+
+    // An edge first inserted by the script is missing until then
+    std::vector<bool> is_changed(m_graph.edge_count, false);
+    for (auto& change : m_changes) {
+        if (!is_changed[change.edge] && change.insert) {
+            m_edge_active[change.edge] = false;
+            m_graph.edge_states[change.edge] = PathEdgeState::Removed;
+        }
+        is_changed[change.edge] = true;
+    }
+}
+
+LifelongPlanningAStarGraphAlgorithm::QueueEntry LifelongPlanningAStarGraphAlgorithm::calculateKey(std::size_t node) const {
+    auto distance = std::min(m_distance[node], m_lookahead[node]);
+    if (distance == infinite_distance) {
+        return {infinite_distance, infinite_distance, node};
+    }
+    return {distance + m_heuristic(node), distance, node};
+}
+
+void LifelongPlanningAStarGraphAlgorithm::skipOutdatedEntries() {
+    // An entry is outdated if its node became consistent or was queued again with another key
+    while (!m_queue.empty()) {
+        auto& top = m_queue.front();
+        auto key = calculateKey(top.node);
+        if (m_distance[top.node] != m_lookahead[top.node]
+            && key.estimate == top.estimate && key.distance == top.distance) {
+            return;
+        }
+        std::pop_heap(m_queue.begin(), m_queue.end(), std::greater<QueueEntry>());
+        m_queue.pop_back();
+    }
+}
+
+bool LifelongPlanningAStarGraphAlgorithm::isSearchFinished() {
+    skipOutdatedEntries();
+    auto end_node = m_graph.end_node;
+    if (m_distance[end_node] != m_lookahead[end_node]) {
+        return false;
+    }
+    return m_queue.empty() || !(calculateKey(end_node) > m_queue.front());
+}
+
+void LifelongPlanningAStarGraphAlgorithm::updateNode(std::size_t node) {
+    if (node != m_graph.start_node) {
+        auto& topology = m_graph.getTopology();
+        auto old_edge = m_best_edge[node];
+
+        std::uint64_t lookahead = infinite_distance;
+        std::size_t best_edge = no_edge;
+        for (auto edge_index : topology.getIncomingEdges(node)) {
+            auto predecessor = topology.edges[edge_index].from_node_index;
+            if (!m_edge_active[edge_index] || m_distance[predecessor] == infinite_distance) {
+                continue;
+            }
+            auto distance = m_distance[predecessor] + topology.edge_weights[edge_index];
+            if (distance < lookahead) {
+                lookahead = distance;
+                best_edge = edge_index;
+            }
+        }
+
+        if (old_edge != best_edge && old_edge != no_edge && m_edge_active[old_edge]) {
+            m_graph.edge_states[old_edge] = PathEdgeState::Default;
+        }
+        m_lookahead[node] = lookahead;
+        m_best_edge[node] = best_edge;
+    }
+
+    if (m_distance[node] != m_lookahead[node]) {
+        m_queue.push_back(calculateKey(node));
+        std::push_heap(m_queue.begin(), m_queue.end(), std::greater<QueueEntry>());
+    }
+    showNode(node);
+}
+
+void LifelongPlanningAStarGraphAlgorithm::showNode(std::size_t node) {
+    auto consistent = m_distance[node] == m_lookahead[node];
+    if (!consistent) {
+        m_graph.node_states[node] = PathNodeState::Found;
+    }
+    else if (m_distance[node] != infinite_distance) {
+        m_graph.node_states[node] = PathNodeState::Visited;
+    }
+    else {
+        m_graph.node_states[node] = PathNodeState::NotFound;
+    }
+
+    auto edge_index = m_best_edge[node];
+    if (edge_index != no_edge) {
+        m_graph.edge_states[edge_index] = consistent ? PathEdgeState::Used : PathEdgeState::Peeked;
+    }
+}
+
+void LifelongPlanningAStarGraphAlgorithm::applyChanges() {
+    auto& topology = m_graph.getTopology();
+
+    while (m_next_change < m_changes.size() && m_changes[m_next_change].step <= m_step) {
+        auto& change = m_changes[m_next_change++];
+        if (m_edge_active[change.edge] == change.insert) {
+            continue;
+        }
+        if (m_path_shown) {
+            unmarkShortestPath();
+        }
+
+        m_edge_active[change.edge] = change.insert;
+        m_graph.edge_states[change.edge] = change.insert ? PathEdgeState::Default : PathEdgeState::Removed;
+        // Only the node the edge enters can get a different rhs
+        updateNode(topology.edges[change.edge].to_node_index);
+    }
+}
+
+void LifelongPlanningAStarGraphAlgorithm::markShortestPath() {
+    auto& topology = m_graph.getTopology();
+    m_path_shown = true;
+    m_path.clear();
+    if (m_distance[m_graph.end_node] == infinite_distance) {
+        return;
+    }
+
+    auto node_index = m_graph.end_node;
+    m_path.push_back(node_index);
+    if (node_index == m_graph.start_node) {
+        m_graph.node_states[node_index] = PathNodeState::OnShortestPath;
+    }
+    while (node_index != m_graph.start_node) {
+        auto edge_index = m_best_edge[node_index];
+        m_graph.edge_states[edge_index] = PathEdgeState::OnShortestPath;
+        node_index = topology.edges[edge_index].from_node_index;
+        m_path.push_back(node_index);
+        if (node_index != m_graph.start_node) {
+            m_graph.node_states[node_index] = PathNodeState::OnShortestPath;
+        }
+    }
+}
+
+void LifelongPlanningAStarGraphAlgorithm::unmarkShortestPath() {
+    for (auto node_index : m_path) {
+        showNode(node_index);
+    }
+    m_path.clear();
+    m_path_shown = false;
+}
+
+void LifelongPlanningAStarGraphAlgorithm::expandNode() {
+    auto& topology = m_graph.getTopology();
+    auto node_index = m_queue.front().node;
+    std::pop_heap(m_queue.begin(), m_queue.end(), std::greater<QueueEntry>());
+    m_queue.pop_back();
+
+    // Overconsistent node gets its lookahead distance, underconsistent one is reset and queued again
+    if (m_distance[node_index] > m_lookahead[node_index]) {
+        m_distance[node_index] = m_lookahead[node_index];
+        showNode(node_index);
+    }
+    else {
+        m_distance[node_index] = infinite_distance;
+        updateNode(node_index);
+    }
+
+    for (auto edge_index : topology.getOutgoingEdges(node_index)) {
+        if (m_edge_active[edge_index]) {
+            updateNode(topology.edges[edge_index].to_node_index);
+        }
+    }
+}
+
+bool LifelongPlanningAStarGraphAlgorithm::nextStep() {
+    applyChanges();
+
+    // Lets the renderer draw the initial state of graph
+    if (m_first_step) {
+        m_lookahead[m_graph.start_node] = 0;
+        updateNode(m_graph.start_node);
+        m_first_step = false;
+        ++m_step;
+        return true;
+    }
+
+    // The path is shown, wait for the next change
+    if (m_path_shown && isSearchFinished()) {
+        if (m_next_change == m_changes.size()) {
+            return false;
+        }
+        m_step = std::max(m_step, m_changes[m_next_change].step);
+        applyChanges();
+    }
+
+    if (isSearchFinished()) {
+        if (m_path_shown) {
+            unmarkShortestPath();
+        }
+        markShortestPath();
+    }
+    else {
+        expandNode();
+    }
+    ++m_step;
+    return true;
+}
+
+const Graph& LifelongPlanningAStarGraphAlgorithm::getState() const {
+    return m_graph;
+}
@@ -0,0 +1,128 @@
+#ifndef LifelongPlanningAStarGraphAlgorithm_hpp
+#define LifelongPlanningAStarGraphAlgorithm_hpp
+
+#include "GraphAlgorithm.hpp"
+#include "GridDistanceHeuristic.hpp"
+#include "PathGraph.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Class for the Lifelong Planning A* (LPA*) algorithm finding the shortest path in a graph whose edges
+ * are inserted and removed during the run.
+ *
+ * Every node keeps its distance g and the one-step lookahead rhs computed from its predecessors.
+ * Only locally inconsistent nodes (g != rhs) are in the priority queue, so after an edge change
+ * just the nodes whose distance really changed are expanded again instead of the whole graph.
+ * The queue is ordered by [min(g, rhs) + heuristic, min(g, rhs)], the heuristic is the same as in A*.
+ */
+class LifelongPlanningAStarGraphAlgorithm : public GraphAlgorithm {
+    // Entry of the priority queue, outdated entries are skipped when popped
+    struct QueueEntry {
+        std::uint64_t estimate; // First part of the key, min(g, rhs) plus the heuristic
+        std::uint64_t distance; // Second part of the key, min(g, rhs)
+        std::size_t node;
+
+        bool operator>(const QueueEntry& other) const;
+    };
+
+    // Edge change with the index of the changed edge
+    struct ScheduledChange {
+        std::size_t step;
+        bool insert;
+        std::size_t edge;
+    };
+
+    PathGraph m_graph;
+    GridDistanceHeuristic m_heuristic; // Lower bound of the distance to the end node
+    std::vector<ScheduledChange> m_changes; // Edge changes sorted by step
+    std::size_t m_next_change; // Index of the first change not applied yet
+    std::size_t m_step; // Number of the current step
+    std::vector<bool> m_edge_active; // False for the edges which are removed at the moment
+    std::vector<QueueEntry> m_queue; // Binary min-heap of inconsistent nodes
+    std::vector<std::uint64_t> m_distance; // Distance g of each node from the start node
+    std::vector<std::uint64_t> m_lookahead; // Lookahead distance rhs of each node
+    std::vector<std::size_t> m_best_edge; // Index of the incoming edge giving rhs of each node
+    std::vector<std::size_t> m_path; // Nodes of the marked shortest path from the end node back
+    bool m_first_step;
+    bool m_path_shown;
+
+    /**
+     * Returns the key of the node in the priority queue.
+     */
+    QueueEntry calculateKey(std::size_t node) const;
+
+    /**
+     * Removes outdated entries from the top of the priority queue.
+     */
+    void skipOutdatedEntries();
+
+    /**
+     * Returns true if the shortest path to the end node is known, i.e. no node in the queue can improve it.
+     */
+    bool isSearchFinished();
+
+    /**
+     * Recomputes rhs of the node from its active incoming edges and queues it if it is inconsistent.
+     */
+    void updateNode(std::size_t node);
+
+    /**
+     * Sets the states of the node and of the edge giving its rhs from its g and rhs.
+     */
+    void showNode(std::size_t node);
+
+    /**
+     * Applies all the changes scheduled up to the current step.
+     */
+    void applyChanges();
+
+    /**
+     * Backtracks from the end node and marks the nodes and edges on the shortest path.
+     */
+    void markShortestPath();
+
+    /**
+     * Restores the states of the nodes and edges of the marked shortest path.
+     */
+    void unmarkShortestPath();
+
+    /**
+     * Pops the inconsistent node with the lowest key and makes it consistent.
+     */
+    void expandNode();
+
+public:
+    /**
+     * Constructor for LifelongPlanningAStarGraphAlgorithm.
+     *
+     * @param graph The graph in which the shortest path is found.
+     * @param changes Edge insertions and deletions sorted by step. Edges are identified by their end nodes
+     * and have to be in the graph (of parallel edges the first one is changed). An edge whose first change
+     * is an insertion is missing from the start of the run until it is inserted.
+     * @throws std::runtime_error if a changed edge is not in the graph or an edge has weight 0.
+     */
+    LifelongPlanningAStarGraphAlgorithm(PathGraph&& graph, const std::vector<PathEdgeChange>& changes);
+
+    /**
+     * Executes the next step of the LPA* algorithm.
+     *
+     * Every step expands one inconsistent node, inconsistent nodes are shown as found and consistent
+     * nodes with a known distance as visited. Once the path is found it is marked and the run jumps
+     * to the step of the next change, after which the search is repaired. Changes scheduled before
+     * a step are applied at its beginning.
+     *
+     * @return True if there are more steps to be taken, false otherwise.
+     */
+    virtual bool nextStep() override;
+
+    /**
+     * Returns the current state of the graph.
+     *
+     * @return A constant reference to the current state of the graph.
+     */
+    virtual const Graph& getState() const override;
+};
+
+#endif
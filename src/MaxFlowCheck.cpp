@@ -0,0 +1,151 @@
+#include "DinicGraphAlgorithm.hpp"
+#include "FlowGraph.hpp"
+#include "FordFulkersonGraphAlgorithm.hpp"
+#include "ParallelPushRelabelGraphAlgorithm.hpp"
+#include "PushRelabelGraphAlgorithm.hpp"
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Check that all the max-flow algorithms find the same maximal flow on random flow networks
+
+void printHelp(const std::string& command) {
+    std::cout << "Usage: " << command << " [NETWORK_COUNT]" << std::endl;
+    std::cout << "Check that FF-BFS, FF-SCALING, DINIC, PUSH-RELABEL and PUSH-RELABEL-PARALLEL find the same maximal flow" << std::endl;
+    std::cout << "on NETWORK_COUNT random flow networks (200 by default). The same count always gives the same networks." << std::endl;
+}
+
+/**
+ * Creates a random flow network on a small grid. Neighbouring cells are connected in random directions,
+ * some of them in both directions, and a few edges connect random nodes, so there are also long, parallel
+ * and loop edges. The start and end nodes are random and can be the same node.
+ */
+FlowGraphConfig createRandomFlowConfig(std::size_t seed) {
+    std::mt19937 generator(static_cast<std::mt19937::result_type>(seed));
+    auto random = [&](std::size_t min, std::size_t max) {
+        return std::uniform_int_distribution<std::size_t>(min, max)(generator);
+    };
+    std::bernoulli_distribution coin(0.5);
+
+    FlowGraphConfig config{};
+    config.grid_width = random(1, 10);
+    config.grid_height = random(1, 10);
+    config.node_size = 10;
+    config.edge_length = 10;
+    config.edge_width = 10;
+    config.frame_delay = 1;
+    // Low maximal capacities give many equal paths, high ones give many capacity scaling phases
+    const std::size_t max_capacities[] = {1, 10, 1000};
+    config.max_capacity = max_capacities[random(0, 2)];
+
+    for (std::size_t y = 0; y < config.grid_height; ++y) {
+        for (std::size_t x = 0; x < config.grid_width; ++x) {
+            config.nodes.emplace_back(x, y);
+        }
+    }
+    auto node_count = config.nodes.size();
+    auto addEdge = [&](std::size_t from_node, std::size_t to_node) {
+        config.edges.push_back({{from_node, to_node}, random(1, config.max_capacity)});
+    };
+
+    std::bernoulli_distribution has_edge(0.8);
+    std::bernoulli_distribution both_directions(0.3);
+    for (std::size_t y = 0; y < config.grid_height; ++y) {
+        for (std::size_t x = 0; x < config.grid_width; ++x) {
+            auto node = y * config.grid_width + x;
+            std::vector<std::size_t> neighbours;
+            if (x + 1 < config.grid_width) {
+                neighbours.push_back(node + 1);
+            }
+            if (y + 1 < config.grid_height) {
+                neighbours.push_back(node + config.grid_width);
+            }
+            for (auto neighbour : neighbours) {
+                if (!has_edge(generator)) {
+                    continue;
+                }
+                if (both_directions(generator)) {
+                    addEdge(node, neighbour);
+                    addEdge(neighbour, node);
+                }
+                else if (coin(generator)) {
+                    addEdge(node, neighbour);
+                }
+                else {
+                    addEdge(neighbour, node);
+                }
+            }
+        }
+    }
+    for (std::size_t i = random(0, node_count / 4); i > 0; --i) {
+        addEdge(random(0, node_count - 1), random(0, node_count - 1));
+    }
+
+    config.start_node = random(0, node_count - 1);
+    config.end_node = random(0, node_count - 1);
+    return config;
+}
+
+/**
+ * Runs the algorithm to the end and returns the found maximal flow.
+ */
+template <typename Algorithm>
+std::size_t runToEnd(Algorithm&& algorithm) {
+    while (algorithm.nextStep()) {}
+    return algorithm.getMaxFlow();
+}
+
+int main(int argc, const char *argv[]) {
+    if (argc > 2 || (argc == 2 && std::string(argv[1]) == "--help")) {
+        printHelp(argv[0]);
+        return (argc == 2) ? 0 : 1;
+    }
+
+    try {
+        std::size_t network_count = (argc == 2) ? std::stoul(argv[1]) : 200;
+
+        using FlowFunction = std::function<std::size_t(const std::shared_ptr<const FlowGraphTopology>&)>;
+        const std::vector<std::pair<std::string, FlowFunction>> algorithms = {
+            {"FF-BFS", [](auto& topology) { return runToEnd(FordFulkersonGraphAlgorithm(FlowGraph(topology))); }},
+            {"FF-SCALING", [](auto& topology) { return runToEnd(FordFulkersonGraphAlgorithm(FlowGraph(topology), true)); }},
+            {"DINIC", [](auto& topology) { return runToEnd(DinicGraphAlgorithm(FlowGraph(topology))); }},
+            {"PUSH-RELABEL", [](auto& topology) { return runToEnd(PushRelabelGraphAlgorithm(FlowGraph(topology))); }},
+            // Two threads even on a single core, snapshots are not needed so the whole run is a single step
+            {"PUSH-RELABEL-PARALLEL", [](auto& topology) {
+                return runToEnd(ParallelPushRelabelGraphAlgorithm(FlowGraph(topology), 2,
+                    std::numeric_limits<std::size_t>::max())); }},
+        };
+
+        std::size_t mismatch_count = 0;
+        for (std::size_t seed = 0; seed < network_count; ++seed) {
+            auto config = createRandomFlowConfig(seed);
+            auto topology = std::make_shared<const FlowGraphTopology>(config);
+
+            std::vector<std::size_t> flows;
+            for (auto& [name, findFlow] : algorithms) {
+                flows.push_back(findFlow(topology));
+            }
+            for (std::size_t i = 1; i < algorithms.size(); ++i) {
+                if (flows[i] != flows[0]) {
+                    std::cout << "Error: Network " << seed << " (" << config.grid_width << "x" << config.grid_height
+                        << ", " << config.edges.size() << " edges): " << algorithms[i].first << " finds flow " << flows[i]
+                        << ", " << algorithms[0].first << " finds " << flows[0] << std::endl;
+                    ++mismatch_count;
+                }
+            }
+        }
+
+        std::cout << "Networks: " << network_count << ", mismatches: " << mismatch_count << std::endl;
+        return (mismatch_count == 0) ? 0 : 1;
+    }
+    catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,144 @@
+#include "MultiSourceBFS.hpp"
+#include "PathGraph.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+MultiSourceBFS::MultiSourceBFS(const PathGraphTopology& topology, std::span<const std::size_t> sources)
+    :   m_topology(topology),
+        m_word_count((sources.size() + 63) / 64),
+        m_seen(topology.node_count * m_word_count, 0),
+        m_visit(topology.node_count * m_word_count, 0),
+        m_visit_next(topology.node_count * m_word_count, 0),
+        m_source_count(sources.size()),
+        m_distance(topology.node_count * sources.size(), unreached),
+        m_level(0) {
+
+    if (sources.empty() || sources.size() > max_batch_size) {
+        throw std::runtime_error("Number of BFS sources has to be between 1 and " + std::to_string(max_batch_size));
+    }
+
+    for (std::size_t i = 0; i < sources.size(); ++i) {
+        auto node = sources[i];
+        if (node >= topology.node_count) {
+            throw std::runtime_error("Invalid BFS source node index: " + std::to_string(node));
+        }
+        auto word = node * m_word_count + i / 64;
+        auto visit = m_visit.begin() + node * m_word_count;
+        if (std::all_of(visit, visit + m_word_count, [](std::uint64_t bits) { return bits == 0; })) {
+            m_frontier.push_back(node);
+        }
+        m_seen[word] |= std::uint64_t(1) << (i % 64);
+        m_visit[word] |= std::uint64_t(1) << (i % 64);
+        m_distance[node * m_source_count + i] = 0;
+    }
+}
+
+bool MultiSourceBFS::expandLevel() {
+    if (m_frontier.empty()) {
+        return false;
+    }
+    ++m_level;
+
+    // Every frontier node passes the sources it was reached by to the neighbours that haven't seen them yet
+    for (auto node : m_frontier) {
+        auto visit = &m_visit[node * m_word_count];
+
+        for (auto neighbour : m_topology.getOutgoingNeighbours(node)) {
+            auto seen = &m_seen[neighbour * m_word_count];
+            auto next = &m_visit_next[neighbour * m_word_count];
+
+            std::uint64_t was_queued = 0;
+            std::uint64_t is_queued = 0;
+            for (std::size_t word = 0; word < m_word_count; ++word) {
+                was_queued |= next[word];
+                next[word] |= visit[word] & ~seen[word];
+                is_queued |= next[word];
+            }
+            if (was_queued == 0 && is_queued != 0) {
+                m_next_frontier.push_back(neighbour);
+            }
+        }
+    }
+
+    for (auto node : m_frontier) {
+        std::fill_n(m_visit.begin() + node * m_word_count, m_word_count, 0);
+    }
+
+    // The sources reaching a node in this level are new for it, so they set its distance
+    for (auto node : m_next_frontier) {
+        auto distance = &m_distance[node * m_source_count];
+
+        for (std::size_t word = 0; word < m_word_count; ++word) {
+            auto bits = m_visit_next[node * m_word_count + word];
+            m_seen[node * m_word_count + word] |= bits;
+
+            while (bits != 0) {
+                distance[word * 64 + std::countr_zero(bits)] = m_level;
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    // Frontier in the order of the nodes keeps the accesses of the next level close to each other
+    std::sort(m_next_frontier.begin(), m_next_frontier.end());
+    std::swap(m_visit, m_visit_next);
+    std::swap(m_frontier, m_next_frontier);
+    m_next_frontier.clear();
+    return true;
+}
+
+void MultiSourceBFS::run() {
+    while (expandLevel()) {}
+}
+
+std::uint32_t MultiSourceBFS::getLevel() const {
+    return m_level;
+}
+
+std::span<const std::size_t> MultiSourceBFS::getFrontier() const {
+    return m_frontier;
+}
+
+std::uint32_t MultiSourceBFS::getDistance(std::size_t source_index, std::size_t node) const {
+    return m_distance[node * m_source_count + source_index];
+}
+
+std::span<const std::uint32_t> MultiSourceBFS::getDistances(std::size_t node) const {
+    return std::span<const std::uint32_t>(m_distance.data() + node * m_source_count, m_source_count);
+}
+
+void MultiSourceBFS::appendDistanceRows(std::vector<std::vector<std::uint32_t>>& rows) const {
+    auto node_count = m_topology.node_count;
+    auto first_row = rows.size();
+    rows.resize(first_row + m_source_count, std::vector<std::uint32_t>(node_count));
+
+    // The table is transposed in blocks of nodes, so both the read and the written part stay in the cache
+    constexpr std::size_t block_size = 1024;
+    for (std::size_t block = 0; block < node_count; block += block_size) {
+        auto block_end = std::min(node_count, block + block_size);
+        for (std::size_t source_index = 0; source_index < m_source_count; ++source_index) {
+            auto& row = rows[first_row + source_index];
+            for (std::size_t node = block; node < block_end; ++node) {
+                row[node] = m_distance[node * m_source_count + source_index];
+            }
+        }
+    }
+}
+
+std::vector<std::vector<std::uint32_t>> computeBFSDistances(const PathGraphTopology& topology,
+    std::span<const std::size_t> sources) {
+
+    std::vector<std::vector<std::uint32_t>> distances;
+    distances.reserve(sources.size());
+
+    for (std::size_t first = 0; first < sources.size(); first += MultiSourceBFS::max_batch_size) {
+        auto batch = sources.subspan(first, std::min(MultiSourceBFS::max_batch_size, sources.size() - first));
+        MultiSourceBFS search(topology, batch);
+        search.run();
+        search.appendDistanceRows(distances);
+    }
+    return distances;
+}
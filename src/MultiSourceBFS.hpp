@@ -0,0 +1,96 @@
+#ifndef MultiSourceBFS_hpp
+#define MultiSourceBFS_hpp
+
+#include "PathGraph.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <vector>
+
+/**
+ * Class running up to max_batch_size Breadth-First Searches from different sources at once (MS-BFS).
+ *
+ * Every node keeps a bitset of the sources which have reached it and a bitset of the sources for which
+ * it is in the current frontier. A level is expanded by scanning the outgoing edges of every frontier node
+ * just once and passing its whole frontier bitset to the neighbours, so the searches share the adjacency
+ * scans instead of repeating them for every source. Distances are counted in edges, weights are ignored.
+ */
+class MultiSourceBFS {
+public:
+    static constexpr std::size_t max_batch_size = 256;
+    static constexpr std::uint32_t unreached = std::numeric_limits<std::uint32_t>::max();
+
+private:
+    const PathGraphTopology& m_topology;
+    std::size_t m_word_count; // Number of 64-bit words of the bitset of one node
+    std::vector<std::uint64_t> m_seen; // Sources which have reached each node, m_word_count words per node
+    std::vector<std::uint64_t> m_visit; // Sources for which each node is in the current frontier
+    std::vector<std::uint64_t> m_visit_next; // Sources for which each node is in the next frontier
+    std::vector<std::size_t> m_frontier; // Nodes with any source in m_visit
+    std::vector<std::size_t> m_next_frontier; // Nodes with any source in m_visit_next
+    std::size_t m_source_count;
+    std::vector<std::uint32_t> m_distance; // Distance of each node from each source, grouped by node
+    std::uint32_t m_level; // Distance of the nodes in the current frontier
+
+public:
+    /**
+     * Constructor for MultiSourceBFS. The sources form the first frontier.
+     *
+     * @param topology The topology of the searched graph, it has to outlive the search.
+     * @param sources Indices of the source nodes, the same node may be given more times.
+     * @throws std::runtime_error if there are no sources, more than max_batch_size or a source is not a node.
+     */
+    MultiSourceBFS(const PathGraphTopology& topology, std::span<const std::size_t> sources);
+
+    /**
+     * Expands the current frontier of all the searches by one level.
+     *
+     * @return False if the frontier was empty, so all the searches are finished, true otherwise.
+     */
+    bool expandLevel();
+
+    /**
+     * Expands the levels until all the searches are finished.
+     */
+    void run();
+
+    /**
+     * Returns the distance of the nodes in the current frontier.
+     */
+    std::uint32_t getLevel() const;
+
+    /**
+     * Returns the nodes in the current frontier of any of the searches.
+     */
+    std::span<const std::size_t> getFrontier() const;
+
+    /**
+     * Returns the distance of the node from the source with the given position, or unreached.
+     */
+    std::uint32_t getDistance(std::size_t source_index, std::size_t node) const;
+
+    /**
+     * Returns the distances of the node from all the sources in the order of the sources, unreached for the others.
+     */
+    std::span<const std::uint32_t> getDistances(std::size_t node) const;
+
+    /**
+     * Appends the distances of all the nodes from every source to the table, one row per source.
+     */
+    void appendDistanceRows(std::vector<std::vector<std::uint32_t>>& rows) const;
+};
+
+/**
+ * Computes the BFS distances of all the nodes from every source, running the searches in batches
+ * of MultiSourceBFS::max_batch_size sources.
+ *
+ * @param topology The topology of the searched graph.
+ * @param sources Indices of the source nodes.
+ * @return The distances from every source in the order of the sources, MultiSourceBFS::unreached for unreached nodes.
+ * @throws std::runtime_error if a source is not a node.
+ */
+std::vector<std::vector<std::uint32_t>> computeBFSDistances(const PathGraphTopology& topology,
+    std::span<const std::size_t> sources);
+
+#endif
@@ -0,0 +1,90 @@
+#include "MultiSourceBFSGraphAlgorithm.hpp"
+#include "PathGraph.hpp"
+
+// Helper function to put the start node in front of the other sources
+static std::vector<std::size_t> getSources(const PathGraph& graph, const std::vector<std::size_t>& sources) {
+    std::vector<std::size_t> all_sources{graph.start_node};
+    all_sources.insert(all_sources.end(), sources.begin(), sources.end());
+    return all_sources;
+}
+
+MultiSourceBFSGraphAlgorithm::MultiSourceBFSGraphAlgorithm(PathGraph&& graph, const std::vector<std::size_t>& sources)
+    :   m_graph(std::move(graph)),
+        m_sources(getSources(m_graph, sources)),
+        m_search(m_graph.getTopology(), m_sources),
+        m_entered_by(m_graph.node_count),
+        m_first_step(true),
+        m_found_end(false) {}
+
+void MultiSourceBFSGraphAlgorithm::markShortestPath() {
+    auto& topology = m_graph.getTopology();
+    auto node_index = m_graph.end_node;
+
+    if (node_index == m_graph.start_node) {
+        m_graph.node_states[node_index] = PathNodeState::OnShortestPath;
+    }
+    while (node_index != m_graph.start_node) {
+        auto edge_index = m_entered_by[node_index];
+        m_graph.edge_states[edge_index] = PathEdgeState::OnShortestPath;
+        node_index = topology.edges[edge_index].from_node_index;
+        if (node_index != m_graph.start_node) {
+            m_graph.node_states[node_index] = PathNodeState::OnShortestPath;
+        }
+    }
+}
+
+bool MultiSourceBFSGraphAlgorithm::nextStep() {
+    // Lets the renderer draw the initial state of graph
+    if (m_first_step) {
+        m_shown_frontier.push_back(m_graph.start_node);
+        m_first_step = false;
+        return true;
+    }
+
+    // We are finished
+    if (m_shown_frontier.empty() || m_found_end) {
+        return false;
+    }
+
+    bool found_end = false;
+    for (auto node_index : m_shown_frontier) {
+        m_graph.node_states[node_index] = PathNodeState::Visited;
+        if (node_index != m_graph.start_node) {
+            m_graph.edge_states[m_entered_by[node_index]] = PathEdgeState::Used;
+        }
+        found_end = found_end || node_index == m_graph.end_node;
+    }
+
+    // We found the end node
+    if (found_end) {
+        markShortestPath();
+        m_found_end = true;
+        return true;
+    }
+
+    // Else all the searches expand their level and the new level of the search from the start node is shown
+    auto& topology = m_graph.getTopology();
+    m_search.expandLevel();
+    m_shown_frontier.clear();
+
+    for (auto node_index : m_search.getFrontier()) {
+        if (m_search.getDistance(0, node_index) != m_search.getLevel()) {
+            continue;
+        }
+        for (auto edge_index : topology.getIncomingEdges(node_index)) {
+            if (m_search.getDistance(0, topology.edges[edge_index].from_node_index) + 1 == m_search.getLevel()) {
+                m_entered_by[node_index] = edge_index;
+                break;
+            }
+        }
+        m_graph.node_states[node_index] = PathNodeState::Found;
+        m_graph.edge_states[m_entered_by[node_index]] = PathEdgeState::Peeked;
+        m_shown_frontier.push_back(node_index);
+    }
+
+    return true;
+}
+
+const Graph& MultiSourceBFSGraphAlgorithm::getState() const {
+    return m_graph;
+}
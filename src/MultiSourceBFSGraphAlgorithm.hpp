@@ -0,0 +1,59 @@
+#ifndef MultiSourceBFSGraphAlgorithm_hpp
+#define MultiSourceBFSGraphAlgorithm_hpp
+
+#include "GraphAlgorithm.hpp"
+#include "MultiSourceBFS.hpp"
+#include "PathGraph.hpp"
+#include <cstddef>
+#include <vector>
+
+/**
+ * Class visualizing one search of a multi-source Breadth-First Search.
+ *
+ * The start node is the first source of the batch, the other sources are searched together with it
+ * in the same level expansions. Only the search from the start node is drawn, one level per step,
+ * and the shortest path to the end node is marked once the end node is visited.
+ */
+class MultiSourceBFSGraphAlgorithm : public GraphAlgorithm {
+    PathGraph m_graph;
+    std::vector<std::size_t> m_sources; // The start node followed by the other sources
+    MultiSourceBFS m_search;
+    std::vector<std::size_t> m_shown_frontier; // Nodes in the current frontier of the search from the start node
+    std::vector<std::size_t> m_entered_by; // Index of the edge each node was entered by from the start node
+    bool m_first_step;
+    bool m_found_end;
+
+    /**
+     * Backtracks from the end node and marks the nodes and edges on the shortest path.
+     */
+    void markShortestPath();
+
+public:
+    /**
+     * Constructor for MultiSourceBFSGraphAlgorithm.
+     *
+     * @param graph The graph to be traversed.
+     * @param sources Indices of the sources searched together with the start node.
+     * @throws std::runtime_error if there are too many sources or a source is not a node.
+     */
+    MultiSourceBFSGraphAlgorithm(PathGraph&& graph, const std::vector<std::size_t>& sources);
+
+    /**
+     * Executes the next step of the multi-source BFS.
+     *
+     * Every step visits the current level of the search from the start node and expands the current
+     * level of all the searches, the nodes of the next level of the search from the start node are shown as found.
+     *
+     * @return True if there are more steps to be taken, false otherwise.
+     */
+    virtual bool nextStep() override;
+
+    /**
+     * Returns the current state of the graph.
+     *
+     * @return A constant reference to the current state of the graph.
+     */
+    virtual const Graph& getState() const override;
+};
+
+#endif
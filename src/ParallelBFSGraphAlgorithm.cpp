@@ -0,0 +1,194 @@
+#include "ParallelBFSGraphAlgorithm.hpp"
+#include "PathGraph.hpp"
+
+#include <algorithm>
+#include <limits>
+
+// Number of nodes a thread claims at once, big enough to keep contention on the counter low
+static constexpr std::size_t chunk_size = 256;
+
+// Switch to bottom-up once the frontier has more than 1/alpha of the unexplored edges,
+// back to top-down once it has less than 1/beta of the nodes (Beamer et al.)
+static constexpr std::size_t alpha = 14;
+static constexpr std::size_t beta = 24;
+
+static constexpr std::size_t no_edge = std::numeric_limits<std::size_t>::max();
+
+ParallelBFSGraphAlgorithm::ParallelBFSGraphAlgorithm(PathGraph&& graph, std::size_t thread_count)
+    :   m_graph(std::move(graph)),
+        m_pool(thread_count),
+        m_parent_edge(m_graph.node_count, no_edge),
+        m_next_frontier(m_pool.size()),
+        m_frontier_bitmap((m_graph.node_count + 63) / 64),
+        m_next_index(0),
+        m_frontier_edges(0),
+        m_unexplored_edges(m_graph.edge_count),
+        m_bottom_up(false),
+        m_first_step(true),
+        m_finished(false) {}
+
+bool ParallelBFSGraphAlgorithm::claim(std::size_t node, std::size_t edge_index, std::size_t thread_index) {
+    std::atomic_ref<std::size_t> parent_edge(m_parent_edge[node]);
+    auto expected = no_edge;
+    if (parent_edge.load(std::memory_order_relaxed) != no_edge
+        || !parent_edge.compare_exchange_strong(expected, edge_index, std::memory_order_relaxed)) {
+        return false;
+    }
+
+    m_graph.edge_states[edge_index] = PathEdgeState::Peeked;
+    m_graph.node_states[node] = PathNodeState::Found;
+    m_next_frontier[thread_index].push_back(node);
+    return true;
+}
+
+void ParallelBFSGraphAlgorithm::expandTopDown() {
+    auto& topology = m_graph.getTopology();
+
+    m_next_index = 0;
+    m_pool.run([&](std::size_t thread_index) {
+        std::size_t frontier_edges = 0;
+        std::size_t begin;
+        while ((begin = m_next_index.fetch_add(chunk_size)) < m_frontier.size()) {
+            auto end = std::min(begin + chunk_size, m_frontier.size());
+            for (auto i = begin; i < end; ++i) {
+                for (auto edge_index : topology.getOutgoingEdges(m_frontier[i])) {
+                    auto neighbour_index = topology.edges[edge_index].to_node_index;
+                    if (claim(neighbour_index, edge_index, thread_index)) {
+                        frontier_edges += topology.getOutgoingEdges(neighbour_index).size();
+                    }
+                }
+            }
+        }
+        m_frontier_edges.fetch_add(frontier_edges);
+    });
+}
+
+void ParallelBFSGraphAlgorithm::expandBottomUp() {
+    auto& topology = m_graph.getTopology();
+
+    // Every unreached node is checked by exactly one thread, so it can be claimed without compare-and-swap
+    m_next_index = 0;
+    m_pool.run([&](std::size_t thread_index) {
+        std::size_t frontier_edges = 0;
+        std::size_t begin;
+        while ((begin = m_next_index.fetch_add(chunk_size)) < m_graph.node_count) {
+            auto end = std::min(begin + chunk_size, m_graph.node_count);
+            for (auto node = begin; node < end; ++node) {
+                if (m_parent_edge[node] != no_edge) {
+                    continue;
+                }
+                for (auto edge_index : topology.getIncomingEdges(node)) {
+                    auto parent = topology.edges[edge_index].from_node_index;
+                    auto word = m_frontier_bitmap[parent / 64].load(std::memory_order_relaxed);
+                    if ((word >> (parent % 64)) & 1) {
+                        m_parent_edge[node] = edge_index;
+                        m_graph.edge_states[edge_index] = PathEdgeState::Peeked;
+                        m_graph.node_states[node] = PathNodeState::Found;
+                        m_next_frontier[thread_index].push_back(node);
+                        frontier_edges += topology.getOutgoingEdges(node).size();
+                        break;
+                    }
+                }
+            }
+        }
+        m_frontier_edges.fetch_add(frontier_edges);
+    });
+}
+
+void ParallelBFSGraphAlgorithm::visitFrontier() {
+    m_next_index = 0;
+    m_pool.run([&](std::size_t) {
+        std::size_t begin;
+        while ((begin = m_next_index.fetch_add(chunk_size)) < m_frontier.size()) {
+            auto end = std::min(begin + chunk_size, m_frontier.size());
+            for (auto i = begin; i < end; ++i) {
+                auto node = m_frontier[i];
+                m_graph.node_states[node] = PathNodeState::Visited;
+                if (node != m_graph.start_node) {
+                    m_graph.edge_states[m_parent_edge[node]] = PathEdgeState::Used;
+                }
+
+                // Bits of older levels are never cleared, all their neighbours are reached already
+                if (m_bottom_up) {
+                    m_frontier_bitmap[node / 64].fetch_or(std::uint64_t(1) << (node % 64), std::memory_order_relaxed);
+                }
+            }
+        }
+    });
+}
+
+void ParallelBFSGraphAlgorithm::markShortestPath() {
+    auto& topology = m_graph.getTopology();
+    auto node_index = m_graph.end_node;
+    m_graph.node_states[node_index] = PathNodeState::Visited;
+
+    while (node_index != m_graph.start_node) {
+        auto edge_index = m_parent_edge[node_index];
+        m_graph.edge_states[edge_index] = PathEdgeState::OnShortestPath;
+        node_index = topology.edges[edge_index].from_node_index;
+        if (node_index != m_graph.start_node) {
+            m_graph.node_states[node_index] = PathNodeState::OnShortestPath;
+        }
+    }
+}
+
+bool ParallelBFSGraphAlgorithm::nextStep() {
+    // Lets the renderer draw the initial state of graph
+    if (m_first_step) {
+        m_first_step = false;
+        if (m_graph.start_node == m_graph.end_node) {
+            m_graph.node_states[m_graph.start_node] = PathNodeState::OnShortestPath;
+            m_finished = true;
+            return true;
+        }
+
+        // The start node is its own root, any value but no_edge keeps it from being claimed
+        m_parent_edge[m_graph.start_node] = m_graph.edge_count;
+        m_frontier.push_back(m_graph.start_node);
+        m_unexplored_edges -= m_graph.getTopology().getOutgoingEdges(m_graph.start_node).size();
+        m_frontier_edges = m_graph.edge_count - m_unexplored_edges;
+        return true;
+    }
+
+    // We are finished
+    if (m_finished) {
+        return false;
+    }
+
+    // Choose the direction of this level
+    auto frontier_edges = m_frontier_edges.exchange(0);
+    if (!m_bottom_up && frontier_edges * alpha > m_unexplored_edges) {
+        m_bottom_up = true;
+    }
+    else if (m_bottom_up && m_frontier.size() * beta < m_graph.node_count) {
+        m_bottom_up = false;
+    }
+
+    visitFrontier();
+    if (m_bottom_up) {
+        expandBottomUp();
+    }
+    else {
+        expandTopDown();
+    }
+    m_unexplored_edges -= std::min(m_unexplored_edges, m_frontier_edges.load());
+
+    m_frontier.clear();
+    for (auto& next : m_next_frontier) {
+        m_frontier.insert(m_frontier.end(), next.begin(), next.end());
+        next.clear();
+    }
+
+    if (m_parent_edge[m_graph.end_node] != no_edge) {
+        markShortestPath();
+        m_finished = true;
+    }
+    else if (m_frontier.empty()) {
+        m_finished = true;
+    }
+    return true;
+}
+
+const Graph& ParallelBFSGraphAlgorithm::getState() const {
+    return m_graph;
+}
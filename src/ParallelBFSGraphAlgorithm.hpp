@@ -0,0 +1,93 @@
+#ifndef ParallelBFSGraphAlgorithm_hpp
+#define ParallelBFSGraphAlgorithm_hpp
+
+#include "GraphAlgorithm.hpp"
+#include "PathGraph.hpp"
+#include "ThreadPool.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Class for the direction-optimizing, level-synchronous parallel Breadth-First Search (BFS).
+ *
+ * Every level is expanded by all threads at once. Small frontiers are expanded top-down: threads
+ * walk outgoing edges of frontier nodes and claim unreached neighbours by atomically setting their
+ * parent edge. Once the frontier has more edges than the unreached part of the graph, levels are
+ * expanded bottom-up: every unreached node looks for a parent among its incoming edges using a bitmap
+ * of the frontier. The switching follows the heuristic of Beamer et al.
+ */
+class ParallelBFSGraphAlgorithm : public GraphAlgorithm {
+    PathGraph m_graph;
+    ThreadPool m_pool;
+    std::vector<std::size_t> m_parent_edge; // Edge each node was reached by, claimed atomically
+    std::vector<std::size_t> m_frontier; // Nodes of the current level
+    std::vector<std::vector<std::size_t>> m_next_frontier; // Nodes of the next level found by each thread
+    std::vector<std::atomic<std::uint64_t>> m_frontier_bitmap; // Bit of every node of the current level, used bottom-up
+    std::atomic<std::size_t> m_next_index; // Position of the next unclaimed chunk of work
+    std::atomic<std::size_t> m_frontier_edges; // Number of edges leaving the next level
+    std::size_t m_unexplored_edges; // Number of edges leaving nodes not reached yet
+    bool m_bottom_up; // True if the current level is expanded bottom-up
+    bool m_first_step;
+    bool m_finished;
+
+    /**
+     * Marks nodes of the current level as visited and sets their bits in the frontier bitmap
+     * if the level is expanded bottom-up.
+     */
+    void visitFrontier();
+
+    /**
+     * Expands the current level by walking outgoing edges of its nodes.
+     */
+    void expandTopDown();
+
+    /**
+     * Expands the current level by searching parents of all unreached nodes.
+     */
+    void expandBottomUp();
+
+    /**
+     * Claims the node for the next level if it wasn't reached yet.
+     *
+     * @param node Index of the node.
+     * @param edge_index Index of the edge the node is reached by.
+     * @param thread_index Index of the thread claiming the node.
+     * @return True if this thread claimed the node.
+     */
+    bool claim(std::size_t node, std::size_t edge_index, std::size_t thread_index);
+
+    /**
+     * Backtracks from the end node and marks the nodes and edges on the shortest path.
+     */
+    void markShortestPath();
+
+public:
+    /**
+     * Constructor for ParallelBFSGraphAlgorithm.
+     *
+     * @param graph The graph to be traversed using BFS.
+     * @param thread_count Number of threads, zero means one thread per hardware thread.
+     */
+    ParallelBFSGraphAlgorithm(PathGraph&& graph, std::size_t thread_count);
+
+    /**
+     * Executes the next step of the parallel BFS algorithm.
+     *
+     * Every step expands one whole level. Nodes of the expanded level are shown as visited
+     * and nodes of the next level as found.
+     *
+     * @return True if there are more steps to be taken, false otherwise.
+     */
+    virtual bool nextStep() override;
+
+    /**
+     * Returns the current state of the graph.
+     *
+     * @return A constant reference to the current state of the graph.
+     */
+    virtual const Graph& getState() const override;
+};
+
+#endif
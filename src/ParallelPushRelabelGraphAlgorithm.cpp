@@ -0,0 +1,291 @@
+#include "ParallelPushRelabelGraphAlgorithm.hpp"
+#include "FlowGraph.hpp"
+#include "FlowResidualGraph.hpp"
+
+#include <algorithm>
+#include <limits>
+
+// Number of nodes a thread claims at once, big enough to keep contention on the counter low
+static constexpr std::size_t chunk_size = 64;
+
+static constexpr std::size_t no_height = std::numeric_limits<std::size_t>::max();
+
+ParallelPushRelabelGraphAlgorithm::ParallelPushRelabelGraphAlgorithm(FlowGraph&& graph,
+    std::size_t thread_count, std::size_t rounds_per_snapshot)
+    :   m_graph(std::move(graph)),
+        m_pool(thread_count),
+        m_start_node(m_graph.start_node),
+        m_end_node(m_graph.end_node),
+        m_rounds_per_snapshot(std::max<std::size_t>(1, rounds_per_snapshot)),
+        m_excess(m_graph.node_count),
+        m_queued_round(m_graph.node_count),
+        m_relabel_mark(m_graph.node_count),
+        m_next_active(m_pool.size()),
+        m_next_index(0),
+        m_relabels_since_global(0),
+        m_round(0),
+        m_global_relabels(0),
+        m_snapshot_flows(m_graph.edge_count, 0),
+        m_initialized(false) {
+
+    m_graph.max_node_level = m_graph.node_count;
+}
+
+std::size_t ParallelPushRelabelGraphAlgorithm::loadResidualCapacity(std::size_t arc) {
+    auto edge_index = arc / 2;
+    auto flow = std::atomic_ref<std::size_t>(m_graph.edge_flows[edge_index]).load();
+    if (arc % 2 == 0) {
+        return m_graph.getTopology().edges[edge_index].capacity - flow;
+    }
+    return flow;
+}
+
+void ParallelPushRelabelGraphAlgorithm::enqueue(std::size_t node, std::size_t thread_index) {
+    if (node == m_start_node || node == m_end_node) {
+        return;
+    }
+    if (m_queued_round[node].exchange(m_round + 1) != m_round + 1) {
+        m_next_active[thread_index].push_back(node);
+    }
+}
+
+std::size_t ParallelPushRelabelGraphAlgorithm::discharge(std::size_t node, std::size_t thread_index) {
+    auto& topology = m_graph.getTopology();
+    auto arc_count = getResidualArcCount(topology, node);
+    std::atomic_ref<std::size_t> height(m_graph.node_levels[node]);
+    std::size_t relabels = 0;
+
+    // Other threads only ever add excess to the node, so what we read is a lower bound
+    auto excess = m_excess[node].load();
+    while (excess > 0) {
+        // Find the lowest neighbour in the residual graph
+        auto lowest_arc = arc_count;
+        auto lowest_height = no_height;
+        std::size_t residual_capacity = 0;
+        for (std::size_t i = 0; i < arc_count; ++i) {
+            auto arc = getResidualArc(topology, node, i);
+            auto capacity = loadResidualCapacity(arc);
+            if (capacity == 0) {
+                continue;
+            }
+            auto neighbour_height = std::atomic_ref<std::size_t>(m_graph.node_levels[getArcHead(topology, arc)]).load();
+            if (neighbour_height < lowest_height) {
+                lowest_arc = i;
+                lowest_height = neighbour_height;
+                residual_capacity = capacity;
+            }
+        }
+
+        // Excess always has a residual path back, this only guards against a broken invariant
+        if (lowest_arc == arc_count) {
+            height.store(2 * m_graph.node_count - 1);
+            break;
+        }
+
+        if (height.load() > lowest_height) {
+            // Only this node increases flow on its forward arcs and cancels flow on its backward arcs,
+            // so the residual capacity can only have grown since we read it
+            auto arc = getResidualArc(topology, node, lowest_arc);
+            auto neighbour = getArcHead(topology, arc);
+            auto flow = std::min(excess, residual_capacity);
+
+            std::atomic_ref<std::size_t> edge_flow(m_graph.edge_flows[arc / 2]);
+            if (arc % 2 == 0) {
+                edge_flow.fetch_add(flow);
+            }
+            else {
+                edge_flow.fetch_sub(flow);
+            }
+            m_excess[node].fetch_sub(flow);
+            if (m_excess[neighbour].fetch_add(flow) == 0) {
+                enqueue(neighbour, thread_index);
+            }
+        }
+        else {
+            height.store(lowest_height + 1);
+            relabels++;
+        }
+        excess = m_excess[node].load();
+    }
+    return relabels;
+}
+
+void ParallelPushRelabelGraphAlgorithm::startNextRound() {
+    m_active.clear();
+    for (auto& next : m_next_active) {
+        m_active.insert(m_active.end(), next.begin(), next.end());
+        next.clear();
+    }
+    m_round++;
+}
+
+void ParallelPushRelabelGraphAlgorithm::globalRelabel() {
+    auto& topology = m_graph.getTopology();
+    auto node_count = m_graph.node_count;
+    auto mark = ++m_global_relabels;
+    std::vector<std::size_t> frontier;
+
+    // Claims the node for this global relabel, true only for the first thread to reach it
+    auto claim = [&](std::size_t node) {
+        auto old_mark = m_relabel_mark[node].load();
+        return old_mark != mark && m_relabel_mark[node].compare_exchange_strong(old_mark, mark);
+    };
+
+    auto bfs = [&](std::size_t root, std::size_t base_height) {
+        m_graph.node_levels[root] = base_height;
+        frontier.assign(1, root);
+
+        while (!frontier.empty()) {
+            m_next_index = 0;
+            m_pool.run([&](std::size_t thread_index) {
+                auto& next = m_next_active[thread_index];
+                std::size_t begin;
+                while ((begin = m_next_index.fetch_add(chunk_size)) < frontier.size()) {
+                    auto end = std::min(begin + chunk_size, frontier.size());
+                    for (auto i = begin; i < end; ++i) {
+                        auto current_node = frontier[i];
+                        auto next_height = std::min(m_graph.node_levels[current_node] + 1, 2 * node_count - 1);
+
+                        auto arc_count = getResidualArcCount(topology, current_node);
+                        for (std::size_t j = 0; j < arc_count; ++j) {
+                            auto arc = getResidualArc(topology, current_node, j);
+                            auto neighbour = getArcHead(topology, arc);
+
+                            // The opposite arc leads from the neighbour to the current node
+                            if (getResidualCapacity(m_graph, arc ^ 1) > 0 && claim(neighbour)) {
+                                m_graph.node_levels[neighbour] = next_height;
+                                next.push_back(neighbour);
+                            }
+                        }
+                    }
+                }
+            });
+
+            frontier.clear();
+            for (auto& next : m_next_active) {
+                frontier.insert(frontier.end(), next.begin(), next.end());
+                next.clear();
+            }
+        }
+    };
+
+    // Distance to the end node, then distance to the start node above all of them.
+    // The start node always stays at the height of node count.
+    m_relabel_mark[m_end_node] = mark;
+    m_relabel_mark[m_start_node] = mark;
+    bfs(m_end_node, 0);
+    bfs(m_start_node, node_count);
+
+    // Nodes that can reach neither of them can't have any excess.
+    // Every node with excess becomes active again.
+    m_next_index = 0;
+    m_pool.run([&](std::size_t thread_index) {
+        std::size_t begin;
+        while ((begin = m_next_index.fetch_add(chunk_size)) < node_count) {
+            auto end = std::min(begin + chunk_size, node_count);
+            for (auto node = begin; node < end; ++node) {
+                if (m_relabel_mark[node].load() != mark) {
+                    m_graph.node_levels[node] = 2 * node_count - 1;
+                }
+                if (m_excess[node].load() > 0) {
+                    enqueue(node, thread_index);
+                }
+            }
+        }
+    });
+    startNextRound();
+    m_relabels_since_global = 0;
+}
+
+void ParallelPushRelabelGraphAlgorithm::runRound() {
+    m_next_index = 0;
+    m_pool.run([&](std::size_t thread_index) {
+        std::size_t relabels = 0;
+        std::size_t begin;
+        while ((begin = m_next_index.fetch_add(chunk_size)) < m_active.size()) {
+            auto end = std::min(begin + chunk_size, m_active.size());
+            for (auto i = begin; i < end; ++i) {
+                relabels += discharge(m_active[i], thread_index);
+            }
+        }
+        m_relabels_since_global.fetch_add(relabels);
+    });
+    startNextRound();
+
+    if (m_relabels_since_global >= m_graph.node_count) {
+        globalRelabel();
+    }
+}
+
+void ParallelPushRelabelGraphAlgorithm::initializePreflow() {
+    auto& topology = m_graph.getTopology();
+
+    for (auto edge_index : topology.getOutgoingEdges(m_start_node)) {
+        auto capacity = topology.edges[edge_index].capacity;
+        auto to_node = topology.edges[edge_index].to_node_index;
+
+        m_graph.edge_flows[edge_index] += capacity;
+        m_excess[to_node] += capacity;
+    }
+
+    globalRelabel();
+}
+
+void ParallelPushRelabelGraphAlgorithm::takeSnapshot() {
+    auto& topology = m_graph.getTopology();
+
+    for (std::size_t node = 0; node < m_graph.node_count; ++node) {
+        if (node == m_start_node || node == m_end_node) {
+            continue;
+        }
+        m_graph.node_states[node] = (m_excess[node] > 0) ? FlowNodeState::HasExcess : FlowNodeState::Default;
+    }
+
+    // Show only flow changes since the last snapshot
+    for (std::size_t edge_index = 0; edge_index < m_graph.edge_count; ++edge_index) {
+        auto flow = m_graph.edge_flows[edge_index];
+        if (flow == topology.edges[edge_index].capacity) {
+            m_graph.edge_states[edge_index] = FlowEdgeState::Saturated;
+        }
+        else if (flow != m_snapshot_flows[edge_index]) {
+            m_graph.edge_states[edge_index] = FlowEdgeState::OnUnsaturatedPath;
+        }
+        else {
+            m_graph.edge_states[edge_index] = FlowEdgeState::Default;
+        }
+        m_snapshot_flows[edge_index] = flow;
+    }
+}
+
+bool ParallelPushRelabelGraphAlgorithm::nextStep() {
+    if (m_start_node == m_end_node) {
+        return false;
+    }
+
+    // Lets the renderer draw the initial preflow
+    if (!m_initialized) {
+        initializePreflow();
+        m_initialized = true;
+        takeSnapshot();
+        return true;
+    }
+
+    // We are finished if there is no active node
+    if (m_active.empty()) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < m_rounds_per_snapshot && !m_active.empty(); ++i) {
+        runRound();
+    }
+    takeSnapshot();
+    return true;
+}
+
+const Graph& ParallelPushRelabelGraphAlgorithm::getState() const {
+    return m_graph;
+}
+
+std::size_t ParallelPushRelabelGraphAlgorithm::getMaxFlow() const {
+    return m_excess[m_end_node].load();
+}
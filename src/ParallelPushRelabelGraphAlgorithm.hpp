@@ -0,0 +1,125 @@
+#ifndef ParallelPushRelabelGraphAlgorithm_hpp
+#define ParallelPushRelabelGraphAlgorithm_hpp
+
+#include "FlowGraph.hpp"
+#include "GraphAlgorithm.hpp"
+#include "ThreadPool.hpp"
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Class for the multi-threaded lock-free push-relabel algorithm in a flow graph.
+ *
+ * The algorithm runs in rounds. In each round the active nodes are split between the threads and
+ * discharged concurrently: a node pushes to its lowest residual neighbour if it is higher than it,
+ * otherwise it is lifted just above it. Excess, heights and flows are only changed by atomic operations
+ * and every node is discharged by a single thread in a round, so no locks are needed. Between rounds
+ * heights are recomputed by a level-synchronous parallel BFS over the reversed residual graph.
+ *
+ * Steps of the visualization are snapshots taken after a given number of rounds,
+ * not single push and relabel operations.
+ */
+class ParallelPushRelabelGraphAlgorithm : public GraphAlgorithm {
+    FlowGraph m_graph; // Heights are kept in node_levels and flows in edge_flows, both updated atomically
+    ThreadPool m_pool;
+    std::size_t m_start_node; // Index of the start node
+    std::size_t m_end_node; // Index of the end node
+    std::size_t m_rounds_per_snapshot; // Number of rounds run in one step
+    std::vector<std::atomic<std::size_t>> m_excess; // Excess of flow in each node
+    std::vector<std::atomic<std::size_t>> m_queued_round; // Last round each node was queued for
+    std::vector<std::atomic<std::size_t>> m_relabel_mark; // Number of the global relabel that last reached each node
+    std::vector<std::size_t> m_active; // Active nodes discharged in the current round
+    std::vector<std::vector<std::size_t>> m_next_active; // Nodes activated by each thread for the next round
+    std::atomic<std::size_t> m_next_index; // Position of the next unclaimed chunk of work
+    std::atomic<std::size_t> m_relabels_since_global; // Number of relabels since the last global relabel
+    std::size_t m_round; // Number of the current round
+    std::size_t m_global_relabels; // Number of global relabels done so far
+    std::vector<std::size_t> m_snapshot_flows; // Flows at the time of the last snapshot
+    bool m_initialized;
+
+    /**
+     * Returns the residual capacity of the arc, safe to call while other threads push flow.
+     *
+     * @param arc The encoded residual arc.
+     */
+    std::size_t loadResidualCapacity(std::size_t arc);
+
+    /**
+     * Queues the node to be discharged in the next round, unless it is already queued.
+     *
+     * @param node Index of the node.
+     * @param thread_index Index of the thread queueing the node.
+     */
+    void enqueue(std::size_t node, std::size_t thread_index);
+
+    /**
+     * Pushes and relabels the node until it has no excess. Only one thread may discharge a node at once.
+     *
+     * @param node Index of the node.
+     * @param thread_index Index of the thread discharging the node.
+     * @return Number of relabels done.
+     */
+    std::size_t discharge(std::size_t node, std::size_t thread_index);
+
+    /**
+     * Moves nodes queued by all threads to the list of active nodes of the next round.
+     */
+    void startNextRound();
+
+    /**
+     * Recomputes exact heights of all nodes by parallel BFS over the reversed residual graph
+     * and rebuilds the list of active nodes.
+     */
+    void globalRelabel();
+
+    /**
+     * Discharges all active nodes concurrently.
+     */
+    void runRound();
+
+    /**
+     * Saturates all edges leaving the start node and computes the initial heights.
+     */
+    void initializePreflow();
+
+    /**
+     * Copies the current excesses and flows into the states of nodes and edges.
+     */
+    void takeSnapshot();
+
+public:
+    /**
+     * Constructor for ParallelPushRelabelGraphAlgorithm.
+     *
+     * @param graph The flow graph in which the maximal flow is found.
+     * @param thread_count Number of threads, zero means one thread per hardware thread.
+     * @param rounds_per_snapshot Number of rounds run in one step of the visualization.
+     */
+    ParallelPushRelabelGraphAlgorithm(FlowGraph&& graph, std::size_t thread_count, std::size_t rounds_per_snapshot = 1);
+
+    /**
+     * Executes the next step of the parallel push-relabel algorithm.
+     *
+     * The first step creates the initial preflow, every next step runs the given number of rounds.
+     * Nodes with excess and edges whose flow changed since the last step are highlighted.
+     *
+     * @return True if there are more steps to be taken, false otherwise.
+     */
+    virtual bool nextStep() override;
+
+    /**
+     * Returns the current state of the graph.
+     *
+     * @return A constant reference to the current state of the graph.
+     */
+    virtual const Graph& getState() const override;
+
+    /**
+     * Returns the value of the flow that reached the end node so far,
+     * the maximal flow once the algorithm is finished.
+     */
+    std::size_t getMaxFlow() const;
+};
+
+#endif
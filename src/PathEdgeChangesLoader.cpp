@@ -0,0 +1,43 @@
+#include "PathEdgeChangesLoader.hpp"
+#include "PathGraph.hpp"
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+std::vector<PathEdgeChange> loadPathEdgeChanges(std::istream& input) {
+    std::vector<PathEdgeChange> changes;
+    std::string line;
+
+    while (std::getline(input, line)) {
+        std::size_t start = line.find_first_not_of(" \t\n\r");
+        // Skip empty lines and comments
+        if (start == std::string::npos || line[start] == '#') {
+            continue;
+        }
+
+        std::istringstream iss(line);
+        PathEdgeChange change;
+        std::string action;
+        std::string rest;
+        if (!(iss >> change.step >> action >> change.from_node >> change.to_node) || (iss >> rest)) {
+            throw std::runtime_error("Invalid format for edge change: " + line);
+        }
+        if (action == "ADD") {
+            change.insert = true;
+        }
+        else if (action == "REMOVE") {
+            change.insert = false;
+        }
+        else {
+            throw std::runtime_error("Invalid edge change action: " + action);
+        }
+        changes.push_back(change);
+    }
+
+    std::stable_sort(changes.begin(), changes.end(), [](const PathEdgeChange& first, const PathEdgeChange& second) {
+        return first.step < second.step;
+    });
+    return changes;
+}
@@ -0,0 +1,21 @@
+#ifndef PathEdgeChangesLoader_hpp
+#define PathEdgeChangesLoader_hpp
+
+#include "PathGraph.hpp"
+#include <istream>
+#include <vector>
+
+/**
+* Loads a script of edge insertions and deletions from the provided input stream.
+*
+* Every non-empty line not starting with '#' is one change "STEP ADD|REMOVE FROM_NODE_INDEX TO_NODE_INDEX".
+* The changed edge has to be in the graph config, of parallel edges the first one is changed.
+* An edge whose first change is ADD is missing from the graph until it is added.
+*
+* @param input The input stream containing the script.
+* @return The loaded changes sorted by step, changes of the same step stay in the order of the script.
+* @throws std::runtime_error if an error occurs while reading the data.
+*/
+std::vector<PathEdgeChange> loadPathEdgeChanges(std::istream& input);
+
+#endif
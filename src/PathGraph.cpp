@@ -1,20 +1,21 @@
 #include "PathGraph.hpp"
 #include "DrawHelpers.hpp"
 #include "Frame.hpp"
+#include <algorithm>
 #include <cstddef>
 #include <cstdlib>
+#include <stdexcept>
 
 PathNode::PathNode(std::size_t pos_x, std::size_t pos_y, std::size_t size, 
-        PathNodeColorPalette palette, PathNodeState state, bool is_start_node, bool is_end_node)
+        PathNodeColorPalette palette, bool is_start_node, bool is_end_node)
     :   pos_x(pos_x), 
         pos_y(pos_y),
         m_size(size),
         m_color_palette(palette),
-        state(state),
         is_start_node(is_start_node),
         is_end_node(is_end_node) {}
 
-Color PathNode::getNodeColor() const {
+Color PathNode::getNodeColor(PathNodeState state) const {
     if (state == PathNodeState::OnShortestPath) {
         return m_color_palette.on_shortest_path_color;
     }
@@ -32,13 +33,19 @@ Color PathNode::getNodeColor() const {
     if (state == PathNodeState::Found) {
         return m_color_palette.found_unvisited_node_color;
     }
+    if (state == PathNodeState::VisitedBackward) {
+        return m_color_palette.visited_backward_node_color;
+    }
+    if (state == PathNodeState::FoundBackward) {
+        return m_color_palette.found_backward_node_color;
+    }
 
     return m_color_palette.unfound_node_color;
 }
 
 PathEdge::PathEdge(std::size_t from, std::size_t to, std::size_t length, 
     std::size_t width, std::size_t pos_x, std::size_t pos_y,
-    bool is_horizontal, bool direction_from_top_left, PathEdgeState state, 
+    bool is_horizontal, bool direction_from_top_left, 
     PathEdgeColorPalette palette)
     :   from_node_index{from}, 
         to_node_index{to}, 
@@ -48,24 +55,35 @@ PathEdge::PathEdge(std::size_t from, std::size_t to, std::size_t length,
         m_pos_y{pos_y},
         m_is_horizontal{is_horizontal},
         m_direction_from_top_left(direction_from_top_left),
-        state{state},
         m_color_palette{palette} {}
 
 PathEdge::PathEdge() {} 
 
 void PathNode::draw(Frame& frame) const {
+    draw(frame, PathNodeState::NotFound);
+}
+
+void PathNode::draw(Frame& frame, PathNodeState state) const {
     auto half_size = m_size / 2;
     auto top_left_x = pos_x - half_size;
     auto top_left_y = pos_y - half_size;
     auto bottom_right_x = pos_x + half_size;
     auto bottom_right_y = pos_y + half_size;
 
-    auto node_color = getNodeColor();
+    auto node_color = getNodeColor(state);
 
     frame.drawRectangle(top_left_x, top_left_y, bottom_right_x, bottom_right_y, node_color);
 }
 
 void PathEdge::draw(Frame& frame) const {
+    draw(frame, PathEdgeState::Default);
+}
+
+void PathEdge::draw(Frame& frame, PathEdgeState state) const {
+    if (state == PathEdgeState::Removed) {
+        return;
+    }
+
     auto horizontal_half_size = m_is_horizontal ? m_length / 2 : m_width / 2;
     auto vertical_half_size = m_is_horizontal ? m_width / 2 : m_length / 2;
 
@@ -125,39 +143,203 @@ void PathEdge::draw(Frame& frame) const {
     }
 }
 
-PathGraph::PathGraph(const PathGraphConfig& config) 
-    :   m_background_color(config.background_color),
-        edge_count(config.edges.size()),
+void PathEdge::clear(Frame& frame, const Color& background_color) const {
+    auto horizontal_half_size = m_is_horizontal ? m_length / 2 : m_width / 2;
+    auto vertical_half_size = m_is_horizontal ? m_width / 2 : m_length / 2;
+
+    frame.drawRectangle(
+        m_pos_x - horizontal_half_size,
+        m_pos_y - vertical_half_size,
+        m_pos_x + horizontal_half_size,
+        m_pos_y + vertical_half_size,
+        background_color);
+}
+
+PathGraphTopology::PathGraphTopology(const PathGraphConfig& config) 
+    :   edge_count(config.edges.size()),
         node_count(config.nodes.size()),
         start_node(config.start_node),
         end_node(config.end_node),
+        background_color(config.background_color),
+        edges(config.edges.size()),
         nodes(config.nodes.size()),
-        edges(config.edges.size()) {
+        edge_weights(config.edge_weights.empty() ? std::vector<std::size_t>(config.edges.size(), 1) : config.edge_weights),
+        min_edge_weight(0),
+        max_edge_weight(0),
+        grid_positions(config.nodes) {
 
+    if (edge_weights.size() != edge_count) {
+        throw std::runtime_error("Number of edge weights doesn't match the number of edges");
+    }
+    if (!edge_weights.empty()) {
+        auto [min_weight, max_weight] = std::minmax_element(edge_weights.begin(), edge_weights.end());
+        min_edge_weight = *min_weight;
+        max_edge_weight = *max_weight;
+    }
     populateNodesAndEdges(config);
 } 
 
+std::span<const std::size_t> PathGraphTopology::getOutgoingEdges(std::size_t node) const {
+    return std::span<const std::size_t>(
+        m_outgoing_edges.data() + m_outgoing_offsets[node],
+        m_outgoing_offsets[node + 1] - m_outgoing_offsets[node]);
+}
+
+std::span<const std::size_t> PathGraphTopology::getOutgoingNeighbours(std::size_t node) const {
+    return std::span<const std::size_t>(
+        m_outgoing_neighbours.data() + m_outgoing_offsets[node],
+        m_outgoing_offsets[node + 1] - m_outgoing_offsets[node]);
+}
+
+std::span<const std::size_t> PathGraphTopology::getIncomingEdges(std::size_t node) const {
+    return std::span<const std::size_t>(
+        m_incoming_edges.data() + m_incoming_offsets[node],
+        m_incoming_offsets[node + 1] - m_incoming_offsets[node]);
+}
+
+PathGraph::PathGraph(std::shared_ptr<const PathGraphTopology> topology)
+    :   m_topology(std::move(topology)),
+        edge_count(m_topology->edge_count),
+        node_count(m_topology->node_count),
+        start_node(m_topology->start_node),
+        end_node(m_topology->end_node),
+        node_states(m_topology->node_count, PathNodeState::NotFound),
+        edge_states(m_topology->edge_count, PathEdgeState::Default) {}
+
+const PathGraphTopology& PathGraph::getTopology() const {
+    return *m_topology;
+}
+
 void PathGraph::draw(Frame& frame) const {
     frame.drawRectangle(
         0, 
         0, 
         frame.width(),
         frame.height(), 
-        m_background_color
+        m_topology->background_color
     );
 
     for (std::size_t i = 0; i < edge_count; ++i) {
-        PathEdge edge = edges[i];
-        edge.draw(frame);
+        m_topology->edges[i].draw(frame, edge_states[i]);
     }
 
     for (std::size_t i = 0; i < node_count; ++i) {
-        PathNode node = nodes[i];
-        node.draw(frame);
+        m_topology->nodes[i].draw(frame, node_states[i]);
+    }
+}
+
+bool PathGraph::drawChange(Frame& frame, const StepEvent& event) const {
+    auto& topology = *m_topology;
+
+    if (event.type == StepEvent::Type::NodeState) {
+        topology.nodes[event.index].draw(frame, node_states[event.index]);
+        return true;
+    }
+    if (event.type != StepEvent::Type::EdgeState) {
+        return false;
     }
+
+    auto from = topology.edges[event.index].from_node_index;
+    auto to = topology.edges[event.index].to_node_index;
+    topology.edges[event.index].clear(frame, topology.background_color);
+
+    // Edges between the same nodes cover the same area, they are drawn again in the order of draw()
+    std::vector<std::size_t> overlapping;
+    for (auto edge_index : topology.getOutgoingEdges(from)) {
+        if (topology.edges[edge_index].to_node_index == to) {
+            overlapping.push_back(edge_index);
+        }
+    }
+    for (auto edge_index : topology.getOutgoingEdges(to)) {
+        if (topology.edges[edge_index].to_node_index == from) {
+            overlapping.push_back(edge_index);
+        }
+    }
+    std::sort(overlapping.begin(), overlapping.end());
+    for (auto edge_index : overlapping) {
+        topology.edges[edge_index].draw(frame, edge_states[edge_index]);
+    }
+
+    topology.nodes[from].draw(frame, node_states[from]);
+    topology.nodes[to].draw(frame, node_states[to]);
+    return true;
 }
 
-std::pair<std::size_t, std::size_t> PathGraph::getNodePosition(
+std::unique_ptr<Graph> PathGraph::clone() const {
+    return std::make_unique<PathGraph>(*this);
+}
+
+bool PathGraph::applyChange(const StepEvent& event) {
+    if (event.type == StepEvent::Type::NodeState && event.index < node_count) {
+        node_states[event.index] = static_cast<PathNodeState>(event.state);
+        return true;
+    }
+    if (event.type == StepEvent::Type::EdgeState && event.index < edge_count) {
+        edge_states[event.index] = static_cast<PathEdgeState>(event.state);
+        return true;
+    }
+    return false;
+}
+
+bool PathGraph::describeState(StepEventSink& sink) const {
+    for (std::size_t node = 0; node < node_count; ++node) {
+        if (node_states[node] != PathNodeState::NotFound) {
+            sink.onStepEvent(StepEvent::nodeState(node, node_states[node]));
+        }
+    }
+    for (std::size_t edge = 0; edge < edge_count; ++edge) {
+        if (edge_states[edge] != PathEdgeState::Default) {
+            sink.onStepEvent(StepEvent::edgeState(edge, edge_states[edge]));
+        }
+    }
+    return true;
+}
+
+std::vector<std::size_t> PathGraph::getMarkedPath() const {
+    auto& topology = *m_topology;
+    std::vector<std::size_t> path;
+    auto node = start_node;
+
+    // A marked shortest path has at most node_count - 1 edges, anything longer would be a cycle
+    while (node != end_node && path.size() < node_count) {
+        auto outgoing = topology.getOutgoingEdges(node);
+        auto marked = std::find_if(outgoing.begin(), outgoing.end(), [this](std::size_t edge) {
+            return edge_states[edge] == PathEdgeState::OnShortestPath;
+        });
+        if (marked == outgoing.end()) {
+            return {};
+        }
+        path.push_back(*marked);
+        node = topology.getOutgoingNeighbours(node)[marked - outgoing.begin()];
+    }
+    if (node != end_node) {
+        return {};
+    }
+    return path;
+}
+
+void PathGraph::printResult(std::ostream& output) const {
+    auto& topology = *m_topology;
+    auto path = getMarkedPath();
+
+    if (path.empty() && start_node != end_node) {
+        output << "Path: not found" << std::endl;
+        return;
+    }
+
+    std::size_t length = 0;
+    for (auto edge : path) {
+        length += topology.edge_weights[edge];
+    }
+    output << "Path length: " << length << std::endl;
+    output << "Path: " << start_node;
+    for (auto edge : path) {
+        output << " " << topology.edges[edge].to_node_index;
+    }
+    output << std::endl;
+}
+
+std::pair<std::size_t, std::size_t> PathGraphTopology::getNodePosition(
     std::pair<std::size_t, std::size_t> indecies,
     const PathGraphConfig& config) const {
 
@@ -197,7 +379,7 @@ static bool isEdgeDirectionFromTopLeft(const PathNode& from, const PathNode& to,
     return false;
 }
 
-void PathGraph::populateNodesAndEdges(const PathGraphConfig& config) {
+void PathGraphTopology::populateNodesAndEdges(const PathGraphConfig& config) {
     for (std::size_t i = 0; i < node_count; ++i) {
         auto position = getNodePosition(config.nodes[i], config);
 
@@ -206,7 +388,6 @@ void PathGraph::populateNodesAndEdges(const PathGraphConfig& config) {
             position.second,
             config.node_size,
             config.node_color_palette,
-            PathNodeState::NotFound,
             i == config.start_node,
             i == config.end_node
         );
@@ -229,10 +410,38 @@ void PathGraph::populateNodesAndEdges(const PathGraphConfig& config) {
             edge_center_pos.second,
             is_horizontal,
             direction_from_top_left,
-            PathEdgeState::Default,
             config.edge_color_palette
         );
+    }
 
-        nodes[from_index].edges.push_back(i);
+    // Group outgoing edges by their nodes, keeping the order of the config within each node
+    m_outgoing_offsets.assign(node_count + 1, 0);
+    for (auto& edge : edges) {
+        m_outgoing_offsets[edge.from_node_index + 1]++;
+    }
+    for (std::size_t i = 0; i < node_count; ++i) {
+        m_outgoing_offsets[i + 1] += m_outgoing_offsets[i];
+    }
+    m_outgoing_edges.resize(edge_count);
+    m_outgoing_neighbours.resize(edge_count);
+    std::vector<std::size_t> next_position(m_outgoing_offsets.begin(), m_outgoing_offsets.end() - 1);
+    for (std::size_t i = 0; i < edge_count; ++i) {
+        auto position = next_position[edges[i].from_node_index]++;
+        m_outgoing_edges[position] = i;
+        m_outgoing_neighbours[position] = edges[i].to_node_index;
+    }
+
+    // The same for incoming edges
+    m_incoming_offsets.assign(node_count + 1, 0);
+    for (auto& edge : edges) {
+        m_incoming_offsets[edge.to_node_index + 1]++;
+    }
+    for (std::size_t i = 0; i < node_count; ++i) {
+        m_incoming_offsets[i + 1] += m_incoming_offsets[i];
+    }
+    m_incoming_edges.resize(edge_count);
+    next_position.assign(m_incoming_offsets.begin(), m_incoming_offsets.end() - 1);
+    for (std::size_t i = 0; i < edge_count; ++i) {
+        m_incoming_edges[next_position[edges[i].to_node_index]++] = i;
     }
 }
\ No newline at end of file
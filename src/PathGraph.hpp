@@ -5,13 +5,17 @@
 #include "Graph.hpp"
 #include "Node.hpp"
 #include <cstddef>
+#include <memory>
+#include <span>
 #include <vector>
 
-// Enumeration representing the state of a path node
-enum class PathNodeState { NotFound, Found, Visited, OnShortestPath };
+// Enumeration representing the state of a path node.
+// Backward states are used by searches running from the end node as well.
+enum class PathNodeState { NotFound, Found, Visited, OnShortestPath, FoundBackward, VisitedBackward };
 
-// Enumeration representing the state of a path edge
-enum class PathEdgeState { Default, Peeked, Used, OnShortestPath };
+// Enumeration representing the state of a path edge.
+// Removed edges were deleted from the graph during the run and are not drawn.
+enum class PathEdgeState { Default, Peeked, Used, OnShortestPath, Removed };
 
 
 class PathNode;
@@ -23,7 +27,9 @@ struct PathNodeColorPalette {
     found_unvisited_node_color,
     unfound_node_color,
     visited_node_color,
-    on_shortest_path_color;
+    on_shortest_path_color,
+    found_backward_node_color,
+    visited_backward_node_color;
 };
 
 // Structure representing the color palette for a path edge
@@ -35,7 +41,7 @@ struct PathEdgeColorPalette {
     arrow_color;
 };
 
-// Class representing a path edge in a graph, derived from the Edge base class
+// Class representing the layout of a path edge in a graph, derived from the Edge base class
 class PathEdge : public Edge {
     PathEdgeColorPalette m_color_palette;
     std::size_t m_length, m_width; 
@@ -44,7 +50,6 @@ class PathEdge : public Edge {
     bool m_direction_from_top_left; // True if direction of the edge is from top down or left to right
 
 public:
-    PathEdgeState state;
     std::size_t from_node_index;
     std::size_t to_node_index;
 
@@ -62,23 +67,38 @@ public:
      * @param pos_y y-coordinate of the edge center position.
      * @param is_horizontal True if the edge is horizontal, false otherwise.
      * @param direction_from_top_left True if direction of the edge is from top down or left to right, false otherwise.
-     * @param state State of the edge.
      * @param palette Color palette for the edge.
      */
     PathEdge(std::size_t from, std::size_t to, std::size_t length,
         std::size_t width, std::size_t pos_x, std::size_t pos_y,
-        bool is_horizontal, bool direction_from_top_left, PathEdgeState state, 
+        bool is_horizontal, bool direction_from_top_left, 
         PathEdgeColorPalette palette);
 
     /**
-     * Draws the path edge on the given frame.
+     * Draws the path edge in the given state on the given frame.
+     *
+     * @param frame The frame on which the path edge should be drawn.
+     * @param state State of the edge.
+     */
+    void draw(Frame& frame, PathEdgeState state) const;
+
+    /**
+     * Paints the area of the path edge with the background color, so it can be drawn again.
+     *
+     * @param frame The frame on which the path edge was drawn.
+     * @param background_color Background color of the graph.
+     */
+    void clear(Frame& frame, const Color& background_color) const;
+
+    /**
+     * Draws the path edge in the default state on the given frame.
      *
      * @param frame The frame on which the path edge should be drawn.
      */
     virtual void draw(Frame& frame) const override;
 };
 
-// Class representing a path node in a graph, derived from the Node base class
+// Class representing the layout of a path node in a graph, derived from the Node base class
 class PathNode : public Node {
     std::size_t m_size;
     PathNodeColorPalette m_color_palette;
@@ -86,16 +106,14 @@ class PathNode : public Node {
     /**
      * Returns the color of the node based on its state.
      *
+     * @param state State of the node.
      * @return The color of the node.
      */
-    Color getNodeColor() const;
+    Color getNodeColor(PathNodeState state) const;
 
 public:
     std::size_t pos_x, pos_y; // Position of the center of the node (x, y)
-    PathNodeState state;
     bool is_start_node, is_end_node; 
-    std::size_t entered_by; // Index of the edge the node was entered by
-    std::vector<std::size_t> edges; // List of edges connected to the node
 
     // Default constructor for PathNode
     PathNode() {};
@@ -107,14 +125,22 @@ public:
      * @param pos_y y-coordinate of the node center position.
      * @param size Size of the node.
      * @param palette Color palette for the node.
-     * @param state State of the node.
-     * @param type Type of the node.
+     * @param is_start True if the node is the start node.
+     * @param is_end True if the node is the end node.
      */
     PathNode(std::size_t pos_x, std::size_t pos_y, std::size_t size,
-        PathNodeColorPalette palette, PathNodeState state, bool is_start, bool is_end);
+        PathNodeColorPalette palette, bool is_start, bool is_end);
+
+    /**
+     * Draws the path node in the given state on the given frame.
+     *
+     * @param frame The frame on which the path node should be drawn.
+     * @param state State of the node.
+     */
+    void draw(Frame& frame, PathNodeState state) const;
 
     /**
-     * Draws the path node on the given frame.
+     * Draws the path node in the default state on the given frame.
      *
      * @param frame The frame on which the path node should be drawn.
      */
@@ -128,6 +154,7 @@ struct PathGraphConfig {
     std::vector<std::pair<std::size_t, std::size_t>> nodes; // List of node coordinates in the grid graph
     std::vector<std::pair<std::size_t, std::size_t>> edges; // List of pair of nodes to be connected by an edge in the graph. 
                                                             // First is 'from' second is 'to'
+    std::vector<std::size_t> edge_weights; // Weight of each edge in the order of edges, all weights are 1 if empty
     std::size_t start_node; // Index of the start node
     std::size_t end_node; // Index of the end node
     PathNodeColorPalette node_color_palette; // Color palette for path nodes
@@ -139,9 +166,27 @@ struct PathGraphConfig {
     std::size_t frame_delay; // Frame delay in tens of miliseconds
 };
 
-// Class representing a path graph, derived from the Graph base class
-class PathGraph : public Graph {
-    Color m_background_color; // Background color of the graph
+// Structure representing an insertion or deletion of an edge of a path graph during an algorithm run
+struct PathEdgeChange {
+    std::size_t step; // Number of the algorithm step before which the change is applied
+    bool insert; // True if the edge is inserted, false if it is removed
+    std::size_t from_node; // Index of the node the edge leaves from
+    std::size_t to_node; // Index of the node the edge enters
+};
+
+/**
+ * Class representing the immutable topology and layout of a path graph.
+ *
+ * It is built once from the configuration and shared (read-only) by any number of PathGraph
+ * states, so several algorithm runs on one input don't have to rebuild it. Outgoing edges of all
+ * nodes are stored in one contiguous array.
+ */
+class PathGraphTopology {
+    std::vector<std::size_t> m_outgoing_edges; // Outgoing edges of all the nodes, grouped by node
+    std::vector<std::size_t> m_outgoing_offsets; // Start of outgoing edges of each node in m_outgoing_edges
+    std::vector<std::size_t> m_outgoing_neighbours; // Target node of each edge in m_outgoing_edges
+    std::vector<std::size_t> m_incoming_edges; // Incoming edges of all the nodes, grouped by node
+    std::vector<std::size_t> m_incoming_offsets; // Start of incoming edges of each node in m_incoming_edges
 
     /**
      * Populates the nodes and edges of the graph based on the configuration.
@@ -166,15 +211,73 @@ public:
     std::size_t node_count;
     std::size_t start_node; // Index of the start node
     std::size_t end_node; // Index of the end node
+    Color background_color; // Background color of the graph
     std::vector<PathEdge> edges;
     std::vector<PathNode> nodes;
+    std::vector<std::size_t> edge_weights; // Weight of each edge
+    std::size_t min_edge_weight; // Lowest weight of an edge, 0 if there are no edges
+    std::size_t max_edge_weight; // Highest weight of an edge, 0 if there are no edges
+    std::vector<std::pair<std::size_t, std::size_t>> grid_positions; // Grid coordinates (x, y) of each node
 
     /**
-     * Constructor for PathGraph.
+     * Constructor for PathGraphTopology.
      *
      * @param config The configuration for the path graph.
+     * @throws std::runtime_error if the number of edge weights doesn't match the number of edges.
+     */
+    PathGraphTopology(const PathGraphConfig& config);
+
+    /**
+     * Returns indices of the edges leaving the given node.
+     *
+     * @param node Index of the node.
+     * @return A view of the edge indices.
+     */
+    std::span<const std::size_t> getOutgoingEdges(std::size_t node) const;
+
+    /**
+     * Returns indices of the nodes the edges leaving the given node go to, in the order of getOutgoingEdges().
+     * Traversals that don't need the edges themselves read just this compact array.
+     *
+     * @param node Index of the node.
+     * @return A view of the node indices.
+     */
+    std::span<const std::size_t> getOutgoingNeighbours(std::size_t node) const;
+
+    /**
+     * Returns indices of the edges entering the given node.
+     *
+     * @param node Index of the node.
+     * @return A view of the edge indices.
+     */
+    std::span<const std::size_t> getIncomingEdges(std::size_t node) const;
+};
+
+// Class representing the state of a run of an algorithm on a path graph, derived from the Graph base class
+class PathGraph : public Graph {
+    std::shared_ptr<const PathGraphTopology> m_topology; // Shared topology and layout of the graph
+
+public:
+    std::size_t edge_count;
+    std::size_t node_count;
+    std::size_t start_node; // Index of the start node
+    std::size_t end_node; // Index of the end node
+    std::vector<PathNodeState> node_states; // State of each node
+    std::vector<PathEdgeState> edge_states; // State of each edge
+
+    /**
+     * Constructor for PathGraph. All nodes and edges start in their default state.
+     *
+     * @param topology The shared topology of the path graph.
+     */
+    PathGraph(std::shared_ptr<const PathGraphTopology> topology);
+
+    /**
+     * Returns the topology of the graph.
+     *
+     * @return A constant reference to the shared topology.
      */
-    PathGraph(const PathGraphConfig& config);
+    const PathGraphTopology& getTopology() const;
 
     /**
      * Draws the path graph on the given frame.
@@ -182,6 +285,50 @@ public:
      * @param frame The frame on which the path graph should be drawn.
      */
     virtual void draw(Frame& frame) const override;
+
+    /**
+     * Redraws the node or the edge changed by the event. An edge is drawn again together with
+     * the edge going the other way between the same nodes and both its nodes, as they overlap it.
+     *
+     * @param frame The frame holding the drawing of the path graph from before the step.
+     * @param event The change made by the step.
+     * @return False for changes of flow, which a path graph doesn't have, true otherwise.
+     */
+    virtual bool drawChange(Frame& frame, const StepEvent& event) const override;
+
+    /**
+     * Returns a copy of the states, the topology is shared with the copy.
+     */
+    virtual std::unique_ptr<Graph> clone() const override;
+
+    /**
+     * Changes the state of the node or the edge as described by the event.
+     *
+     * @return False for changes of flow, which a path graph doesn't have, and for nodes and edges
+     *     outside the graph, true otherwise.
+     */
+    virtual bool applyChange(const StepEvent& event) override;
+
+    /**
+     * Reports the states of the nodes and edges that are not in the default state.
+     *
+     * @return Always true.
+     */
+    virtual bool describeState(StepEventSink& sink) const override;
+
+    /**
+     * Returns the edges marked as the shortest path, in the order from the start node to the end node.
+     *
+     * @return The edge indices, empty if no path from the start node to the end node is marked.
+     */
+    std::vector<std::size_t> getMarkedPath() const;
+
+    /**
+     * Prints the length and the nodes of the path marked as the shortest one.
+     *
+     * @param output The stream the result is printed to.
+     */
+    virtual void printResult(std::ostream& output) const override;
 };
 
 
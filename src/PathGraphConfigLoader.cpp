@@ -7,6 +7,7 @@
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 // Helper function to trim leading and trailing whitespace from a string
@@ -16,6 +17,15 @@ static std::string trim(const std::string& str) {
     return (start == std::string::npos) ? "" : str.substr(start, end - start + 1);
 }
 
+// Helper function to mix two colors half and half
+static Color blendColors(Color first, Color second) {
+    return {
+        static_cast<uint8_t>((first.R + second.R) / 2),
+        static_cast<uint8_t>((first.G + second.G) / 2),
+        static_cast<uint8_t>((first.B + second.B) / 2)
+    };
+}
+
 // Parsing functions for each section
 void parseGridData(const std::string& line, PathGraphConfig& config, std::size_t section_row) {
     std::istringstream iss(line);
@@ -53,7 +63,7 @@ void parseGridData(const std::string& line, PathGraphConfig& config, std::size_t
     }
 }
 
-void parseNodes(const std::string& line, PathGraphConfig& config) {
+void parseNodes(const std::string& line, const PathGraphConfig& config, const PathGraphNodeHandler& on_node) {
     std::istringstream iss(line);
     std::size_t node_x, node_y;
 
@@ -62,25 +72,30 @@ void parseNodes(const std::string& line, PathGraphConfig& config) {
         throw std::runtime_error("Invalid format for node data: " + line);
     }
 
-    // Add node to the configuration
-    config.nodes.emplace_back(node_x, node_y);
+    on_node(config, node_x, node_y);
 }
 
-void parseEdges(const std::string& line, PathGraphConfig& config) {
+void parseEdges(const std::string& line, const PathGraphConfig& config, std::size_t node_count,
+        const PathGraphEdgeHandler& on_edge) {
     std::istringstream iss(line);
     std::size_t from_node, to_node;
+    std::size_t weight = 1;
 
     // Parse edge data
     if (!(iss >> from_node >> to_node)) {
         throw std::runtime_error("Invalid format for edge data: " + line);
     }
 
-    if (from_node >= config.nodes.size() || to_node >= config.nodes.size()) {
+    // Parse the optional weight
+    if (!(iss >> std::ws).eof() && !(iss >> weight)) {
+        throw std::runtime_error("Invalid format for edge weight: " + line);
+    }
+
+    if (from_node >= node_count || to_node >= node_count) {
         throw std::runtime_error("Invalid node index in edge data: " + line);
     }
 
-    // Add edge to the configuration
-    config.edges.emplace_back(from_node, to_node);
+    on_edge(config, from_node, to_node, weight);
 }
 
 void parseVisualization(const std::string& line, PathGraphConfig& config, std::size_t section_row) {
@@ -179,6 +194,20 @@ void parseNodePalette(const std::string& line, PathNodeColorPalette& palette, st
             }
             palette.end_node_color = {static_cast<uint8_t>(r), static_cast<uint8_t>(g), static_cast<uint8_t>(b)};
             break;
+        case 6:
+            // Parse optional found backward node color
+            if (!(iss >> r >> g >> b)) {
+                throw std::runtime_error("Invalid format for node palette: found backward node color");
+            }
+            palette.found_backward_node_color = {static_cast<uint8_t>(r), static_cast<uint8_t>(g), static_cast<uint8_t>(b)};
+            break;
+        case 7:
+            // Parse optional visited backward node color
+            if (!(iss >> r >> g >> b)) {
+                throw std::runtime_error("Invalid format for node palette: visited backward node color");
+            }
+            palette.visited_backward_node_color = {static_cast<uint8_t>(r), static_cast<uint8_t>(g), static_cast<uint8_t>(b)};
+            break;
         default:
             throw std::runtime_error("Invalid node palette data: unexpected line in the section");
     }
@@ -229,12 +258,15 @@ void parseEdgePalette(const std::string& line, PathEdgeColorPalette& palette, st
     }
 }
 
-PathGraphConfig loadPathGraphConfig(std::istream& input) {
-    PathGraphConfig config;
+PathGraphConfig streamPathGraphConfig(std::istream& input, const PathGraphNodeHandler& on_node,
+        const PathGraphEdgeHandler& on_edge) {
+    PathGraphConfig config{};
 
     std::string line;
     std::string section; // Current section being parsed
     std::size_t section_row = 0; // Row index in the current section
+    std::size_t node_palette_rows = 0; // Number of rows in the node palette section
+    std::size_t node_count = 0; // Number of nodes read so far
 
     while (std::getline(input, line)) {
         line = trim(line);
@@ -256,15 +288,17 @@ PathGraphConfig loadPathGraphConfig(std::istream& input) {
             parseGridData(line, config, section_row);
             section_row++;
         } else if (section == "[NODES]") {
-            parseNodes(line, config);
+            parseNodes(line, config, on_node);
+            node_count++;
         } else if (section == "[EDGES]") {
-            parseEdges(line, config);
+            parseEdges(line, config, node_count, on_edge);
         } else if (section == "[VISUALIZATION]") {
             parseVisualization(line, config, section_row);
             section_row++;
         } else if (section == "[NODE PALETTE]") {
             parseNodePalette(line, config.node_color_palette, section_row);
             section_row++;
+            node_palette_rows = section_row;
         } else if (section == "[EDGE PALETTE]") {
             parseEdgePalette(line, config.edge_color_palette, section_row);
             section_row++;
@@ -273,5 +307,35 @@ PathGraphConfig loadPathGraphConfig(std::istream& input) {
         }
     }
 
+    // Colors of the search from the end node are optional, by default they are tinted by the end node color
+    auto& palette = config.node_color_palette;
+    if (node_palette_rows < 7) {
+        palette.found_backward_node_color = blendColors(palette.found_unvisited_node_color, palette.end_node_color);
+    }
+    if (node_palette_rows < 8) {
+        palette.visited_backward_node_color = blendColors(palette.visited_node_color, palette.end_node_color);
+    }
+
+    return config;
+}
+
+PathGraphConfig loadPathGraphConfig(std::istream& input) {
+    std::vector<std::pair<std::size_t, std::size_t>> nodes;
+    std::vector<std::pair<std::size_t, std::size_t>> edges;
+    std::vector<std::size_t> edge_weights;
+
+    auto config = streamPathGraphConfig(
+        input,
+        [&](const PathGraphConfig&, std::size_t node_x, std::size_t node_y) {
+            nodes.emplace_back(node_x, node_y);
+        },
+        [&](const PathGraphConfig&, std::size_t from_node, std::size_t to_node, std::size_t weight) {
+            edges.emplace_back(from_node, to_node);
+            edge_weights.push_back(weight);
+        }
+    );
+    config.nodes = std::move(nodes);
+    config.edges = std::move(edges);
+    config.edge_weights = std::move(edge_weights);
     return config;
-};
\ No newline at end of file
+}
\ No newline at end of file
@@ -2,8 +2,17 @@
 #define PathGraphConfigLoader_hpp
 
 #include "PathGraph.hpp"
+#include <cstddef>
+#include <functional>
 #include <istream>
 
+// Function called for every node of a streamed configuration with its x and y coordinates
+using PathGraphNodeHandler = std::function<void(const PathGraphConfig& config, std::size_t node_x, std::size_t node_y)>;
+
+// Function called for every edge of a streamed configuration with the indices of its nodes and its weight
+using PathGraphEdgeHandler = std::function<void(const PathGraphConfig& config, std::size_t from_node, std::size_t to_node,
+    std::size_t weight)>;
+
 /**
 * Loads a path graph configuration from the provided input stream.
 *
@@ -13,4 +22,18 @@
 */
 PathGraphConfig loadPathGraphConfig(std::istream& input);
 
+/**
+* Reads a path graph configuration from the provided input stream without storing its nodes and edges.
+* They are passed to the handlers as they are read, together with the part of the configuration
+* read so far, so a big graph can be built without holding the whole configuration in memory.
+*
+* @param input The input stream containing the configuration data.
+* @param on_node The function called for every node, in the order of the nodes.
+* @param on_edge The function called for every edge, in the order of the edges.
+* @return The configuration without nodes, edges and edge weights.
+* @throws std::runtime_error if an error occurs while reading the data.
+*/
+PathGraphConfig streamPathGraphConfig(std::istream& input, const PathGraphNodeHandler& on_node,
+    const PathGraphEdgeHandler& on_edge);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,195 @@
+#include "PipelinedGraphAlgorithmVisualizer.hpp"
+#include "GraphAlgorithmVisualizer.hpp"
+
+#include <span>
+#include <stdexcept>
+#include <thread>
+
+PipelinedGraphAlgorithmVisualizer::PipelinedGraphAlgorithmVisualizer(std::unique_ptr<GraphAlgorithm> algorithm,
+    std::unique_ptr<Renderer> renderer, std::unique_ptr<FramePolicy> frame_policy)
+    :   m_algorithm(std::move(algorithm)),
+        m_renderer(std::move(renderer)),
+        m_frame_policy(frame_policy ? std::move(frame_policy) : std::make_unique<EveryStepFramePolicy>()),
+        m_steps(step_queue_capacity),
+        m_drawn_steps(step_queue_capacity),
+        m_free_frames(frame_pool_size) {}
+
+void PipelinedGraphAlgorithmVisualizer::compute(bool reports_events, StepEventBuffer& events) {
+    StepBatch batch;
+    std::size_t step = 0;
+    bool last_step_drawn = true;
+
+    try {
+        for (auto& nextGraph : m_algorithm->steps()) {
+            if (reports_events) {
+                batch.events.insert(batch.events.end(), events.events.begin(), events.events.end());
+                batch.step_ends.push_back(batch.events.size());
+                events.events.clear();
+            }
+
+            last_step_drawn = m_frame_policy->shouldDraw(step++, m_algorithm->endsPhase());
+            if (last_step_drawn) {
+                batch.draw = true;
+                if (!reports_events) {
+                    batch.snapshot = nextGraph.clone();
+                }
+            }
+            if (last_step_drawn || batch.events.size() >= max_batch_changes) {
+                m_steps.push(std::move(batch));
+                batch = StepBatch();
+            }
+
+            // A later stage has failed, the rest of the run would not be drawn anyway
+            if (m_failed.load(std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        if (!last_step_drawn) {
+            batch.draw = true;
+            if (!reports_events) {
+                batch.snapshot = m_algorithm->getState().clone();
+            }
+        }
+    }
+    catch (...) {
+        m_failed = true;
+        batch.last = true;
+        batch.draw = false;
+        m_steps.push(std::move(batch));
+        throw;
+    }
+
+    batch.last = true;
+    m_steps.push(std::move(batch));
+}
+
+void PipelinedGraphAlgorithmVisualizer::rasterize(std::unique_ptr<Graph> graph, bool draws_changes) {
+    // Changes since every frame of the pool was drawn, the frames start blank so they are drawn whole
+    std::vector<std::vector<StepEvent>> undrawn_changes(m_frames.size());
+    std::vector<bool> draws_whole(m_frames.size(), true);
+
+    for (bool last = false; !last;) {
+        auto batch = m_steps.pop();
+        last = batch.last;
+
+        if (!m_failed.load(std::memory_order_relaxed)) {
+            try {
+                if (batch.snapshot) {
+                    graph = std::move(batch.snapshot);
+                }
+                for (auto& event : batch.events) {
+                    if (!graph->applyChange(event)) {
+                        throw std::runtime_error("Graph can't apply the changes reported by the algorithm");
+                    }
+                }
+                for (std::size_t frame = 0; frame < m_frames.size(); ++frame) {
+                    if (!draws_changes || draws_whole[frame]) {
+                        continue;
+                    }
+                    if (undrawn_changes[frame].size() + batch.events.size() > max_undrawn_changes) {
+                        undrawn_changes[frame].clear();
+                        draws_whole[frame] = true;
+                    }
+                    else {
+                        undrawn_changes[frame].insert(undrawn_changes[frame].end(), batch.events.begin(), batch.events.end());
+                    }
+                }
+
+                if (batch.draw) {
+                    batch.frame = m_free_frames.pop();
+                    auto& frame = *m_frames[batch.frame];
+                    if (draws_whole[batch.frame] || !draws_changes) {
+                        graph->draw(frame);
+                    }
+                    else {
+                        for (auto& event : undrawn_changes[batch.frame]) {
+                            if (!graph->drawChange(frame, event)) {
+                                graph->draw(frame);
+                                break;
+                            }
+                        }
+                    }
+                    undrawn_changes[batch.frame].clear();
+                    draws_whole[batch.frame] = false;
+                }
+            }
+            catch (...) {
+                m_raster_error = std::current_exception();
+                m_failed = true;
+                // The frame is returned to the pool by the encoder thread, the only producer of the free frames
+                batch.skip_write = true;
+            }
+        }
+
+        // The batches are passed on even after a failure, so the encoder thread gets the last one
+        batch.snapshot.reset();
+        m_drawn_steps.push(std::move(batch));
+    }
+}
+
+void PipelinedGraphAlgorithmVisualizer::encode() {
+    for (bool last = false; !last;) {
+        auto batch = m_drawn_steps.pop();
+        last = batch.last;
+
+        if (!m_failed.load(std::memory_order_relaxed)) {
+            try {
+                std::size_t step_begin = 0;
+                for (auto step_end : batch.step_ends) {
+                    m_renderer->onStepEvents(std::span<const StepEvent>(batch.events).subspan(step_begin, step_end - step_begin));
+                    step_begin = step_end;
+                }
+                if (batch.frame != no_frame && !batch.skip_write) {
+                    m_renderer->writeFrame(*m_frames[batch.frame]);
+                }
+            }
+            catch (...) {
+                m_encoder_error = std::current_exception();
+                m_failed = true;
+            }
+        }
+
+        if (batch.frame != no_frame) {
+            m_free_frames.push(std::size_t(batch.frame));
+        }
+    }
+}
+
+void PipelinedGraphAlgorithmVisualizer::visualize() {
+    auto graph = m_algorithm->getState().clone();
+    for (std::size_t frame = 0; frame < frame_pool_size; ++frame) {
+        m_frames.push_back(m_renderer->createFrame());
+    }
+    if (!graph || !m_frames.front()) {
+        GraphAlgorithmVisualizer visualizer(std::move(m_algorithm), std::move(m_renderer), std::move(m_frame_policy));
+        visualizer.visualize();
+        return;
+    }
+
+    StepEventBuffer events;
+    bool reports_events = m_algorithm->setEventSink(&events);
+    for (std::size_t frame = 0; frame < m_frames.size(); ++frame) {
+        m_free_frames.push(std::size_t(frame));
+    }
+
+    std::thread raster_thread(&PipelinedGraphAlgorithmVisualizer::rasterize, this, std::move(graph), reports_events);
+    std::thread encoder_thread(&PipelinedGraphAlgorithmVisualizer::encode, this);
+
+    std::exception_ptr compute_error;
+    try {
+        compute(reports_events, events);
+    }
+    catch (...) {
+        compute_error = std::current_exception();
+    }
+    raster_thread.join();
+    encoder_thread.join();
+    m_algorithm->setEventSink(nullptr);
+
+    for (auto error : {compute_error, m_raster_error, m_encoder_error}) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    m_renderer->finalize();
+}
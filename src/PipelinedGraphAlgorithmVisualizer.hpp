@@ -0,0 +1,108 @@
+#ifndef PipelinedGraphAlgorithmVisualizer_hpp
+#define PipelinedGraphAlgorithmVisualizer_hpp
+
+#include "FramePolicy.hpp"
+#include "GraphAlgorithm.hpp"
+#include "Renderer.hpp"
+#include "SPSCQueue.hpp"
+#include "StepEvent.hpp"
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <vector>
+
+/**
+ * Class for visualizing the whole run of graph algorithm in three stages running on their own threads.
+ *
+ * The calling thread runs the algorithm, a raster thread draws the frames and an encoder thread writes
+ * them with the renderer, so the time of the run approaches the time of the slowest stage instead of
+ * the sum of all three. The stages are connected by bounded lock-free queues, a stage that gets ahead
+ * waits for the next one, so only a few steps and frames are in flight at once.
+ *
+ * The raster thread draws a copy of the graph (see Graph::clone()). If the algorithm reports its changes,
+ * only the changes are sent and applied to the copy, otherwise a copy of every drawn state is sent.
+ * The frames come from a small pool of separate frames of the renderer (see Renderer::createFrame()),
+ * each of them keeps its drawing, so only the changes since it was drawn last are drawn again.
+ * Algorithms with graphs that can't be copied and renderers without separate frames are visualized
+ * on one thread, like GraphAlgorithmVisualizer does.
+ */
+class PipelinedGraphAlgorithmVisualizer {
+    // Above this number of changes since a frame was drawn it is drawn whole
+    static constexpr std::size_t max_undrawn_changes = 1 << 16;
+    // Above this number of changes the undrawn steps are sent to the raster thread
+    static constexpr std::size_t max_batch_changes = 1 << 12;
+    // Number of batches of steps waiting for the raster thread
+    static constexpr std::size_t step_queue_capacity = 16;
+    // Number of frames being drawn or written at once
+    static constexpr std::size_t frame_pool_size = 4;
+    // Frame index of batches without a frame
+    static constexpr std::size_t no_frame = static_cast<std::size_t>(-1);
+
+    // Structure holding the steps passed from one stage to the next one
+    struct StepBatch {
+        std::vector<StepEvent> events; // Changes of the steps, if the algorithm reports them
+        std::vector<std::size_t> step_ends; // End of the changes of every step in events
+        std::unique_ptr<Graph> snapshot; // Copy of the state after the last step, if it is drawn without changes
+        bool draw = false; // True if the state after the last step is drawn
+        std::size_t frame = no_frame; // Index of the drawn frame in the pool, set by the raster thread
+        bool skip_write = false; // True if drawing the frame failed, the encoder only returns it to the pool
+        bool last = false; // True for the batch with the last step of the run
+    };
+
+    std::unique_ptr<GraphAlgorithm> m_algorithm;
+    std::unique_ptr<Renderer> m_renderer;
+    std::unique_ptr<FramePolicy> m_frame_policy;
+    std::vector<std::unique_ptr<Frame>> m_frames; // Pool of frames, each owned by one stage at a time
+    SPSCQueue<StepBatch> m_steps; // Steps of the algorithm waiting to be drawn
+    SPSCQueue<StepBatch> m_drawn_steps; // Drawn steps waiting to be written
+    SPSCQueue<std::size_t> m_free_frames; // Indices of the frames that were written and can be drawn again, pushed only by the encoder thread
+    std::atomic<bool> m_failed = false; // True once a stage has failed, the run is stopped
+    std::exception_ptr m_raster_error;
+    std::exception_ptr m_encoder_error;
+
+    /**
+     * Runs the algorithm and sends the steps to the raster thread.
+     *
+     * @param reports_events True if the algorithm reports its changes to the events buffer.
+     * @param events Buffer receiving the changes of the current step.
+     */
+    void compute(bool reports_events, StepEventBuffer& events);
+
+    /**
+     * Main loop of the raster thread, it draws the steps and passes them to the encoder thread.
+     *
+     * @param graph Copy of the graph before the first step, it follows the changes of the run.
+     * @param draws_changes True if the changes are sent, false if copies of the drawn states are.
+     */
+    void rasterize(std::unique_ptr<Graph> graph, bool draws_changes);
+
+    /**
+     * Main loop of the encoder thread, it writes the frames and passes the changes to the renderer.
+     */
+    void encode();
+
+public:
+    /**
+     * Constructor for PipelinedGraphAlgorithmVisualizer.
+     *
+     * @param algorithm A unique pointer to the graph algorithm to be visualized.
+     * @param renderer A unique pointer to the renderer used for visualization.
+     * @param frame_policy A unique pointer to the policy choosing the drawn steps, every step is drawn if null.
+     */
+    PipelinedGraphAlgorithmVisualizer(std::unique_ptr<GraphAlgorithm> algorithm, std::unique_ptr<Renderer> renderer,
+        std::unique_ptr<FramePolicy> frame_policy = nullptr);
+
+    /**
+     * Visualizes the entire run of the graph algorithm.
+     *
+     * Draws the same frames as GraphAlgorithmVisualizer::visualize(). While the stages run, the renderer
+     * is called only from the encoder thread, in the same order. Returns once all the frames are written
+     * and the renderer is finalized. Like GraphAlgorithmVisualizer it visualizes only one run.
+     *
+     * @throws Any exception thrown by the algorithm, the graph or the renderer, after all the threads are stopped.
+     */
+    void visualize();
+};
+
+#endif
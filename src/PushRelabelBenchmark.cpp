@@ -0,0 +1,136 @@
+#include "FlowGraph.hpp"
+#include "FlowGraphConfigLoader.hpp"
+#include "ParallelPushRelabelGraphAlgorithm.hpp"
+#include "PushRelabelGraphAlgorithm.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+
+// Benchmark comparing the sequential push-relabel with the parallel one on growing number of threads
+
+
+void printHelp(const std::string& command) {
+    std::cout << "Usage: " << command << " (FLOW_CONFIG_FILE | WIDTHxHEIGHT) [MAX_THREADS]" << std::endl;
+    std::cout << "Measure the run time of the sequential and the parallel push-relabel algorithm" << std::endl;
+    std::cout << "on the flow graph from FLOW_CONFIG_FILE or on a random WIDTHxHEIGHT grid flow network," << std::endl;
+    std::cout << "using 1, 2, 4, ... up to MAX_THREADS threads (number of hardware threads by default)." << std::endl;
+}
+
+/**
+ * Creates a random flow network on a grid with the start node in the top left corner and the end node
+ * in the bottom right corner. Every cell is connected to its right and bottom neighbour, some of them
+ * in both directions. The same size always gives the same network.
+ */
+FlowGraphConfig createGridFlowConfig(std::size_t width, std::size_t height) {
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<std::size_t> capacity(1, 100);
+    std::bernoulli_distribution backward(0.3);
+
+    FlowGraphConfig config{};
+    config.grid_width = width;
+    config.grid_height = height;
+    config.node_size = 10;
+    config.edge_length = 10;
+    config.edge_width = 10;
+    config.max_capacity = 100;
+    config.frame_delay = 1;
+
+    for (std::size_t y = 0; y < height; ++y) {
+        for (std::size_t x = 0; x < width; ++x) {
+            config.nodes.emplace_back(x, y);
+        }
+    }
+    for (std::size_t y = 0; y < height; ++y) {
+        for (std::size_t x = 0; x < width; ++x) {
+            auto node = y * width + x;
+            if (x + 1 < width) {
+                config.edges.push_back({{node, node + 1}, capacity(generator)});
+                if (backward(generator)) {
+                    config.edges.push_back({{node + 1, node}, capacity(generator)});
+                }
+            }
+            if (y + 1 < height) {
+                config.edges.push_back({{node, node + width}, capacity(generator)});
+                if (backward(generator)) {
+                    config.edges.push_back({{node + width, node}, capacity(generator)});
+                }
+            }
+        }
+    }
+    config.start_node = 0;
+    config.end_node = width * height - 1;
+    return config;
+}
+
+/**
+ * Runs the algorithm to the end and returns the found maximal flow and the run time in miliseconds.
+ */
+template <typename Algorithm>
+std::pair<std::size_t, double> measure(Algorithm& algorithm) {
+    auto start = std::chrono::steady_clock::now();
+    while (algorithm.nextStep()) {}
+    auto end = std::chrono::steady_clock::now();
+    return {algorithm.getMaxFlow(), std::chrono::duration<double, std::milli>(end - start).count()};
+}
+
+int main(int argc, const char *argv[]) {
+    if (argc < 2 || argc > 3 || std::string(argv[1]) == "--help") {
+        printHelp(argv[0]);
+        return (argc == 2) ? 0 : 1;
+    }
+
+    try {
+        FlowGraphConfig config;
+        std::string input = argv[1];
+        auto separator = input.find('x');
+        std::ifstream input_stream(input);
+
+        if (input_stream.good()) {
+            config = loadFlowGraphConfig(input_stream);
+        }
+        else if (separator != std::string::npos) {
+            config = createGridFlowConfig(std::stoul(input.substr(0, separator)), std::stoul(input.substr(separator + 1)));
+        }
+        else {
+            std::cout << "Error: Can not open file: \"" << input << "\"" << std::endl;
+            return 1;
+        }
+
+        std::size_t max_threads = (argc == 3)
+            ? std::stoul(argv[2])
+            : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+
+        auto topology = std::make_shared<const FlowGraphTopology>(config);
+        std::cout << "Nodes: " << topology->nodes.size() << ", edges: " << topology->edges.size() << std::endl;
+
+        PushRelabelGraphAlgorithm sequential{FlowGraph(topology)};
+        auto [expected_flow, sequential_time] = measure(sequential);
+        std::cout << "sequential: flow " << expected_flow << ", " << sequential_time << " ms" << std::endl;
+
+        bool all_equal = true;
+        for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+            // Snapshots are not needed, so the whole run is a single step
+            ParallelPushRelabelGraphAlgorithm parallel(FlowGraph(topology), threads, std::numeric_limits<std::size_t>::max());
+            auto [flow, time] = measure(parallel);
+            std::cout << threads << " thread(s): flow " << flow << ", " << time << " ms, speedup "
+                << sequential_time / time << std::endl;
+
+            if (flow != expected_flow) {
+                std::cout << "Error: Flow differs from the sequential algorithm" << std::endl;
+                all_equal = false;
+            }
+        }
+        return all_equal ? 0 : 1;
+    }
+    catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,267 @@
+#include "PushRelabelGraphAlgorithm.hpp"
+#include "FlowGraph.hpp"
+#include "FlowResidualGraph.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <queue>
+
+static constexpr std::size_t no_node = std::numeric_limits<std::size_t>::max();
+
+PushRelabelGraphAlgorithm::PushRelabelGraphAlgorithm(FlowGraph&& graph)
+    :   m_graph(std::move(graph)),
+        m_start_node(m_graph.start_node),
+        m_end_node(m_graph.end_node),
+        m_excess(m_graph.node_count, 0),
+        m_height(m_graph.node_count, 0),
+        m_current_arc(m_graph.node_count, 0),
+        m_active_buckets(2 * m_graph.node_count),
+        m_highest_active(0),
+        m_height_head(2 * m_graph.node_count, no_node),
+        m_next_in_height(m_graph.node_count, no_node),
+        m_previous_in_height(m_graph.node_count, no_node),
+        m_relabels_since_global(0),
+        m_initialized(false) {
+
+    // All nodes start with height 0
+    for (std::size_t node = 0; node < m_graph.node_count; ++node) {
+        m_next_in_height[node] = m_height_head[0];
+        if (m_height_head[0] != no_node) {
+            m_previous_in_height[m_height_head[0]] = node;
+        }
+        m_height_head[0] = node;
+    }
+    m_graph.max_node_level = m_graph.node_count;
+}
+
+void PushRelabelGraphAlgorithm::setHeight(std::size_t node, std::size_t height) {
+    // Unlink from the list of the old height
+    auto old_height = m_height[node];
+    if (m_previous_in_height[node] != no_node) {
+        m_next_in_height[m_previous_in_height[node]] = m_next_in_height[node];
+    }
+    else {
+        m_height_head[old_height] = m_next_in_height[node];
+    }
+    if (m_next_in_height[node] != no_node) {
+        m_previous_in_height[m_next_in_height[node]] = m_previous_in_height[node];
+    }
+
+    // Link to the list of the new height
+    m_previous_in_height[node] = no_node;
+    m_next_in_height[node] = m_height_head[height];
+    if (m_height_head[height] != no_node) {
+        m_previous_in_height[m_height_head[height]] = node;
+    }
+    m_height_head[height] = node;
+
+    m_height[node] = height;
+    m_graph.node_levels[node] = height;
+}
+
+void PushRelabelGraphAlgorithm::activate(std::size_t node) {
+    if (node == m_start_node || node == m_end_node || m_excess[node] == 0) {
+        return;
+    }
+    m_active_buckets[m_height[node]].push_back(node);
+    m_highest_active = std::max(m_highest_active, m_height[node]);
+}
+
+void PushRelabelGraphAlgorithm::globalRelabel() {
+    auto& topology = m_graph.getTopology();
+    auto node_count = m_graph.node_count;
+    std::vector<bool> visited(node_count, false);
+    std::queue<std::size_t> queue;
+
+    auto bfs = [&](std::size_t root, std::size_t base_height) {
+        setHeight(root, base_height);
+        queue.push(root);
+
+        while (!queue.empty()) {
+            auto current_node = queue.front();
+            queue.pop();
+
+            auto arc_count = getResidualArcCount(topology, current_node);
+            for (std::size_t i = 0; i < arc_count; ++i) {
+                auto arc = getResidualArc(topology, current_node, i);
+                auto neighbour = getArcHead(topology, arc);
+
+                // The opposite arc leads from the neighbour to the current node
+                if (!visited[neighbour] && getResidualCapacity(m_graph, arc ^ 1) > 0) {
+                    visited[neighbour] = true;
+                    setHeight(neighbour, std::min(m_height[current_node] + 1, 2 * node_count - 1));
+                    queue.push(neighbour);
+                }
+            }
+        }
+    };
+
+    // Distance to the end node, then distance to the start node above all of them.
+    // The start node always stays at the height of node count.
+    visited[m_end_node] = true;
+    visited[m_start_node] = true;
+    bfs(m_end_node, 0);
+    bfs(m_start_node, node_count);
+
+    // Nodes that can reach neither of them can't have any excess
+    for (std::size_t node = 0; node < node_count; ++node) {
+        if (!visited[node]) {
+            setHeight(node, 2 * node_count - 1);
+        }
+    }
+
+    for (auto& bucket : m_active_buckets) {
+        bucket.clear();
+    }
+    m_highest_active = 0;
+    for (std::size_t node = 0; node < node_count; ++node) {
+        m_current_arc[node] = 0;
+        activate(node);
+    }
+    m_relabels_since_global = 0;
+}
+
+void PushRelabelGraphAlgorithm::relabel(std::size_t node) {
+    auto& topology = m_graph.getTopology();
+    auto node_count = m_graph.node_count;
+    auto old_height = m_height[node];
+
+    auto new_height = 2 * node_count - 1;
+    auto arc_count = getResidualArcCount(topology, node);
+    for (std::size_t i = 0; i < arc_count; ++i) {
+        auto arc = getResidualArc(topology, node, i);
+        if (getResidualCapacity(m_graph, arc) > 0) {
+            new_height = std::min(new_height, m_height[getArcHead(topology, arc)] + 1);
+        }
+    }
+    setHeight(node, new_height);
+    m_current_arc[node] = 0;
+    m_relabels_since_global++;
+
+    // Gap heuristic, nodes above the empty height can't reach the end node anymore
+    if (old_height < node_count && m_height_head[old_height] == no_node) {
+        for (auto height = old_height + 1; height < node_count; ++height) {
+            while (m_height_head[height] != no_node) {
+                auto lifted_node = m_height_head[height];
+                setHeight(lifted_node, node_count);
+                m_current_arc[lifted_node] = 0;
+            }
+        }
+    }
+}
+
+void PushRelabelGraphAlgorithm::push(std::size_t node, std::size_t arc) {
+    auto& topology = m_graph.getTopology();
+    auto neighbour = getArcHead(topology, arc);
+    auto flow = std::min(m_excess[node], getResidualCapacity(m_graph, arc));
+
+    pushResidualFlow(m_graph, arc, flow);
+    m_excess[node] -= flow;
+    m_excess[neighbour] += flow;
+    if (m_excess[neighbour] == flow) {
+        activate(neighbour);
+    }
+
+    auto edge_index = arc / 2;
+    m_touched_edges.push_back(edge_index);
+    m_graph.edge_states[edge_index] = (m_graph.edge_flows[edge_index] == topology.edges[edge_index].capacity)
+        ? FlowEdgeState::Saturated
+        : FlowEdgeState::OnUnsaturatedPath;
+    showExcess(neighbour);
+}
+
+void PushRelabelGraphAlgorithm::discharge(std::size_t node) {
+    auto& topology = m_graph.getTopology();
+    auto arc_count = getResidualArcCount(topology, node);
+
+    while (m_excess[node] > 0) {
+        if (m_current_arc[node] == arc_count) {
+            relabel(node);
+            continue;
+        }
+
+        auto arc = getResidualArc(topology, node, m_current_arc[node]);
+        auto neighbour = getArcHead(topology, arc);
+        if (getResidualCapacity(m_graph, arc) > 0 && m_height[node] == m_height[neighbour] + 1) {
+            push(node, arc);
+        }
+        else {
+            m_current_arc[node]++;
+        }
+    }
+    showExcess(node);
+}
+
+void PushRelabelGraphAlgorithm::initializePreflow() {
+    auto& topology = m_graph.getTopology();
+
+    for (auto edge_index : topology.getOutgoingEdges(m_start_node)) {
+        auto capacity = topology.edges[edge_index].capacity;
+        auto to_node = topology.edges[edge_index].to_node_index;
+
+        m_graph.edge_flows[edge_index] = capacity;
+        m_excess[to_node] += capacity;
+        m_touched_edges.push_back(edge_index);
+        m_graph.edge_states[edge_index] = FlowEdgeState::Saturated;
+        showExcess(to_node);
+    }
+
+    globalRelabel();
+}
+
+void PushRelabelGraphAlgorithm::showExcess(std::size_t node) {
+    if (node == m_start_node || node == m_end_node) {
+        return;
+    }
+    m_graph.node_states[node] = (m_excess[node] > 0) ? FlowNodeState::HasExcess : FlowNodeState::Default;
+}
+
+bool PushRelabelGraphAlgorithm::nextStep() {
+    if (m_start_node == m_end_node) {
+        return false;
+    }
+
+    // Lets the renderer draw the initial preflow
+    if (!m_initialized) {
+        initializePreflow();
+        m_initialized = true;
+        return true;
+    }
+
+    // Show only flow changes of this step
+    auto& topology = m_graph.getTopology();
+    for (auto edge_index : m_touched_edges) {
+        m_graph.edge_states[edge_index] = (m_graph.edge_flows[edge_index] == topology.edges[edge_index].capacity)
+            ? FlowEdgeState::Saturated
+            : FlowEdgeState::Default;
+    }
+    m_touched_edges.clear();
+
+    // Find the highest active node, we are finished if there is none
+    while (m_active_buckets[m_highest_active].empty()) {
+        if (m_highest_active == 0) {
+            return false;
+        }
+        m_highest_active--;
+    }
+    auto node = m_active_buckets[m_highest_active].back();
+    m_active_buckets[m_highest_active].pop_back();
+
+    // The node may have been relabeled by the gap heuristic after it was activated
+    if (m_excess[node] > 0) {
+        discharge(node);
+    }
+
+    if (m_relabels_since_global >= m_graph.node_count) {
+        globalRelabel();
+    }
+    return true;
+}
+
+const Graph& PushRelabelGraphAlgorithm::getState() const {
+    return m_graph;
+}
+
+std::size_t PushRelabelGraphAlgorithm::getMaxFlow() const {
+    return m_excess[m_end_node];
+}
@@ -0,0 +1,118 @@
+#ifndef PushRelabelGraphAlgorithm_hpp
+#define PushRelabelGraphAlgorithm_hpp
+
+#include "FlowGraph.hpp"
+#include "GraphAlgorithm.hpp"
+#include <cstddef>
+#include <vector>
+
+/**
+ * Class for the push-relabel (preflow-push) algorithm in a flow graph.
+ *
+ * Active nodes are discharged in highest-label order. Heights are kept exact by periodic global
+ * relabeling (reverse BFS from the end node and then from the start node) and the gap heuristic
+ * lifts every node that can't reach the end node anymore above the start node at once.
+ */
+class PushRelabelGraphAlgorithm : public GraphAlgorithm {
+    FlowGraph m_graph;
+    std::size_t m_start_node; // Index of the start node
+    std::size_t m_end_node; // Index of the end node
+    std::vector<std::size_t> m_excess; // Excess of flow in each node
+    std::vector<std::size_t> m_height; // Height (label) of each node
+    std::vector<std::size_t> m_current_arc; // Index of the next residual arc to try from each node
+    std::vector<std::vector<std::size_t>> m_active_buckets; // Active nodes grouped by their height
+    std::size_t m_highest_active; // Upper bound of the height of the highest active node
+    std::vector<std::size_t> m_height_head; // First node of the list of nodes with given height
+    std::vector<std::size_t> m_next_in_height; // Next node in the list of nodes with the same height
+    std::vector<std::size_t> m_previous_in_height; // Previous node in the list of nodes with the same height
+    std::size_t m_relabels_since_global; // Number of relabels since the last global relabel
+    std::vector<std::size_t> m_touched_edges; // Edges whose flow changed in the last step
+    bool m_initialized;
+
+    /**
+     * Sets the height of the node and moves it to the list of nodes with that height.
+     *
+     * @param node Index of the node.
+     * @param height The new height of the node.
+     */
+    void setHeight(std::size_t node, std::size_t height);
+
+    /**
+     * Adds the node to the bucket of active nodes if it has an excess.
+     *
+     * @param node Index of the node.
+     */
+    void activate(std::size_t node);
+
+    /**
+     * Recomputes exact heights of all nodes by BFS over the reversed residual graph
+     * and rebuilds the buckets of active nodes.
+     */
+    void globalRelabel();
+
+    /**
+     * Lifts the node just above its lowest residual neighbour. If it was the last node
+     * with its old height, the gap heuristic lifts all nodes above the gap as well.
+     *
+     * @param node Index of the node.
+     */
+    void relabel(std::size_t node);
+
+    /**
+     * Pushes as much excess as possible from the node along the residual arc.
+     *
+     * @param node Index of the node.
+     * @param arc The encoded residual arc.
+     */
+    void push(std::size_t node, std::size_t arc);
+
+    /**
+     * Pushes and relabels the node until it has no excess.
+     *
+     * @param node Index of the node.
+     */
+    void discharge(std::size_t node);
+
+    /**
+     * Saturates all edges leaving the start node and computes the initial heights.
+     */
+    void initializePreflow();
+
+    /**
+     * Helper function to set the state of the node according to its excess.
+     */
+    void showExcess(std::size_t node);
+
+public:
+    /**
+     * Constructor for PushRelabelGraphAlgorithm.
+     *
+     * @param graph The flow graph in which the maximal flow is found.
+     */
+    PushRelabelGraphAlgorithm(FlowGraph&& graph);
+
+    /**
+     * Executes the next step of the push-relabel algorithm.
+     *
+     * The first step creates the initial preflow, every next step discharges the highest active node.
+     * Nodes with excess are highlighted and height of each node is shown as a bar inside it.
+     *
+     * @return True if there are more steps to be taken, false otherwise.
+     */
+    virtual bool nextStep() override;
+
+    /**
+     * Returns the current state of the graph.
+     *
+     * @return A constant reference to the current state of the graph.
+     */
+    virtual const Graph& getState() const override;
+
+    /**
+     * Returns the value of the flow that reached the end node so far,
+     * the maximal flow once the algorithm is finished.
+     */
+    std::size_t getMaxFlow() const;
+};
+
+#endif
@@ -0,0 +1,108 @@
+#ifndef RadixHeap_hpp
+#define RadixHeap_hpp
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * Class representing a monotone radix heap, a priority queue for integer keys that never drop
+ * below the last popped key (such as distances in Dijkstra's algorithm).
+ *
+ * An item is kept in the bucket given by the highest bit in which its key differs from the last popped key,
+ * so every item moves at most 64 times in total and all the buckets are plain contiguous arrays.
+ * There is no decrease-key, an improved key is just pushed again and the stale item is skipped by the caller.
+ */
+template <typename Value>
+class RadixHeap {
+    using Item = std::pair<std::uint64_t, Value>;
+
+    std::vector<Item> m_buckets[65]; // Bucket 0 holds items with the last popped key
+    std::uint64_t m_last_key; // Last popped key
+    std::size_t m_size;
+
+    // Helper function to find the bucket of the key
+    std::size_t getBucketIndex(std::uint64_t key) const {
+        return (key == m_last_key) ? 0 : 64 - std::countl_zero(key ^ m_last_key);
+    }
+
+public:
+    // Default constructor for RadixHeap
+    RadixHeap() : m_last_key(0), m_size(0) {}
+
+    /**
+     * Returns true if there are no items in the heap.
+     */
+    bool empty() const {
+        return m_size == 0;
+    }
+
+    /**
+     * Returns the number of items in the heap.
+     */
+    std::size_t size() const {
+        return m_size;
+    }
+
+    /**
+     * Inserts the value with the given key.
+     *
+     * @param key The key of the value, at least the last popped key.
+     * @param value The value to be inserted.
+     * @throws std::runtime_error if the key is lower than the last popped key.
+     */
+    void push(std::uint64_t key, Value value) {
+        if (key < m_last_key) {
+            throw std::runtime_error("Radix heap key lower than the last popped key");
+        }
+        m_buckets[getBucketIndex(key)].emplace_back(key, std::move(value));
+        m_size++;
+    }
+
+    /**
+     * Removes and returns an item with the lowest key. The heap must not be empty.
+     *
+     * @return A pair of the key and the value.
+     */
+    Item pop() {
+        if (m_buckets[0].empty()) {
+            // Items of the first non-empty bucket get redistributed around its minimal key
+            std::size_t i = 1;
+            while (m_buckets[i].empty()) {
+                ++i;
+            }
+
+            auto& bucket = m_buckets[i];
+            m_last_key = bucket.front().first;
+            for (auto& item : bucket) {
+                m_last_key = std::min(m_last_key, item.first);
+            }
+            for (auto& item : bucket) {
+                m_buckets[getBucketIndex(item.first)].push_back(std::move(item));
+            }
+            bucket.clear();
+        }
+
+        auto item = std::move(m_buckets[0].back());
+        m_buckets[0].pop_back();
+        m_size--;
+        return item;
+    }
+
+    /**
+     * Removes all items and resets the last popped key to 0.
+     */
+    void clear() {
+        for (auto& bucket : m_buckets) {
+            bucket.clear();
+        }
+        m_last_key = 0;
+        m_size = 0;
+    }
+};
+
+#endif
@@ -2,6 +2,9 @@
 #define Renderer_hpp
 
 #include "Frame.hpp"
+#include "StepEvent.hpp"
+#include <memory>
+#include <span>
 
 // Abstract base class representing a renderer for drawing on frames
 class Renderer {
@@ -24,6 +27,35 @@ public:
      */
     virtual void endDrawing() = 0;
 
+    /**
+     * Returns true if beginDrawing() returns the frame with the drawing of the previous frame
+     * still on it, so only the changes made by a step have to be drawn. False by default.
+     */
+    virtual bool keepsPreviousFrame() const { return false; }
+
+    /**
+     * Receives the changes made by a step, drawn or not, for renderers which record them.
+     * By default the changes are discarded.
+     *
+     * @param events The changes in the order they were made.
+     */
+    virtual void onStepEvents(std::span<const StepEvent> /*events*/) {};
+
+    /**
+     * Creates a frame not owned by the renderer, so the next frames can be drawn on other threads
+     * while the earlier ones are written by writeFrame(). By default renderers draw only on their own frame.
+     *
+     * @return The new frame, or nullptr if the renderer doesn't support separate frames.
+     */
+    virtual std::unique_ptr<Frame> createFrame() const { return nullptr; }
+
+    /**
+     * Writes the frame as the next frame of the animation, like endDrawing() writes the frame of the renderer.
+     *
+     * @param frame A frame created by createFrame() of this renderer.
+     */
+    virtual void writeFrame(const Frame& /*frame*/) {};
+
     /**
      * Finalizes the rendering process.
      *
@@ -0,0 +1,80 @@
+#ifndef SPSCQueue_hpp
+#define SPSCQueue_hpp
+
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+/**
+ * Bounded lock-free queue for exactly one producer thread and one consumer thread.
+ *
+ * Items live in a ring buffer and the two threads only share the counters of pushed and popped items,
+ * each written by one side. A full queue blocks the producer until the consumer pops an item, which is
+ * how a fast stage of a pipeline is held back by a slow one. Blocked threads sleep on the counters
+ * instead of spinning.
+ */
+template <typename T>
+class SPSCQueue {
+    std::vector<T> m_items; // Ring buffer, the item number i is stored at i % capacity
+    alignas(64) std::atomic<std::size_t> m_popped{0}; // Number of popped items, written only by the consumer
+    alignas(64) std::atomic<std::size_t> m_pushed{0}; // Number of pushed items, written only by the producer
+
+public:
+    /**
+     * Constructor for SPSCQueue.
+     *
+     * @param capacity Maximal number of items in the queue.
+     * @throws std::runtime_error if the capacity is 0.
+     */
+    SPSCQueue(std::size_t capacity)
+        :   m_items(capacity) {
+
+        if (capacity == 0) {
+            throw std::runtime_error("Capacity of a queue has to be at least 1");
+        }
+    }
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    /**
+     * Adds the item to the end of the queue, waits while the queue is full. Called only by the producer.
+     *
+     * @param item The item, it is moved into the queue.
+     */
+    void push(T&& item) {
+        auto pushed = m_pushed.load(std::memory_order_relaxed);
+        auto popped = m_popped.load(std::memory_order_acquire);
+        while (pushed - popped == m_items.size()) {
+            m_popped.wait(popped, std::memory_order_acquire);
+            popped = m_popped.load(std::memory_order_acquire);
+        }
+
+        m_items[pushed % m_items.size()] = std::move(item);
+        m_pushed.store(pushed + 1, std::memory_order_release);
+        m_pushed.notify_one();
+    }
+
+    /**
+     * Removes the item from the front of the queue, waits while the queue is empty. Called only by the consumer.
+     *
+     * @return The item.
+     */
+    T pop() {
+        auto popped = m_popped.load(std::memory_order_relaxed);
+        auto pushed = m_pushed.load(std::memory_order_acquire);
+        while (pushed == popped) {
+            m_pushed.wait(pushed, std::memory_order_acquire);
+            pushed = m_pushed.load(std::memory_order_acquire);
+        }
+
+        T item = std::move(m_items[popped % m_items.size()]);
+        m_popped.store(popped + 1, std::memory_order_release);
+        m_popped.notify_one();
+        return item;
+    }
+};
+
+#endif
@@ -0,0 +1,16 @@
+#include "ShortestPathAlgorithmSelector.hpp"
+#include "DialGraphAlgorithm.hpp"
+#include "DijkstraGraphAlgorithm.hpp"
+#include "ZeroOneBFSGraphAlgorithm.hpp"
+
+std::unique_ptr<GraphAlgorithm> createShortestPathAlgorithm(PathGraph&& graph) {
+    auto max_weight = graph.getTopology().max_edge_weight;
+
+    if (max_weight <= 1) {
+        return std::make_unique<ZeroOneBFSGraphAlgorithm>(std::move(graph));
+    }
+    if (max_weight <= max_bucket_queue_weight) {
+        return std::make_unique<DialGraphAlgorithm>(std::move(graph));
+    }
+    return std::make_unique<DijkstraGraphAlgorithm>(std::move(graph));
+}
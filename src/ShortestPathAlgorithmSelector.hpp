@@ -0,0 +1,23 @@
+#ifndef ShortestPathAlgorithmSelector_hpp
+#define ShortestPathAlgorithmSelector_hpp
+
+#include "GraphAlgorithm.hpp"
+#include "PathGraph.hpp"
+#include <cstddef>
+#include <memory>
+
+// Highest edge weight up to which Dial's bucket queue is used instead of the radix heap
+inline constexpr std::size_t max_bucket_queue_weight = 64;
+
+/**
+ * Creates the shortest path algorithm best suited for the range of edge weights of the graph.
+ *
+ * Graphs with weights 0 and 1 only are searched by 0-1 BFS, graphs with weights up to
+ * max_bucket_queue_weight by Dial's algorithm and all the others by Dijkstra's algorithm with a radix heap.
+ *
+ * @param graph The graph in which the shortest path is found.
+ * @return The created algorithm.
+ */
+std::unique_ptr<GraphAlgorithm> createShortestPathAlgorithm(PathGraph&& graph);
+
+#endif
@@ -0,0 +1,174 @@
+#include "DeltaSteppingGraphAlgorithm.hpp"
+#include "DialGraphAlgorithm.hpp"
+#include "DijkstraGraphAlgorithm.hpp"
+#include "PathGraph.hpp"
+#include "PathGraphConfigLoader.hpp"
+#include "ZeroOneBFSGraphAlgorithm.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+
+// Benchmark comparing sequential Dijkstra's algorithm with the bucket queue algorithms and with the parallel
+// delta-stepping on growing number of threads
+
+
+void printHelp(const std::string& command) {
+    std::cout << "Usage: " << command << " (PATH_CONFIG_FILE | WIDTHxHEIGHT[xMAX_WEIGHT]) [MAX_THREADS] [DELTA]" << std::endl;
+    std::cout << "Measure the run time of Dijkstra's algorithm, of Dial's algorithm (and 0-1 BFS for weights 0 and 1)" << std::endl;
+    std::cout << "and of the parallel delta-stepping algorithm on the path graph from PATH_CONFIG_FILE or on a random" << std::endl;
+    std::cout << "WIDTHxHEIGHT grid with weights 1 to MAX_WEIGHT (100 by default, 0 to 1 if MAX_WEIGHT is 1)," << std::endl;
+    std::cout << "using 1, 2, 4, ... up to MAX_THREADS threads (number of hardware threads by default)." << std::endl;
+    std::cout << "DELTA is the width of the buckets, chosen from the edge weights by default." << std::endl;
+}
+
+/**
+ * Creates a random weighted grid with the start node in the top left corner and the end node in the bottom
+ * right corner. Every cell is connected to all its neighbours by edges of weight 1 to max_weight,
+ * or 0 to 1 if max_weight is 1. The same size always gives the same graph.
+ */
+PathGraphConfig createGridPathConfig(std::size_t width, std::size_t height, std::size_t max_weight) {
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<std::size_t> weight(max_weight > 1 ? 1 : 0, max_weight);
+
+    PathGraphConfig config{};
+    config.grid_width = width;
+    config.grid_height = height;
+    config.node_size = 10;
+    config.edge_length = 10;
+    config.edge_width = 10;
+    config.frame_delay = 1;
+
+    for (std::size_t y = 0; y < height; ++y) {
+        for (std::size_t x = 0; x < width; ++x) {
+            config.nodes.emplace_back(x, y);
+        }
+    }
+    auto add_edges = [&](std::size_t first, std::size_t second) {
+        config.edges.push_back({first, second});
+        config.edge_weights.push_back(weight(generator));
+        config.edges.push_back({second, first});
+        config.edge_weights.push_back(weight(generator));
+    };
+    for (std::size_t y = 0; y < height; ++y) {
+        for (std::size_t x = 0; x < width; ++x) {
+            auto node = y * width + x;
+            if (x + 1 < width) {
+                add_edges(node, node + 1);
+            }
+            if (y + 1 < height) {
+                add_edges(node, node + width);
+            }
+        }
+    }
+    config.start_node = 0;
+    config.end_node = width * height - 1;
+    return config;
+}
+
+/**
+ * Runs the algorithm to the end and returns the run time in miliseconds.
+ */
+template <typename Algorithm>
+double measure(Algorithm& algorithm) {
+    auto start = std::chrono::steady_clock::now();
+    while (algorithm.nextStep()) {}
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+/**
+ * Returns true if the algorithm found the same distances as the reference one. Both algorithms stop
+ * at the end node, so only the nodes closer than it (and the end node) are settled by both.
+ */
+template <typename Algorithm>
+bool hasEqualDistances(const Algorithm& algorithm, const DijkstraGraphAlgorithm& reference,
+    const PathGraphTopology& topology) {
+
+    auto expected_distance = reference.getDistance(topology.end_node);
+    for (std::size_t node = 0; node < topology.node_count; ++node) {
+        auto distance = reference.getDistance(node);
+        if ((distance < expected_distance || node == topology.end_node)
+            && algorithm.getDistance(node) != distance) {
+            std::cout << "Error: Distance of node " << node << " differs from Dijkstra's algorithm" << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, const char *argv[]) {
+    if (argc < 2 || argc > 4 || std::string(argv[1]) == "--help") {
+        printHelp(argv[0]);
+        return (argc == 2) ? 0 : 1;
+    }
+
+    try {
+        PathGraphConfig config;
+        std::string input = argv[1];
+        auto separator = input.find('x');
+        auto weight_separator = (separator != std::string::npos) ? input.find('x', separator + 1) : std::string::npos;
+        std::ifstream input_stream(input);
+
+        if (input_stream.good()) {
+            config = loadPathGraphConfig(input_stream);
+        }
+        else if (separator != std::string::npos) {
+            auto max_weight = (weight_separator != std::string::npos) ? std::stoul(input.substr(weight_separator + 1)) : 100;
+            config = createGridPathConfig(std::stoul(input.substr(0, separator)),
+                std::stoul(input.substr(separator + 1, weight_separator - separator - 1)), max_weight);
+        }
+        else {
+            std::cout << "Error: Can not open file: \"" << input << "\"" << std::endl;
+            return 1;
+        }
+
+        std::size_t max_threads = (argc >= 3)
+            ? std::stoul(argv[2])
+            : std::max<std::size_t>(1, std::thread::hardware_concurrency());
+        std::uint64_t delta = (argc == 4) ? std::stoull(argv[3]) : 0;
+
+        auto topology = std::make_shared<const PathGraphTopology>(config);
+        std::cout << "Nodes: " << topology->node_count << ", edges: " << topology->edge_count << std::endl;
+
+        DijkstraGraphAlgorithm sequential{PathGraph(topology)};
+        auto sequential_time = measure(sequential);
+        auto expected_distance = sequential.getDistance(topology->end_node);
+        std::cout << "Dijkstra: distance " << expected_distance << ", " << sequential_time << " ms" << std::endl;
+
+        bool all_equal = true;
+        DialGraphAlgorithm dial{PathGraph(topology)};
+        auto dial_time = measure(dial);
+        std::cout << "Dial: distance " << dial.getDistance(topology->end_node) << ", " << dial_time
+            << " ms, speedup " << sequential_time / dial_time << std::endl;
+        all_equal = hasEqualDistances(dial, sequential, *topology) && all_equal;
+
+        if (topology->max_edge_weight <= 1) {
+            ZeroOneBFSGraphAlgorithm zero_one_bfs{PathGraph(topology)};
+            auto zero_one_bfs_time = measure(zero_one_bfs);
+            std::cout << "0-1 BFS: distance " << zero_one_bfs.getDistance(topology->end_node) << ", "
+                << zero_one_bfs_time << " ms, speedup " << sequential_time / zero_one_bfs_time << std::endl;
+            all_equal = hasEqualDistances(zero_one_bfs, sequential, *topology) && all_equal;
+        }
+
+        for (std::size_t threads = 1; threads <= max_threads; threads *= 2) {
+            DeltaSteppingGraphAlgorithm parallel(PathGraph(topology), threads, delta);
+            auto time = measure(parallel);
+            std::cout << threads << " thread(s), delta " << parallel.getDelta() << ": distance "
+                << parallel.getDistance(topology->end_node) << ", " << time << " ms, speedup "
+                << sequential_time / time << std::endl;
+            all_equal = hasEqualDistances(parallel, sequential, *topology) && all_equal;
+        }
+        return all_equal ? 0 : 1;
+    }
+    catch (const std::exception& e) {
+        std::cout << "Error: " << e.what() << std::endl;
+        return 1;
+    }
+}
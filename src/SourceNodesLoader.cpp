@@ -0,0 +1,28 @@
+#include "SourceNodesLoader.hpp"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+std::vector<std::size_t> loadSourceNodes(std::istream& input) {
+    std::vector<std::size_t> sources;
+    std::string line;
+
+    while (std::getline(input, line)) {
+        std::size_t start = line.find_first_not_of(" \t\n\r");
+        // Skip empty lines and comments
+        if (start == std::string::npos || line[start] == '#') {
+            continue;
+        }
+
+        std::istringstream iss(line);
+        std::size_t node;
+        while (iss >> node) {
+            sources.push_back(node);
+        }
+        if (!iss.eof()) {
+            throw std::runtime_error("Invalid format for source node index: " + line);
+        }
+    }
+    return sources;
+}
@@ -0,0 +1,19 @@
+#ifndef SourceNodesLoader_hpp
+#define SourceNodesLoader_hpp
+
+#include <cstddef>
+#include <istream>
+#include <vector>
+
+/**
+* Loads a list of source node indices from the provided input stream.
+*
+* Node indices are separated by white space, lines starting with '#' are comments.
+*
+* @param input The input stream containing the list.
+* @return The loaded node indices in the order of the list.
+* @throws std::runtime_error if an error occurs while reading the data.
+*/
+std::vector<std::size_t> loadSourceNodes(std::istream& input);
+
+#endif
@@ -0,0 +1,64 @@
+#ifndef StepEvent_hpp
+#define StepEvent_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Structure describing one change of a graph made by a step of an algorithm
+struct StepEvent {
+    enum class Type : std::uint8_t { NodeState, EdgeState, EdgeFlow };
+
+    Type type;
+    std::uint8_t state; // New state of the node or edge, the value of the state enum of the graph
+    std::size_t index; // Index of the changed node or edge
+    std::int64_t flow_change; // Change of the flow of the edge, used only by EdgeFlow
+
+    /**
+     * Returns the event of a node changing its state to the given one.
+     */
+    template <typename State>
+    static StepEvent nodeState(std::size_t node, State state) {
+        return {Type::NodeState, static_cast<std::uint8_t>(state), node, 0};
+    }
+
+    /**
+     * Returns the event of an edge changing its state to the given one.
+     */
+    template <typename State>
+    static StepEvent edgeState(std::size_t edge, State state) {
+        return {Type::EdgeState, static_cast<std::uint8_t>(state), edge, 0};
+    }
+
+    /**
+     * Returns the event of the flow of an edge changing by the given amount.
+     */
+    static StepEvent edgeFlow(std::size_t edge, std::int64_t flow_change) {
+        return {Type::EdgeFlow, 0, edge, flow_change};
+    }
+};
+
+// Abstract base class for receivers of the changes made by the steps of an algorithm
+class StepEventSink {
+public:
+    /**
+     * Receives one change made by the current step.
+     *
+     * @param event The change of the graph.
+     */
+    virtual void onStepEvent(const StepEvent& event) = 0;
+
+    virtual ~StepEventSink() {};
+};
+
+// Sink collecting the changes of one step until they are taken
+class StepEventBuffer : public StepEventSink {
+public:
+    std::vector<StepEvent> events; // Changes in the order they were made
+
+    virtual void onStepEvent(const StepEvent& event) override {
+        events.push_back(event);
+    }
+};
+
+#endif
@@ -0,0 +1,304 @@
+#include "StepTrace.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+
+// First bytes of every trace file
+static constexpr char trace_magic[] = {'G', 'A', 'V', 'T', 'R', 'A', 'C', 'E'};
+static constexpr std::uint64_t trace_version = 2;
+
+/**
+ * Appends the number as a variable-length integer, 7 bits per byte with the highest bit set on all but the last byte.
+ */
+static void appendNumber(std::string& buffer, std::uint64_t number) {
+    while (number >= 0x80) {
+        buffer.push_back(static_cast<char>((number & 0x7f) | 0x80));
+        number >>= 7;
+    }
+    buffer.push_back(static_cast<char>(number));
+}
+
+/**
+ * Maps signed numbers to unsigned ones so that numbers close to zero stay small (0, -1, 1, -2, ... to 0, 1, 2, 3, ...).
+ */
+static std::uint64_t encodeSigned(std::int64_t number) {
+    return (static_cast<std::uint64_t>(number) << 1) ^ static_cast<std::uint64_t>(number >> 63);
+}
+
+static std::int64_t decodeSigned(std::uint64_t number) {
+    return static_cast<std::int64_t>(number >> 1) ^ -static_cast<std::int64_t>(number & 1);
+}
+
+// Tags of the records following the header, the header of a step is shifted past them
+static constexpr std::uint64_t end_tag = 0;
+static constexpr std::uint64_t keyframe_tag = 1;
+static constexpr std::uint64_t first_step_tag = 2;
+// Size of the position of the index at the end of the trace
+static constexpr std::size_t index_position_size = 8;
+
+StepTraceWriter::StepTraceWriter(std::ostream& output, const std::string& algorithm_name, const Graph& initial_graph)
+    :   m_output(output) {
+
+    m_buffer.assign(trace_magic, sizeof(trace_magic));
+    appendNumber(m_buffer, trace_version);
+    appendNumber(m_buffer, algorithm_name.size());
+    m_buffer += algorithm_name;
+    writeBuffer();
+
+    if (!writeKeyframe(initial_graph)) {
+        throw std::runtime_error("State of the graph can't be saved in a trace");
+    }
+}
+
+void StepTraceWriter::encodeEvents(const std::vector<StepEvent>& events) {
+    std::size_t previous_index = 0;
+    for (auto& event : events) {
+        // Type takes the lowest two bits, the state of the node or edge the rest
+        appendNumber(m_buffer, (static_cast<std::uint64_t>(event.state) << 2) | static_cast<std::uint64_t>(event.type));
+        appendNumber(m_buffer, encodeSigned(static_cast<std::int64_t>(event.index - previous_index)));
+        if (event.type == StepEvent::Type::EdgeFlow) {
+            appendNumber(m_buffer, encodeSigned(event.flow_change));
+        }
+        previous_index = event.index;
+    }
+}
+
+void StepTraceWriter::writeBuffer() {
+    m_output.write(m_buffer.data(), m_buffer.size());
+    m_written += m_buffer.size();
+    m_buffer.clear();
+}
+
+bool StepTraceWriter::writeKeyframe(const Graph& graph) {
+    StepEventBuffer state;
+    if (!graph.describeState(state)) {
+        return false;
+    }
+
+    // The length of the keyframe comes first, so readers going from step to step can skip it
+    appendNumber(m_buffer, state.events.size());
+    encodeEvents(state.events);
+    std::string record;
+    appendNumber(record, keyframe_tag);
+    appendNumber(record, m_buffer.size());
+    m_buffer.insert(0, record);
+
+    m_keyframes.push_back({m_step_count, m_written});
+    m_keyframe_size = state.events.size();
+    m_changes_since_keyframe = 0;
+    writeBuffer();
+    return true;
+}
+
+void StepTraceWriter::onStepEvent(const StepEvent& event) {
+    m_step_events.push_back(event);
+}
+
+void StepTraceWriter::endStep(bool ends_phase, const Graph& graph) {
+    appendNumber(m_buffer, ((m_step_events.size() << 1) | (ends_phase ? 1 : 0)) + first_step_tag);
+    encodeEvents(m_step_events);
+    writeBuffer();
+    ++m_step_count;
+    m_changes_since_keyframe += m_step_events.size();
+    m_step_events.clear();
+
+    if (m_changes_since_keyframe >= std::max(min_keyframe_distance, m_keyframe_size) && !writeKeyframe(graph)) {
+        // The graph can't describe its state at the moment, it is tried again after as many changes
+        m_changes_since_keyframe = 0;
+    }
+}
+
+void StepTraceWriter::finish() {
+    appendNumber(m_buffer, end_tag);
+    writeBuffer();
+
+    // Index of the keyframes with the steps and positions stored as differences from the previous keyframe
+    auto index_position = m_written;
+    appendNumber(m_buffer, m_step_count);
+    appendNumber(m_buffer, m_keyframes.size());
+    StepTraceKeyframe previous{0, 0};
+    for (auto& keyframe : m_keyframes) {
+        appendNumber(m_buffer, keyframe.step - previous.step);
+        appendNumber(m_buffer, keyframe.offset - previous.offset);
+        previous = keyframe;
+    }
+    for (std::size_t i = 0; i < index_position_size; ++i) {
+        m_buffer.push_back(static_cast<char>((index_position >> (8 * i)) & 0xff));
+    }
+    writeBuffer();
+
+    m_output.flush();
+    if (!m_output.good()) {
+        throw std::runtime_error("Trace couldn't be written");
+    }
+}
+
+StepTraceReader::StepTraceReader(const std::string& file_name)
+    :   m_input(file_name, std::ios::binary) {
+
+    if (!m_input.good()) {
+        throw std::runtime_error("Can not open file: \"" + file_name + "\"");
+    }
+
+    for (auto expected : trace_magic) {
+        if (m_input.get() != expected) {
+            throw std::runtime_error("File \"" + file_name + "\" is not a trace");
+        }
+    }
+    if (readNumber() != trace_version) {
+        throw std::runtime_error("Unsupported version of trace \"" + file_name + "\"");
+    }
+
+    auto name_length = readNumber();
+    if (name_length > 256) {
+        throw std::runtime_error("Invalid format for trace: algorithm name");
+    }
+    for (std::uint64_t i = 0; i < name_length; ++i) {
+        m_algorithm_name.push_back(static_cast<char>(readByte()));
+    }
+
+    auto header_end = m_input.rdbuf()->pubseekoff(0, std::ios::cur);
+    auto file_size = m_input.rdbuf()->pubseekoff(0, std::ios::end);
+    if (header_end == std::streampos(-1) || file_size == std::streampos(-1)) {
+        throw std::runtime_error("Trace \"" + file_name + "\" can't be read");
+    }
+    readIndex(static_cast<std::uint64_t>(file_size));
+    if (m_keyframes.empty() || m_keyframes.front().step != 0
+        || m_keyframes.front().offset != static_cast<std::uint64_t>(header_end)) {
+        throw std::runtime_error("Invalid format for trace: missing initial state");
+    }
+    m_input.rdbuf()->pubseekpos(header_end);
+}
+
+std::uint8_t StepTraceReader::readByte() {
+    auto byte = m_input.rdbuf()->sbumpc();
+    if (byte == std::char_traits<char>::eof()) {
+        throw std::runtime_error("Invalid format for trace: unexpected end of file");
+    }
+    return static_cast<std::uint8_t>(byte);
+}
+
+std::uint64_t StepTraceReader::readNumber() {
+    std::uint64_t number = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+        auto byte = readByte();
+        number |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return number;
+        }
+    }
+    throw std::runtime_error("Invalid format for trace: number too long");
+}
+
+void StepTraceReader::readEvents(std::size_t count, std::vector<StepEvent>& events) {
+    events.clear();
+    std::size_t previous_index = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        auto tag = readNumber();
+        auto type = tag & 3;
+        auto state = tag >> 2;
+        if (type > static_cast<std::uint64_t>(StepEvent::Type::EdgeFlow) || state > 0xff) {
+            throw std::runtime_error("Invalid format for trace: change type");
+        }
+
+        StepEvent event{static_cast<StepEvent::Type>(type), static_cast<std::uint8_t>(state), 0, 0};
+        event.index = previous_index + static_cast<std::size_t>(decodeSigned(readNumber()));
+        if (event.type == StepEvent::Type::EdgeFlow) {
+            event.flow_change = decodeSigned(readNumber());
+        }
+        previous_index = event.index;
+        events.push_back(event);
+    }
+}
+
+void StepTraceReader::readIndex(std::uint64_t file_size) {
+    if (file_size < index_position_size) {
+        throw std::runtime_error("Invalid format for trace: unexpected end of file");
+    }
+    m_input.rdbuf()->pubseekpos(file_size - index_position_size);
+    std::uint64_t index_position = 0;
+    for (std::size_t i = 0; i < index_position_size; ++i) {
+        index_position |= static_cast<std::uint64_t>(readByte()) << (8 * i);
+    }
+    if (index_position >= file_size - index_position_size) {
+        throw std::runtime_error("Invalid format for trace: keyframe index");
+    }
+
+    m_input.rdbuf()->pubseekpos(index_position);
+    m_step_count = readNumber();
+    auto keyframe_count = readNumber();
+    // Every keyframe takes at least two bytes of the index
+    if (keyframe_count > file_size / 2) {
+        throw std::runtime_error("Invalid format for trace: keyframe index");
+    }
+    StepTraceKeyframe previous{0, 0};
+    for (std::uint64_t i = 0; i < keyframe_count; ++i) {
+        StepTraceKeyframe keyframe{previous.step + readNumber(), previous.offset + readNumber()};
+        if (keyframe.step > m_step_count || keyframe.offset >= index_position
+            || (i > 0 && (keyframe.offset <= previous.offset || keyframe.step < previous.step))) {
+            throw std::runtime_error("Invalid format for trace: keyframe index");
+        }
+        m_keyframes.push_back(keyframe);
+        previous = keyframe;
+    }
+}
+
+const std::string& StepTraceReader::getAlgorithmName() const {
+    return m_algorithm_name;
+}
+
+std::size_t StepTraceReader::getStepCount() const {
+    return m_step_count;
+}
+
+std::size_t StepTraceReader::seekStep(std::size_t step, std::vector<StepEvent>& state) {
+    // Last keyframe with at most the given number of steps before it, the first one is always at step 0
+    auto keyframe = std::upper_bound(m_keyframes.begin(), m_keyframes.end(), step,
+        [](std::size_t step, const StepTraceKeyframe& keyframe) { return step < keyframe.step; });
+    --keyframe;
+
+    m_input.rdbuf()->pubseekpos(keyframe->offset);
+    if (readNumber() != keyframe_tag) {
+        throw std::runtime_error("Invalid format for trace: keyframe index");
+    }
+    readNumber();
+    readEvents(readNumber(), state);
+    return keyframe->step;
+}
+
+bool StepTraceReader::readStep(std::vector<StepEvent>& events, bool& ends_phase) {
+    auto tag = readNumber();
+    while (tag == keyframe_tag) {
+        auto length = readNumber();
+        if (m_input.rdbuf()->pubseekoff(static_cast<std::streamoff>(length), std::ios::cur) == std::streampos(-1)) {
+            throw std::runtime_error("Invalid format for trace: unexpected end of file");
+        }
+        tag = readNumber();
+    }
+    if (tag == end_tag) {
+        return false;
+    }
+    ends_phase = ((tag - first_step_tag) & 1) != 0;
+    readEvents((tag - first_step_tag) >> 1, events);
+    return true;
+}
+
+std::size_t recordStepTrace(GraphAlgorithm& algorithm, std::ostream& output, const std::string& algorithm_name) {
+    // Nothing is written for algorithms which can't be recorded
+    StepEventBuffer initial_changes;
+    if (!algorithm.setEventSink(&initial_changes)) {
+        throw std::runtime_error("Algorithm doesn't report its changes, its run can't be recorded");
+    }
+    StepTraceWriter writer(output, algorithm_name, algorithm.getState());
+    algorithm.setEventSink(&writer);
+
+    std::size_t step_count = 0;
+    for (auto& graph : algorithm.steps()) {
+        writer.endStep(algorithm.endsPhase(), graph);
+        ++step_count;
+    }
+    algorithm.setEventSink(nullptr);
+    writer.finish();
+    return step_count;
+}
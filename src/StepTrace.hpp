@@ -0,0 +1,183 @@
+#ifndef StepTrace_hpp
+#define StepTrace_hpp
+
+#include "Graph.hpp"
+#include "GraphAlgorithm.hpp"
+#include "StepEvent.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Structure holding the position of one keyframe in a trace
+struct StepTraceKeyframe {
+    std::size_t step; // Number of steps before the keyframe
+    std::uint64_t offset; // Position of the keyframe record from the start of the trace
+};
+
+/**
+ * Class writing the run of an algorithm into a compact binary trace, which can be drawn later without the algorithm.
+ *
+ * The trace starts with a header holding the name of the algorithm. It is followed by records of the steps,
+ * each holding the changes made by the step, and by keyframes, each holding the whole state of the graph
+ * described as changes of the graph in the state it was created in (see Graph::describeState()).
+ * The first record is the keyframe of the initial state. The next keyframes are written once the steps
+ * since the previous one have made as many changes as the previous keyframe holds, so they take about
+ * as much space as the steps do and reaching any step takes at most that many changes after the nearest
+ * keyframe. The trace ends with an index of the keyframes and the position of the index in the last 8 bytes,
+ * so a reader can jump to any step (see StepTraceReader::seekStep()).
+ *
+ * Numbers are stored as variable-length integers and indices of the changed nodes and edges as differences
+ * from the previous change of the record, so changes of neighbouring nodes and edges usually take two or three bytes.
+ */
+class StepTraceWriter : public StepEventSink {
+    // Least number of changes between two keyframes
+    static constexpr std::size_t min_keyframe_distance = 1 << 12;
+
+    std::ostream& m_output;
+    std::vector<StepEvent> m_step_events; // Changes of the current step
+    std::string m_buffer; // Encoded record, written at once
+    std::uint64_t m_written = 0; // Number of bytes written so far
+    std::size_t m_step_count = 0;
+    std::vector<StepTraceKeyframe> m_keyframes;
+    std::size_t m_keyframe_size = 0; // Number of changes in the last keyframe
+    std::size_t m_changes_since_keyframe = 0;
+
+    /**
+     * Encodes the changes into the buffer, the number of changes is not included.
+     */
+    void encodeEvents(const std::vector<StepEvent>& events);
+
+    /**
+     * Writes the buffer to the output.
+     */
+    void writeBuffer();
+
+    /**
+     * Writes a keyframe with the state of the graph.
+     *
+     * @return False if the graph can't describe its state, nothing is written then.
+     */
+    bool writeKeyframe(const Graph& graph);
+
+public:
+    /**
+     * Constructor for StepTraceWriter. Writes the header of the trace and the keyframe of the initial state.
+     *
+     * @param output The stream the trace is written to, opened in binary mode.
+     * @param algorithm_name Name of the algorithm, it chooses the kind of graph when the trace is drawn.
+     * @param initial_graph The graph before the first step of the algorithm.
+     * @throws std::runtime_error if the graph can't describe its state.
+     */
+    StepTraceWriter(std::ostream& output, const std::string& algorithm_name, const Graph& initial_graph);
+
+    /**
+     * Receives one change made by the current step.
+     */
+    virtual void onStepEvent(const StepEvent& event) override;
+
+    /**
+     * Writes the changes received since the previous step as one step, followed by a keyframe if one is due.
+     *
+     * @param ends_phase True if the step finished a phase of the algorithm, see GraphAlgorithm::endsPhase().
+     * @param graph The graph after the step.
+     */
+    void endStep(bool ends_phase, const Graph& graph);
+
+    /**
+     * Writes the mark of the end of the trace and the index of the keyframes.
+     *
+     * @throws std::runtime_error if the trace couldn't be written.
+     */
+    void finish();
+};
+
+/**
+ * Class reading a trace written by StepTraceWriter from a file.
+ */
+class StepTraceReader {
+    std::ifstream m_input;
+    std::string m_algorithm_name;
+    std::size_t m_step_count = 0;
+    std::vector<StepTraceKeyframe> m_keyframes;
+
+    /**
+     * Reads the next byte of the trace.
+     *
+     * @throws std::runtime_error if the trace ends.
+     */
+    std::uint8_t readByte();
+
+    /**
+     * Reads a variable-length unsigned integer.
+     */
+    std::uint64_t readNumber();
+
+    /**
+     * Reads the given number of changes into the vector, replacing its content.
+     */
+    void readEvents(std::size_t count, std::vector<StepEvent>& events);
+
+    /**
+     * Reads the index of the keyframes from the end of the file.
+     *
+     * @param file_size Size of the trace file.
+     */
+    void readIndex(std::uint64_t file_size);
+
+public:
+    /**
+     * Constructor for StepTraceReader. Opens the file and reads the name of the algorithm and the index of the keyframes.
+     * The reader is at the initial state, see seekStep().
+     *
+     * @param file_name Path to the trace file.
+     * @throws std::runtime_error if the file can't be opened or it is not a trace.
+     */
+    StepTraceReader(const std::string& file_name);
+
+    /**
+     * Returns the name of the algorithm which was run.
+     */
+    const std::string& getAlgorithmName() const;
+
+    /**
+     * Returns the number of recorded steps.
+     */
+    std::size_t getStepCount() const;
+
+    /**
+     * Moves to the last keyframe before the given step and reads the state of the graph it holds.
+     * The next call of readStep() reads the step following the keyframe.
+     *
+     * @param step Number of the step, counted from 0.
+     * @param state Vector receiving the state as changes of the graph in the state it was created in.
+     * @return Number of the steps before the keyframe, the steps from this one to the given one have to be read.
+     * @throws std::runtime_error if the trace is broken.
+     */
+    std::size_t seekStep(std::size_t step, std::vector<StepEvent>& state);
+
+    /**
+     * Reads the changes of the next step, keyframes are skipped.
+     *
+     * @param events Vector receiving the changes.
+     * @param ends_phase Set to true if the step finished a phase of the algorithm.
+     * @return False if there are no more steps, true otherwise.
+     * @throws std::runtime_error if the trace is broken.
+     */
+    bool readStep(std::vector<StepEvent>& events, bool& ends_phase);
+};
+
+/**
+ * Runs the whole algorithm without drawing and writes its trace.
+ *
+ * @param algorithm The algorithm, it must not have been run yet.
+ * @param output The stream the trace is written to, opened in binary mode.
+ * @param algorithm_name Name of the algorithm saved in the trace.
+ * @return The number of steps including the initial state.
+ * @throws std::runtime_error if the algorithm doesn't report its changes or its graph can't describe its state.
+ */
+std::size_t recordStepTrace(GraphAlgorithm& algorithm, std::ostream& output, const std::string& algorithm_name);
+
+#endif
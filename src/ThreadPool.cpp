@@ -0,0 +1,76 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+ThreadPool::ThreadPool(std::size_t thread_count)
+    :   m_generation(0),
+        m_running(0),
+        m_stopping(false) {
+
+    if (thread_count == 0) {
+        thread_count = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+
+    for (std::size_t i = 1; i < thread_count; ++i) {
+        m_workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stopping = true;
+    }
+    m_job_ready.notify_all();
+
+    for (auto& worker : m_workers) {
+        worker.join();
+    }
+}
+
+std::size_t ThreadPool::size() const {
+    return m_workers.size() + 1;
+}
+
+void ThreadPool::workerLoop(std::size_t thread_index) {
+    std::size_t seen_generation = 0;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_job_ready.wait(lock, [&] { return m_stopping || m_generation != seen_generation; });
+            if (m_stopping) {
+                return;
+            }
+            seen_generation = m_generation;
+        }
+
+        m_job(thread_index);
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_running == 0) {
+            m_job_done.notify_one();
+        }
+    }
+}
+
+void ThreadPool::run(const std::function<void(std::size_t)>& job) {
+    if (m_workers.empty()) {
+        job(0);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = job;
+        m_running = m_workers.size();
+        m_generation++;
+    }
+    m_job_ready.notify_all();
+
+    // The calling thread takes part as the thread with index 0
+    job(0);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_job_done.wait(lock, [&] { return m_running == 0; });
+}
@@ -0,0 +1,59 @@
+#ifndef ThreadPool_hpp
+#define ThreadPool_hpp
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Class holding a fixed group of worker threads that run the same job together
+class ThreadPool {
+    std::vector<std::thread> m_workers;
+    std::function<void(std::size_t)> m_job; // Job of the current run, called with the index of the thread
+    std::mutex m_mutex;
+    std::condition_variable m_job_ready;
+    std::condition_variable m_job_done;
+    std::size_t m_generation; // Number of the current run, workers wait for it to change
+    std::size_t m_running; // Number of workers still running the current job
+    bool m_stopping;
+
+    /**
+     * Main loop of a worker thread.
+     *
+     * @param thread_index Index of the worker thread (the calling thread has index 0).
+     */
+    void workerLoop(std::size_t thread_index);
+
+public:
+    /**
+     * Constructor for ThreadPool.
+     *
+     * @param thread_count Number of threads running each job including the calling thread.
+     *                     Zero means one thread per hardware thread.
+     */
+    ThreadPool(std::size_t thread_count);
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Destructor for ThreadPool. Stops and joins all worker threads.
+     */
+    ~ThreadPool();
+
+    /**
+     * Returns the number of threads running each job including the calling thread.
+     */
+    std::size_t size() const;
+
+    /**
+     * Runs the job on all threads and waits until every thread has finished it.
+     *
+     * @param job Function called once on each thread with the index of the thread.
+     */
+    void run(const std::function<void(std::size_t)>& job);
+};
+
+#endif
@@ -0,0 +1,60 @@
+#include "TraceReplayGraphAlgorithm.hpp"
+
+#include <stdexcept>
+#include <string>
+
+TraceReplayGraphAlgorithm::TraceReplayGraphAlgorithm(const std::string& trace_file_name, std::unique_ptr<Graph> graph,
+    std::size_t first_step, std::size_t last_step)
+    :   m_reader(trace_file_name),
+        m_graph(std::move(graph)),
+        m_next_step(first_step),
+        m_last_step(last_step) {
+
+    if (first_step > last_step) {
+        throw std::runtime_error("First replayed step is after the last one");
+    }
+    if (first_step > 0 && first_step >= m_reader.getStepCount()) {
+        throw std::runtime_error("Trace has only " + std::to_string(m_reader.getStepCount()) + " steps");
+    }
+
+    // The steps between the keyframe and the first replayed step are applied without being replayed
+    auto step = m_reader.seekStep(first_step, m_step_events);
+    applyChanges(false);
+    for (bool ends_phase; step < first_step; ++step) {
+        if (!m_reader.readStep(m_step_events, ends_phase)) {
+            throw std::runtime_error("Invalid format for trace: missing steps");
+        }
+        applyChanges(false);
+    }
+}
+
+void TraceReplayGraphAlgorithm::applyChanges(bool reports_changes) {
+    for (auto& event : m_step_events) {
+        if (!m_graph->applyChange(event)) {
+            throw std::runtime_error("Trace doesn't fit the graph");
+        }
+        if (reports_changes && m_event_sink) {
+            m_event_sink->onStepEvent(event);
+        }
+    }
+}
+
+Generator<Graph> TraceReplayGraphAlgorithm::steps() {
+    for (; m_next_step <= m_last_step && m_reader.readStep(m_step_events, m_ends_phase); ++m_next_step) {
+        applyChanges(true);
+        co_yield *m_graph;
+    }
+}
+
+bool TraceReplayGraphAlgorithm::endsPhase() const {
+    return m_ends_phase;
+}
+
+bool TraceReplayGraphAlgorithm::setEventSink(StepEventSink* sink) {
+    m_event_sink = sink;
+    return true;
+}
+
+const Graph& TraceReplayGraphAlgorithm::getState() const {
+    return *m_graph;
+}
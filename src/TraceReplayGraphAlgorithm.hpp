@@ -0,0 +1,84 @@
+#ifndef TraceReplayGraphAlgorithm_hpp
+#define TraceReplayGraphAlgorithm_hpp
+
+#include "CoroutineGraphAlgorithm.hpp"
+#include "Graph.hpp"
+#include "StepTrace.hpp"
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * Class replaying a recorded run of an algorithm from a trace, see recordStepTrace().
+ *
+ * Every step applies the recorded changes to the graph instead of computing them, so a run can be drawn
+ * again with any renderer, size of the frames or colors without running the algorithm. The graph has to be
+ * created from a config with the same nodes and edges as the one the run was recorded on.
+ *
+ * Only a range of the recorded steps can be replayed. The replay then starts from the nearest keyframe
+ * of the trace before the first step of the range, so its cost doesn't grow with the steps before it.
+ */
+class TraceReplayGraphAlgorithm : public CoroutineGraphAlgorithm {
+public:
+    // Last step of the range which replays the steps to the end of the trace
+    static constexpr std::size_t end_of_trace = static_cast<std::size_t>(-1);
+
+private:
+    StepTraceReader m_reader;
+    std::unique_ptr<Graph> m_graph;
+    std::vector<StepEvent> m_step_events; // Changes of the current step
+    StepEventSink* m_event_sink = nullptr; // Receives the changes of the graph, if set
+    bool m_ends_phase = true; // True if the recorded step finished a phase
+    std::size_t m_next_step; // Number of the next replayed step
+    std::size_t m_last_step; // Number of the last replayed step
+
+    /**
+     * Applies the changes to the graph and reports them to the event sink.
+     *
+     * @throws std::runtime_error if a change doesn't fit the graph.
+     */
+    void applyChanges(bool reports_changes);
+
+public:
+    /**
+     * Constructor for TraceReplayGraphAlgorithm. Opens the trace and restores the state of the graph
+     * before the first replayed step.
+     *
+     * @param trace_file_name Path to the trace file.
+     * @param graph The graph in the state it was created in, with the same nodes and edges as the recorded one.
+     * @param first_step Number of the first replayed step, counted from 0.
+     * @param last_step Number of the last replayed step, the steps are replayed to the end of the trace by default.
+     * @throws std::runtime_error if the trace can't be read, doesn't fit the graph or the range is out of the trace.
+     */
+    TraceReplayGraphAlgorithm(const std::string& trace_file_name, std::unique_ptr<Graph> graph,
+        std::size_t first_step = 0, std::size_t last_step = end_of_trace);
+
+    /**
+     * Replays the recorded steps of the range.
+     *
+     * @return Generator of the graph after every step.
+     */
+    virtual Generator<Graph> steps() override;
+
+    /**
+     * Returns true if the recorded step finished a phase of the algorithm.
+     */
+    virtual bool endsPhase() const override;
+
+    /**
+     * Sets the sink receiving the recorded changes.
+     *
+     * @return Always true.
+     */
+    virtual bool setEventSink(StepEventSink* sink) override;
+
+    /**
+     * Returns the current state of the graph.
+     *
+     * @return A constant reference to the current state of the graph.
+     */
+    virtual const Graph& getState() const override;
+};
+
+#endif
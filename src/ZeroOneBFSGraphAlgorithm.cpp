@@ -0,0 +1,145 @@
+#include "ZeroOneBFSGraphAlgorithm.hpp"
+#include "PathGraph.hpp"
+
+#include <limits>
+#include <stdexcept>
+
+static constexpr std::uint64_t infinite_distance = std::numeric_limits<std::uint64_t>::max();
+
+ZeroOneBFSGraphAlgorithm::ZeroOneBFSGraphAlgorithm(PathGraph&& graph)
+    :   m_graph(std::move(graph)),
+        m_distance(m_graph.node_count, infinite_distance),
+        m_entered_by(m_graph.node_count),
+        m_first_step(true),
+        m_found_end(false) {
+
+    if (m_graph.getTopology().max_edge_weight > 1) {
+        throw std::runtime_error("0-1 BFS requires edge weights 0 and 1 only");
+    }
+}
+
+void ZeroOneBFSGraphAlgorithm::setNodeState(std::size_t node, PathNodeState state) {
+    m_graph.node_states[node] = state;
+    if (m_event_sink) {
+        m_event_sink->onStepEvent(StepEvent::nodeState(node, state));
+    }
+}
+
+void ZeroOneBFSGraphAlgorithm::setEdgeState(std::size_t edge, PathEdgeState state) {
+    m_graph.edge_states[edge] = state;
+    if (m_event_sink) {
+        m_event_sink->onStepEvent(StepEvent::edgeState(edge, state));
+    }
+}
+
+void ZeroOneBFSGraphAlgorithm::markShortestPath() {
+    auto& topology = m_graph.getTopology();
+    auto node_index = m_graph.end_node;
+
+    while (node_index != m_graph.start_node) {
+        auto edge_index = m_entered_by[node_index];
+        setEdgeState(edge_index, PathEdgeState::OnShortestPath);
+        node_index = topology.edges[edge_index].from_node_index;
+        if (node_index != m_graph.start_node) {
+            setNodeState(node_index, PathNodeState::OnShortestPath);
+        }
+    }
+}
+
+bool ZeroOneBFSGraphAlgorithm::isOutdated(const std::pair<std::uint64_t, std::size_t>& entry) const {
+    return entry.first != m_distance[entry.second] || m_graph.node_states[entry.second] == PathNodeState::Visited;
+}
+
+bool ZeroOneBFSGraphAlgorithm::nextStep() {
+    // Lets the renderer draw the initial state of graph
+    if (m_first_step) {
+        m_distance[m_graph.start_node] = 0;
+        m_deque.emplace_back(0, m_graph.start_node);
+        m_first_step = false;
+        return true;
+    }
+
+    if (m_found_end) {
+        return false;
+    }
+
+    while (!m_deque.empty() && isOutdated(m_deque.front())) {
+        m_deque.pop_front();
+    }
+    // We are finished
+    if (m_deque.empty()) {
+        return false;
+    }
+
+    auto& topology = m_graph.getTopology();
+    auto level = m_deque.front().first;
+
+    // Nodes reached over edges of weight 0 are pushed to the front, so they are settled in this step too
+    while (!m_deque.empty()) {
+        auto [distance, node_index] = m_deque.front();
+        if (isOutdated(m_deque.front())) {
+            m_deque.pop_front();
+            continue;
+        }
+        if (distance != level) {
+            break;
+        }
+        m_deque.pop_front();
+
+        setNodeState(node_index, PathNodeState::Visited);
+        if (node_index != m_graph.start_node) {
+            setEdgeState(m_entered_by[node_index], PathEdgeState::Used);
+        }
+
+        // We found the end node
+        if (node_index == m_graph.end_node) {
+            if (node_index == m_graph.start_node) {
+                setNodeState(node_index, PathNodeState::OnShortestPath);
+            }
+            markShortestPath();
+            m_found_end = true;
+            return true;
+        }
+
+        for (auto edge_index : topology.getOutgoingEdges(node_index)) {
+            auto neighbour_index = topology.edges[edge_index].to_node_index;
+            auto weight = topology.edge_weights[edge_index];
+            auto new_distance = distance + weight;
+
+            if (m_graph.node_states[neighbour_index] == PathNodeState::Visited || new_distance >= m_distance[neighbour_index]) {
+                continue;
+            }
+
+            // The neighbour was found before over a longer path
+            if (m_graph.node_states[neighbour_index] == PathNodeState::Found) {
+                setEdgeState(m_entered_by[neighbour_index], PathEdgeState::Default);
+            }
+            setEdgeState(edge_index, PathEdgeState::Peeked);
+            setNodeState(neighbour_index, PathNodeState::Found);
+            m_distance[neighbour_index] = new_distance;
+            m_entered_by[neighbour_index] = edge_index;
+
+            if (weight == 0) {
+                m_deque.emplace_front(new_distance, neighbour_index);
+            }
+            else {
+                m_deque.emplace_back(new_distance, neighbour_index);
+            }
+        }
+    }
+
+    return true;
+}
+
+bool ZeroOneBFSGraphAlgorithm::setEventSink(StepEventSink* sink) {
+    m_event_sink = sink;
+    return true;
+}
+
+const Graph& ZeroOneBFSGraphAlgorithm::getState() const {
+    return m_graph;
+}
+
+std::uint64_t ZeroOneBFSGraphAlgorithm::getDistance(std::size_t node) const {
+    return m_distance[node];
+}
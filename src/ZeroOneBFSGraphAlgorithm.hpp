@@ -0,0 +1,87 @@
+#ifndef ZeroOneBFSGraphAlgorithm_hpp
+#define ZeroOneBFSGraphAlgorithm_hpp
+
+#include "GraphAlgorithm.hpp"
+#include "PathGraph.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+/**
+ * Class for 0-1 BFS finding the shortest path in a graph with edge weights 0 and 1.
+ *
+ * Found nodes are kept in a deque instead of a heap, a node reached over an edge of weight 0 is pushed
+ * to the front and a node reached over an edge of weight 1 to the back. The deque then always holds
+ * nodes of at most two consecutive distances in order, so the whole search runs in O(V + E).
+ */
+class ZeroOneBFSGraphAlgorithm : public GraphAlgorithm {
+    PathGraph m_graph;
+    StepEventSink* m_event_sink = nullptr; // Receives the changes of the graph, if set
+    std::deque<std::pair<std::uint64_t, std::size_t>> m_deque; // Found nodes with the distance they were found with
+    std::vector<std::uint64_t> m_distance; // Tentative distance of each node from the start node
+    std::vector<std::size_t> m_entered_by; // Index of the edge each node was entered by
+    bool m_first_step;
+    bool m_found_end;
+
+    /**
+     * Backtracks from the end node and marks the nodes and edges on the shortest path.
+     */
+    void markShortestPath();
+
+    /**
+     * Returns true if the entry belongs to a settled node or the node was found again with a shorter distance.
+     */
+    bool isOutdated(const std::pair<std::uint64_t, std::size_t>& entry) const;
+
+    /**
+     * Changes the state of the node and reports it to the event sink.
+     */
+    void setNodeState(std::size_t node, PathNodeState state);
+
+    /**
+     * Changes the state of the edge and reports it to the event sink.
+     */
+    void setEdgeState(std::size_t edge, PathEdgeState state);
+
+public:
+    /**
+     * Constructor for ZeroOneBFSGraphAlgorithm.
+     *
+     * @param graph The graph in which the shortest path is found.
+     * @throws std::runtime_error if an edge has a weight other than 0 or 1.
+     */
+    ZeroOneBFSGraphAlgorithm(PathGraph&& graph);
+
+    /**
+     * Executes the next step of 0-1 BFS.
+     *
+     * Every step settles all the found nodes with the lowest distance, together with the nodes reached
+     * from them over edges of weight 0, and relaxes their outgoing edges.
+     *
+     * @return True if there are more steps to be taken, false otherwise.
+     */
+    virtual bool nextStep() override;
+
+    /**
+     * Sets the sink receiving the changes of the states of the nodes and edges.
+     *
+     * @return Always true.
+     */
+    virtual bool setEventSink(StepEventSink* sink) override;
+
+    /**
+     * Returns the current state of the graph.
+     *
+     * @return A constant reference to the current state of the graph.
+     */
+    virtual const Graph& getState() const override;
+
+    /**
+     * Returns the distance of the node from the start node, final for visited nodes.
+     */
+    std::uint64_t getDistance(std::size_t node) const;
+};
+
+#endif
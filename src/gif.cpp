@@ -706,7 +706,7 @@ bool GifWriteFrame(GifWriter* writer, const uint8_t* image, uint32_t width,
     const uint8_t* oldImage = writer->firstFrame ? NULL : writer->oldImage;
     writer->firstFrame = false;
 
-    GifPalette pal;
+    GifPalette pal{};
     GifMakePalette((dither ? NULL : oldImage), image, width, height, bitDepth,
                    dither, &pal);
 
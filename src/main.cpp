@@ -1,26 +1,96 @@
 
+#include "AStarGraphAlgorithm.hpp"
 #include "BFSGraphAlgorithm.hpp"
+#include "BidirectionalBFSGraphAlgorithm.hpp"
+#include "ContractionHierarchy.hpp"
+#include "ContractionHierarchyGraphAlgorithm.hpp"
+#include "DeltaSteppingGraphAlgorithm.hpp"
+#include "DialGraphAlgorithm.hpp"
+#include "DijkstraGraphAlgorithm.hpp"
+#include "DinicGraphAlgorithm.hpp"
 #include "FlowGraph.hpp"
 #include "FlowGraphConfigLoader.hpp"
 #include "FordFulkersonGraphAlgorithm.hpp"
+#include "FramePolicy.hpp"
 #include "GIFRenderer.hpp"
 #include "GraphAlgorithmVisualizer.hpp"
+#include "GridBFSGraphAlgorithm.hpp"
+#include "GridBitboardBFSGraphAlgorithm.hpp"
+#include "GridGraph.hpp"
+#include "HeadlessRunner.hpp"
+#include "JumpPointSearchGraphAlgorithm.hpp"
+#include "LifelongPlanningAStarGraphAlgorithm.hpp"
+#include "MultiSourceBFSGraphAlgorithm.hpp"
+#include "ParallelBFSGraphAlgorithm.hpp"
+#include "ParallelPushRelabelGraphAlgorithm.hpp"
+#include "PathEdgeChangesLoader.hpp"
 #include "PathGraph.hpp"
 #include "PathGraphConfigLoader.hpp"
+#include "PipelinedGraphAlgorithmVisualizer.hpp"
+#include "PushRelabelGraphAlgorithm.hpp"
+#include "ShortestPathAlgorithmSelector.hpp"
+#include "SourceNodesLoader.hpp"
+#include "StepTrace.hpp"
+#include "TraceReplayGraphAlgorithm.hpp"
+#include "ZeroOneBFSGraphAlgorithm.hpp"
 #include <cstddef>
+#include <cstdint>
 #include <iostream>
 #include <fstream>
+#include <functional>
+#include <map>
 #include <memory>
+#include <set>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
 
 void printHelp(const std::string& command) {
-    std::cout << "Usage: " << command << " ALGORITHM GRAPH_CONFIG_FILE OUTPUT_FILE" << std::endl;
+    std::cout << "Usage: " << command << " ALGORITHM GRAPH_CONFIG_FILE [OUTPUT_FILE] [--threads N] [--delta N] [--changes FILE] [--sources FILE] [--pipelined] [--every N | --per-phase | --frames N | --headless | --record-trace FILE]" << std::endl;
+    std::cout << "       " << command << " render-trace TRACE_FILE GRAPH_CONFIG_FILE [OUTPUT_FILE] [--from K] [--to M] [--pipelined] [--every N | --per-phase | --frames N | --headless]" << std::endl;
     std::cout << "Visualize a run of given ALGORITHM on a (grid) graph defined in a GRAPH_CONFIG_FILE and save it to OUTPUT_FILE." << std::endl;
+    std::cout << "The render-trace command visualizes the run recorded in TRACE_FILE without running the algorithm again," << std::endl;
+    std::cout << "GRAPH_CONFIG_FILE has to have the same nodes and edges as the recorded one, the sizes and colors can differ." << std::endl;
     std::cout << std::endl;
     std::cout << "Only supported ALGORITHMs are:" << std::endl;
     std::cout << "  BFS (Breadth-First-Search) shortest path finding algorithm" << std::endl;
+    std::cout << "  BFS-BIDIRECTIONAL (Breadth-First-Search from both ends) shortest path finding algorithm" << std::endl;
+    std::cout << "  BFS-PARALLEL (direction-optimizing parallel Breadth-First-Search) shortest path finding algorithm for big graphs" << std::endl;
+    std::cout << "  MS-BFS (bit-parallel multi-source Breadth-First-Search) shortest path finding algorithm for many sources at once" << std::endl;
+    std::cout << "  BFS-GRID (Breadth-First-Search on implicit grid graph) shortest path finding algorithm for big grids" << std::endl;
+    std::cout << "  BFS-BITBOARD (Breadth-First-Search on bitboards of implicit grid graph) shortest path finding algorithm for big grids" << std::endl;
+    std::cout << "  DIJKSTRA (Dijkstra's algorithm with radix heap) shortest path finding algorithm for weighted edges" << std::endl;
+    std::cout << "  01-BFS (0-1 BFS with deque) shortest path finding algorithm for edge weights 0 and 1" << std::endl;
+    std::cout << "  DIAL (Dial's algorithm with bucket queue) shortest path finding algorithm for small integer weights" << std::endl;
+    std::cout << "  SHORTEST-PATH (01-BFS, DIAL or DIJKSTRA chosen from the edge weights) shortest path finding algorithm" << std::endl;
+    std::cout << "  DELTA-STEPPING (parallel delta-stepping) shortest path finding algorithm for big weighted graphs" << std::endl;
+    std::cout << "  ASTAR (A* with grid distance heuristic) shortest path finding algorithm for weighted edges" << std::endl;
+    std::cout << "  JPS (Jump Point Search) shortest path finding algorithm for uniform 4-connected grids" << std::endl;
+    std::cout << "  CH (Contraction Hierarchy) shortest path finding algorithm for repeated queries on one graph" << std::endl;
+    std::cout << "  LPASTAR (Lifelong Planning A*) shortest path finding algorithm repairing the path when edges change" << std::endl;
     std::cout << "  FF-BFS (Ford-Fulkerson with BFS) maximal flow finding algorithm" << std::endl;
+    std::cout << "  FF-SCALING (Ford-Fulkerson with capacity scaling) maximal flow finding algorithm" << std::endl;
+    std::cout << "  DINIC (Dinic's blocking flow) maximal flow finding algorithm" << std::endl;
+    std::cout << "  PUSH-RELABEL (highest-label push-relabel) maximal flow finding algorithm" << std::endl;
+    std::cout << "  PUSH-RELABEL-PARALLEL (multi-threaded lock-free push-relabel) maximal flow finding algorithm" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  --threads N  number of threads used by parallel algorithms (default: number of hardware threads)" << std::endl;
+    std::cout << "  --delta N  width of the buckets used by DELTA-STEPPING (default: chosen from the edge weights)" << std::endl;
+    std::cout << "  --changes FILE  script of edge insertions and deletions used by LPASTAR, lines \"STEP ADD|REMOVE FROM_NODE_INDEX TO_NODE_INDEX\"," << std::endl;
+    std::cout << "      changed edges have to be in [EDGES] (the first of parallel edges is changed), an edge first changed by ADD is missing until then" << std::endl;
+    std::cout << "  --sources FILE  indices of the nodes searched by MS-BFS together with the start node" << std::endl;
+    std::cout << "  --pipelined  run the algorithm, draw the frames and write them on three threads at once" << std::endl;
+    std::cout << "  --every N  draw only the initial state and every N-th step" << std::endl;
+    std::cout << "  --per-phase  draw one frame per phase of the algorithm, like a BFS level or a Ford-Fulkerson augmentation" << std::endl;
+    std::cout << "  --frames N  draw N frames spread evenly over the run, the algorithm is run once more to count the steps" << std::endl;
+    std::cout << "  The steps in between are not drawn, the final state is always drawn." << std::endl;
+    std::cout << "  --headless  run the algorithm without drawing and print its result, the number of steps and the run time" << std::endl;
+    std::cout << "  --record-trace FILE  run the algorithm without drawing and record its steps to FILE for render-trace (only BFS, DIJKSTRA, 01-BFS, DIAL, SHORTEST-PATH, ASTAR, FF-BFS, FF-SCALING and DINIC)" << std::endl;
+    std::cout << "  OUTPUT_FILE is mandatory unless --headless or --record-trace is used." << std::endl;
+    std::cout << "  --from K  render-trace starts with the step K (counted from 0), from the nearest keyframe of the trace" << std::endl;
+    std::cout << "  --to M  render-trace ends with the step M" << std::endl;
     std::cout << std::endl;
     std::cout << "Only supported output format is .gif" << std::endl;
 }
@@ -29,13 +99,161 @@ std::size_t getFrameDimension(std::size_t node_size, std::size_t edge_length, st
     return node_size * (dimension + 2) + edge_length * (dimension - 1);
 }
 
+// Structure holding the options choosing which steps of the run are drawn, or how it is run without drawing
+struct FrameOptions {
+    std::size_t step_interval = 0; // Number of steps per frame, 0 if not set
+    bool per_phase = false; // True to draw one frame per phase of the algorithm
+    std::size_t frame_count = 0; // Number of frames spread over the run, 0 if not set
+    bool headless = false; // True to draw nothing and print the result of the run instead
+    bool pipelined = false; // True to run the algorithm, draw and write the frames on separate threads
+    std::string trace_file_name; // File the steps are recorded to instead of drawing them, empty if not set
+    std::string algorithm_name; // Name of the algorithm saved in the recorded trace
+};
+
+/**
+ * Visualizes a run of the algorithm and saves it to the GIF file.
+ * In the headless mode the algorithm is only run and its result, number of steps and run time are printed.
+ * If the trace file is set, the algorithm is only run and its steps are recorded to the file.
+ *
+ * @param create_algorithm Function creating the algorithm. With a fixed number of frames it is called twice,
+ *     the first run just counts the steps.
+ * @param output_file_name Path to the GIF file.
+ * @param delay The delay between frames in hundredths of a second.
+ * @param frame_width The width of each frame.
+ * @param frame_height The height of each frame.
+ * @param frame_options The options choosing which steps are drawn.
+ */
+void visualize(const std::function<std::unique_ptr<GraphAlgorithm>()>& create_algorithm,
+    const std::string& output_file_name, std::size_t delay, std::size_t frame_width, std::size_t frame_height,
+    const FrameOptions& frame_options) {
+
+    if (!frame_options.trace_file_name.empty()) {
+        // Checked before the file is created, so no empty trace is left behind
+        auto algorithm = create_algorithm();
+        if (!algorithm->setEventSink(nullptr)) {
+            throw std::runtime_error(frame_options.algorithm_name + " doesn't report the changes of its steps, its run can't be recorded");
+        }
+        std::ofstream trace_stream(frame_options.trace_file_name, std::ios::binary);
+        if (!trace_stream.good()) {
+            throw std::runtime_error("Can not write file: \"" + frame_options.trace_file_name + "\"");
+        }
+        auto step_count = recordStepTrace(*algorithm, trace_stream, frame_options.algorithm_name);
+        std::cout << "Steps: " << step_count << std::endl;
+        return;
+    }
+    if (frame_options.headless) {
+        auto algorithm = create_algorithm();
+        auto report = runHeadless(*algorithm);
+        algorithm->getState().printResult(std::cout);
+        std::cout << "Steps: " << report.step_count << std::endl;
+        std::cout << "Time: " << report.wall_time << " ms" << std::endl;
+        return;
+    }
+
+    std::unique_ptr<FramePolicy> frame_policy;
+    if (frame_options.step_interval != 0) {
+        frame_policy = std::make_unique<StepIntervalFramePolicy>(frame_options.step_interval);
+    }
+    if (frame_options.per_phase) {
+        frame_policy = std::make_unique<PhaseFramePolicy>();
+    }
+    if (frame_options.frame_count != 0) {
+        auto step_count = create_algorithm()->run();
+        frame_policy = std::make_unique<FrameCountFramePolicy>(frame_options.frame_count, step_count);
+    }
+
+    auto renderer_ptr = std::make_unique<GIFRenderer>(output_file_name, delay, frame_width, frame_height);
+    if (frame_options.pipelined) {
+        PipelinedGraphAlgorithmVisualizer visualizer(create_algorithm(), std::move(renderer_ptr), std::move(frame_policy));
+        visualizer.visualize();
+        return;
+    }
+    GraphAlgorithmVisualizer visualizer(create_algorithm(), std::move(renderer_ptr), std::move(frame_policy));
+    visualizer.visualize();
+}
+
+// Functions creating an algorithm on a new state of the graph, one type for every kind of graph
+using PathAlgorithmFactory = std::function<std::unique_ptr<GraphAlgorithm>(PathGraph&& graph)>;
+using FlowAlgorithmFactory = std::function<std::unique_ptr<GraphAlgorithm>(FlowGraph&& graph)>;
+using GridAlgorithmFactory = std::function<std::unique_ptr<GraphAlgorithm>(GridGraph&& graph)>;
+
+/**
+ * Loads the path graph config and visualizes a run of the algorithm on the graph.
+ *
+ * @param config_input The stream with the path graph config.
+ * @param create_algorithm Function creating the algorithm on a new state of the graph.
+ * @param output_file_name Path to the GIF file.
+ * @param frame_options The options choosing which steps are drawn.
+ */
+void visualizePath(std::istream& config_input, const PathAlgorithmFactory& create_algorithm,
+    const std::string& output_file_name, const FrameOptions& frame_options) {
+
+    auto config = loadPathGraphConfig(config_input);
+    auto frame_width = getFrameDimension(config.node_size, config.edge_length, config.grid_width);
+    auto frame_height = getFrameDimension(config.node_size, config.edge_length, config.grid_height);
+    auto topology = std::make_shared<const PathGraphTopology>(config);
+
+    visualize([&]() { return create_algorithm(PathGraph(topology)); },
+        output_file_name, config.frame_delay, frame_width, frame_height, frame_options);
+}
+
+/**
+ * Loads the flow graph config and visualizes a run of the algorithm on the graph.
+ *
+ * @param config_input The stream with the flow graph config.
+ * @param create_algorithm Function creating the algorithm on a new state of the graph.
+ * @param output_file_name Path to the GIF file.
+ * @param frame_options The options choosing which steps are drawn.
+ */
+void visualizeFlow(std::istream& config_input, const FlowAlgorithmFactory& create_algorithm,
+    const std::string& output_file_name, const FrameOptions& frame_options) {
+
+    auto config = loadFlowGraphConfig(config_input);
+    auto frame_width = getFrameDimension(config.node_size, config.edge_length, config.grid_width);
+    auto frame_height = getFrameDimension(config.node_size, config.edge_length, config.grid_height);
+    auto topology = std::make_shared<const FlowGraphTopology>(config);
+
+    visualize([&]() { return create_algorithm(FlowGraph(topology)); },
+        output_file_name, config.frame_delay, frame_width, frame_height, frame_options);
+}
+
+/**
+ * Builds the grid graph from the path graph config and visualizes a run of the algorithm on it.
+ * The grid is built straight from the stream, the node and edge lists would take most of the memory.
+ *
+ * @param config_input The stream with the path graph config.
+ * @param create_algorithm Function creating the algorithm on a new state of the graph.
+ * @param output_file_name Path to the GIF file.
+ * @param frame_options The options choosing which steps are drawn.
+ */
+void visualizeGrid(std::istream& config_input, const GridAlgorithmFactory& create_algorithm,
+    const std::string& output_file_name, const FrameOptions& frame_options) {
+
+    auto topology = std::make_shared<const GridGraphTopology>(config_input);
+    auto frame_width = getFrameDimension(topology->node_size, topology->edge_length, topology->width);
+    auto frame_height = getFrameDimension(topology->node_size, topology->edge_length, topology->height);
+
+    visualize([&]() { return create_algorithm(GridGraph(topology)); },
+        output_file_name, topology->frame_delay, frame_width, frame_height, frame_options);
+}
+
 int main(int argc, const char *argv[]) {
+    // The trace file of render-trace comes before the usual arguments, it is taken out of them
+    std::vector<const char*> args(argv, argv + argc);
+    std::string trace_file_name;
+    if (argc >= 3 && std::string(argv[1]) == "render-trace") {
+        trace_file_name = argv[2];
+        args.erase(args.begin() + 2);
+        argc = static_cast<int>(args.size());
+        argv = args.data();
+    }
+
     if (argc == 2 && std::string(argv[1]) == "--help") {
         printHelp(argv[0]);
         return 0;
     }
 
-    if (argc < 3) {
+    if (argc < 4) {
 		std::cout << "Error: Missing mandatory parameters" << std::endl;
         std::cout << std::endl;
         printHelp(argv[0]);
@@ -43,7 +261,9 @@ int main(int argc, const char *argv[]) {
 	}
     std::string alg_name = argv[1];
 	std::ifstream input_stream(argv[2]);
-    std::string output_file_name = argv[3];
+    // The output file can be left out in the headless mode, then the options start right after the config file
+    bool has_output_file = std::string(argv[3]).rfind("--", 0) != 0;
+    std::string output_file_name = has_output_file ? argv[3] : "";
 
 	if (!input_stream.good()) {
 		std::cout << "Error: Can not open file: \"" << argv[2] << "\"" << std::endl;
@@ -51,32 +271,190 @@ int main(int argc, const char *argv[]) {
 	}
 
     try {
-        if (alg_name == "FF-BFS") {
-            auto config = loadFlowGraphConfig(input_stream);
-            auto frame_width = getFrameDimension(config.node_size, config.edge_length, config.grid_width);
-            auto frame_height = getFrameDimension(config.node_size, config.edge_length, config.grid_height);
-            auto delay = config.frame_delay;
-            FlowGraph graph(config);
-
-            auto renderer_ptr = std::make_unique<GIFRenderer>(output_file_name, delay, frame_width, frame_height);
-            auto algo_ptr = std::make_unique<FordFulkersonGraphAlgorithm>(std::move(graph));
-
-            GraphAlgorithmVisualizer visualizer(std::move(algo_ptr), std::move(renderer_ptr));
-            visualizer.visualize();
+        std::size_t thread_count = 0;
+        std::uint64_t delta = 0;
+        std::string changes_file_name;
+        std::string sources_file_name;
+        FrameOptions frame_options;
+        std::size_t frame_option_count = 0;
+        std::size_t first_step = 0;
+        std::size_t last_step = TraceReplayGraphAlgorithm::end_of_trace;
+        bool has_step_range = false;
+        for (int i = has_output_file ? 4 : 3; i < argc; ++i) {
+            std::string option = argv[i];
+            if (option == "--threads" && i + 1 < argc) {
+                thread_count = std::stoul(argv[++i]);
+                continue;
+            }
+            if (option == "--delta" && i + 1 < argc) {
+                delta = std::stoull(argv[++i]);
+                continue;
+            }
+            if (option == "--changes" && i + 1 < argc) {
+                changes_file_name = argv[++i];
+                continue;
+            }
+            if (option == "--sources" && i + 1 < argc) {
+                sources_file_name = argv[++i];
+                continue;
+            }
+            if (option == "--every" && i + 1 < argc) {
+                frame_options.step_interval = std::stoul(argv[++i]);
+                if (frame_options.step_interval == 0) {
+                    std::cout << "Error: Number of steps per frame has to be at least 1" << std::endl;
+                    return 1;
+                }
+                ++frame_option_count;
+                continue;
+            }
+            if (option == "--per-phase") {
+                frame_options.per_phase = true;
+                ++frame_option_count;
+                continue;
+            }
+            if (option == "--frames" && i + 1 < argc) {
+                frame_options.frame_count = std::stoul(argv[++i]);
+                if (frame_options.frame_count == 0) {
+                    std::cout << "Error: Number of frames has to be at least 1" << std::endl;
+                    return 1;
+                }
+                ++frame_option_count;
+                continue;
+            }
+            if (option == "--pipelined") {
+                frame_options.pipelined = true;
+                continue;
+            }
+            if (option == "--record-trace" && i + 1 < argc) {
+                frame_options.trace_file_name = argv[++i];
+                ++frame_option_count;
+                continue;
+            }
+            if (option == "--from" && i + 1 < argc) {
+                first_step = std::stoul(argv[++i]);
+                has_step_range = true;
+                continue;
+            }
+            if (option == "--to" && i + 1 < argc) {
+                last_step = std::stoul(argv[++i]);
+                has_step_range = true;
+                continue;
+            }
+            if (option == "--headless") {
+                frame_options.headless = true;
+                ++frame_option_count;
+                continue;
+            }
+            std::cout << "Error: Unknown option \"" << option << "\"" << std::endl;
+            return 1;
+        }
+        if (frame_option_count > 1) {
+            std::cout << "Error: Only one of --every, --per-phase, --frames, --headless and --record-trace can be used" << std::endl;
+            return 1;
+        }
+        if (!has_output_file && !frame_options.headless && frame_options.trace_file_name.empty()) {
+            std::cout << "Error: Missing mandatory parameters" << std::endl;
+            std::cout << std::endl;
+            printHelp(argv[0]);
+            return 1;
+        }
+        if (has_step_range && alg_name != "render-trace") {
+            std::cout << "Error: --from and --to can be used only with render-trace" << std::endl;
+            return 1;
+        }
+        frame_options.algorithm_name = alg_name;
+
+        std::vector<std::size_t> sources;
+        if (!sources_file_name.empty()) {
+            std::ifstream sources_stream(sources_file_name);
+            if (!sources_stream.good()) {
+                throw std::runtime_error("Can not open file: \"" + sources_file_name + "\"");
+            }
+            sources = loadSourceNodes(sources_stream);
+        }
+        std::vector<PathEdgeChange> changes;
+        if (!changes_file_name.empty()) {
+            std::ifstream changes_stream(changes_file_name);
+            if (!changes_stream.good()) {
+                throw std::runtime_error("Can not open file: \"" + changes_file_name + "\"");
+            }
+            changes = loadPathEdgeChanges(changes_stream);
+        }
+        // Built or loaded for the first CH run, the same hierarchy is used by all the runs
+        std::shared_ptr<const ContractionHierarchy> hierarchy;
+
+        const std::map<std::string, PathAlgorithmFactory> path_algorithms = {
+            {"BFS", [](PathGraph&& graph) { return std::make_unique<BFSGraphAlgorithm>(std::move(graph)); }},
+            {"DIJKSTRA", [](PathGraph&& graph) { return std::make_unique<DijkstraGraphAlgorithm>(std::move(graph)); }},
+            {"01-BFS", [](PathGraph&& graph) { return std::make_unique<ZeroOneBFSGraphAlgorithm>(std::move(graph)); }},
+            {"DIAL", [](PathGraph&& graph) { return std::make_unique<DialGraphAlgorithm>(std::move(graph)); }},
+            {"SHORTEST-PATH", [](PathGraph&& graph) { return createShortestPathAlgorithm(std::move(graph)); }},
+            {"DELTA-STEPPING", [&](PathGraph&& graph) {
+                return std::make_unique<DeltaSteppingGraphAlgorithm>(std::move(graph), thread_count, delta); }},
+            {"ASTAR", [](PathGraph&& graph) { return std::make_unique<AStarGraphAlgorithm>(std::move(graph)); }},
+            {"BFS-BIDIRECTIONAL", [](PathGraph&& graph) { return std::make_unique<BidirectionalBFSGraphAlgorithm>(std::move(graph)); }},
+            {"BFS-PARALLEL", [&](PathGraph&& graph) { return std::make_unique<ParallelBFSGraphAlgorithm>(std::move(graph), thread_count); }},
+            {"MS-BFS", [&](PathGraph&& graph) { return std::make_unique<MultiSourceBFSGraphAlgorithm>(std::move(graph), sources); }},
+            {"JPS", [](PathGraph&& graph) { return std::make_unique<JumpPointSearchGraphAlgorithm>(std::move(graph)); }},
+            {"CH", [&](PathGraph&& graph) {
+                if (!hierarchy) {
+                    hierarchy = ContractionHierarchy::loadOrBuild(std::string(argv[2]) + ".ch", graph.getTopology());
+                }
+                return std::make_unique<ContractionHierarchyGraphAlgorithm>(std::move(graph), hierarchy); }},
+            {"LPASTAR", [&](PathGraph&& graph) {
+                return std::make_unique<LifelongPlanningAStarGraphAlgorithm>(std::move(graph), changes); }},
+        };
+        const std::map<std::string, FlowAlgorithmFactory> flow_algorithms = {
+            {"FF-BFS", [](FlowGraph&& graph) { return std::make_unique<FordFulkersonGraphAlgorithm>(std::move(graph)); }},
+            {"FF-SCALING", [](FlowGraph&& graph) { return std::make_unique<FordFulkersonGraphAlgorithm>(std::move(graph), true); }},
+            {"DINIC", [](FlowGraph&& graph) { return std::make_unique<DinicGraphAlgorithm>(std::move(graph)); }},
+            {"PUSH-RELABEL", [](FlowGraph&& graph) { return std::make_unique<PushRelabelGraphAlgorithm>(std::move(graph)); }},
+            {"PUSH-RELABEL-PARALLEL", [&](FlowGraph&& graph) {
+                return std::make_unique<ParallelPushRelabelGraphAlgorithm>(std::move(graph), thread_count); }},
+        };
+        const std::map<std::string, GridAlgorithmFactory> grid_algorithms = {
+            {"BFS-GRID", [](GridGraph&& graph) { return std::make_unique<GridBFSGraphAlgorithm>(std::move(graph)); }},
+            {"BFS-BITBOARD", [](GridGraph&& graph) { return std::make_unique<GridBitboardBFSGraphAlgorithm>(std::move(graph)); }},
+        };
+
+        // Only the algorithms reporting the changes of their steps can be recorded
+        const std::set<std::string> recordable_algorithms = {
+            "BFS", "DIJKSTRA", "01-BFS", "DIAL", "SHORTEST-PATH", "ASTAR", "FF-BFS", "FF-SCALING", "DINIC"
+        };
+        auto is_known_algorithm = path_algorithms.contains(alg_name) || flow_algorithms.contains(alg_name)
+            || grid_algorithms.contains(alg_name);
+        if (!frame_options.trace_file_name.empty() && is_known_algorithm && !recordable_algorithms.contains(alg_name)) {
+            std::cout << "Error: --record-trace can't be used with " << alg_name
+                << ", it doesn't report the changes of its steps (supported: BFS, DIJKSTRA, 01-BFS, DIAL, SHORTEST-PATH, ASTAR, FF-BFS, FF-SCALING and DINIC)" << std::endl;
+            return 1;
+        }
+
+        if (alg_name == "render-trace") {
+            auto traced_alg_name = StepTraceReader(trace_file_name).getAlgorithmName();
+            frame_options.algorithm_name = traced_alg_name;
+
+            auto replay = [&](std::unique_ptr<Graph> graph) {
+                return std::make_unique<TraceReplayGraphAlgorithm>(trace_file_name, std::move(graph), first_step, last_step);
+            };
+            if (flow_algorithms.contains(traced_alg_name)) {
+                visualizeFlow(input_stream, [&](FlowGraph&& graph) { return replay(std::make_unique<FlowGraph>(std::move(graph))); },
+                    output_file_name, frame_options);
+                return 0;
+            }
+            visualizePath(input_stream, [&](PathGraph&& graph) { return replay(std::make_unique<PathGraph>(std::move(graph))); },
+                output_file_name, frame_options);
+            return 0;
+        }
+        if (auto algorithm = path_algorithms.find(alg_name); algorithm != path_algorithms.end()) {
+            visualizePath(input_stream, algorithm->second, output_file_name, frame_options);
+            return 0;
+        }
+        if (auto algorithm = flow_algorithms.find(alg_name); algorithm != flow_algorithms.end()) {
+            visualizeFlow(input_stream, algorithm->second, output_file_name, frame_options);
             return 0;
         }
-        if (alg_name == "BFS") {
-            auto config = loadPathGraphConfig(input_stream);
-            auto frame_width = getFrameDimension(config.node_size, config.edge_length, config.grid_width);
-            auto frame_height = getFrameDimension(config.node_size, config.edge_length, config.grid_height);
-            auto delay = config.frame_delay;
-            PathGraph graph(config);
-
-            auto renderer_ptr = std::make_unique<GIFRenderer>(output_file_name, delay, frame_width, frame_height);
-            auto algo_ptr = std::make_unique<BFSGraphAlgorithm>(std::move(graph));
-
-            GraphAlgorithmVisualizer visualizer(std::move(algo_ptr), std::move(renderer_ptr));
-            visualizer.visualize();
+        if (auto algorithm = grid_algorithms.find(alg_name); algorithm != grid_algorithms.end()) {
+            visualizeGrid(input_stream, algorithm->second, output_file_name, frame_options);
             return 0;
         }
 